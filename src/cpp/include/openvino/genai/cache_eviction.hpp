@@ -26,7 +26,7 @@ class CacheEvictionConfig {
 public:
     CacheEvictionConfig() = default;
 
-    CacheEvictionConfig(size_t start_size, size_t recent_size, size_t max_cache_size, AggregationMode aggregation_mode_, bool apply_rotation_ = false) : aggregation_mode(aggregation_mode_), apply_rotation(apply_rotation_), m_start_size(start_size), m_recent_size(recent_size), m_max_cache_size(max_cache_size) {
+    CacheEvictionConfig(size_t start_size, size_t recent_size, size_t max_cache_size, AggregationMode aggregation_mode_, bool apply_rotation_ = false, bool evict_during_prefill_ = false, size_t snapkv_window_size_ = 0) : aggregation_mode(aggregation_mode_), apply_rotation(apply_rotation_), evict_during_prefill(evict_during_prefill_), snapkv_window_size(snapkv_window_size_), m_start_size(start_size), m_recent_size(recent_size), m_max_cache_size(max_cache_size) {
         OPENVINO_ASSERT(start_size, "CacheEvictionConfig.start_size must be non-zero");
         OPENVINO_ASSERT(recent_size, "CacheEvictionConfig.recent_size must be non-zero");
         OPENVINO_ASSERT(max_cache_size, "CacheEvictionConfig.max_cache_size must be non-zero");
@@ -70,6 +70,21 @@ public:
      *  and apply_rotation=true.**/
     bool apply_rotation = false;
 
+    /** Whether to evict blocks after each chunk of the prompt is processed, based on the attention scores of the prompt
+     *  chunks processed so far (H2O-style prompt compression). Otherwise the first eviction happens once the whole prompt
+     *  is processed, so the KV cache of a long prompt is allocated in full. Effective with SchedulerConfig.dynamic_split_fuse,
+     *  where the per-sequence KV cache usage during prefill is then limited to about max_cache_size plus the size of a
+     *  chunk (SchedulerConfig.max_num_batched_tokens). Not compatible with SchedulerConfig.enable_prefix_caching, since
+     *  the blocks of a prompt compressed during prefill don't hold the prefix they would be cached for.**/
+    bool evict_during_prefill = false;
+
+    /** Number of the last prompt tokens used as the observation window (SnapKV). If non-zero, the prompt blocks kept
+     *  after prefill are selected only by the attention scores of the queries in this window, and the scores accumulated
+     *  from the earlier prompt chunks are dropped. The window is processed as a separate prompt chunk, so this requires
+     *  SchedulerConfig.dynamic_split_fuse. Zero disables the window, and the blocks kept after prefill are then selected
+     *  by the scores of the whole prompt.**/
+    size_t snapkv_window_size = 0;
+
 private:
     /** Number of tokens in the *beginning* of KV cache that should be retained
      * in the KV cache for this sequence during generation. Must be non-zero and a multiple of the KV cache block size for
@@ -53,6 +53,17 @@ struct PipelineMetrics {
     */
     float avg_cache_usage = 0.0;
 
+    /**
+     * Percentage of KV cache reserved by admission control for the admitted requests in the last generation step,
+     * i.e. their forecast KV cache usage by the end of generation. Zero if admission control is turned off.
+     */
+    float forecast_cache_usage = 0.0;
+
+    /**
+     * Number of requests whose admission for processing was deferred in the last generation step.
+     */
+    size_t deferred_requests = 0;
+
     /**
      * Duration of the last generation step in microseconds.
      */
@@ -162,6 +173,17 @@ public:
      */
     ov::genai::PipelineMetrics get_metrics() const;
 
+    /**
+     * Writes spans of the recent generation steps (scheduling, model inference, sampling etc.) with the batch
+     * composition of every step as Chrome trace JSON, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+     * Tracing must be enabled by OV_GENAI_STEP_TRACE environment variable, which also sets the file the trace is written
+     * to when the pipeline is destroyed, or by "step_trace_capacity" property, which sets the number of recent spans kept.
+     * Spans recorded by different threads are written to separate tracks. With speculative decoding, the environment
+     * variable traces the main model pipeline only.
+     * @param path The file to write the trace to.
+     */
+    void dump_trace(const std::filesystem::path& path) const;
+
     /// @param request_id must be unique for every add_request() call.
     GenerationHandle add_request(uint64_t request_id, const ov::Tensor& input_ids, const ov::genai::GenerationConfig& sampling_params);
     GenerationHandle add_request(uint64_t request_id, const std::string& prompt, const ov::genai::GenerationConfig& sampling_params);
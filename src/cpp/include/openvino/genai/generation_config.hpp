@@ -77,8 +77,19 @@ enum class StopCriteria { EARLY, HEURISTIC, NEVER };
  * @param assistant_confidence_threshold the lower token probability of candidate to be validated by main model in case of dynamic strategy candidates number update.
  * @param num_assistant_tokens the defined candidates number to be generated by draft model/prompt lookup in case of static strategy candidates number update.
  * @param max_ngram_size is maximum ngram to use when looking for matches in the prompt.
+ * @param rank_ngram_candidates_by_frequency whether prompt lookup takes the most frequent continuation of the matched ngram instead of the first one.
+ * @param num_assistant_branches the number of candidate branches with distinct first tokens proposed by prompt lookup. The branches are verified by the
+ *  main model in one inference as forked sequences sharing KV cache of the prefix, and the one with the most accepted tokens is kept. Applies to prompt
+ *  lookup decoding with greedy sampling only, values > 1 are rejected for speculative decoding with a draft model and for multinomial sampling.
+ * @param adaptive_num_assistant_tokens whether the number of candidates is chosen per request and per step from the running acceptance rate and the
+ *  measured costs of draft and main models. `num_assistant_tokens` is the upper bound then, and drafting stops completely while candidates are rejected.
  *
  * @param apply_chat_template whether or not to apply chat_template for non-chat scenarios
+ *
+ * Scheduling parameters (have effect only in ContinuousBatchingPipeline with SchedulingPolicy::PRIORITY):
+ * @param priority priority of the request, requests with higher values are admitted first and preempted last.
+ * @param ttft_deadline_ms target time to first token in milliseconds counted from the request arrival. Among requests of the same
+ *  priority, the ones with the earliest deadline are scheduled first. 0 means no deadline.
  */
 
 class OPENVINO_GENAI_EXPORTS GenerationConfig {
@@ -127,12 +138,19 @@ public:
     float assistant_confidence_threshold = 0.f;
     size_t num_assistant_tokens = 0;
     size_t max_ngram_size = 0;
+    bool rank_ngram_candidates_by_frequency = false;
+    size_t num_assistant_branches = 1;
+    bool adaptive_num_assistant_tokens = false;
 
     std::optional<AdapterConfig> adapters;
 
     // set to true if chat template should be applied for non-chat scenarios, set to false otherwise
     bool apply_chat_template = true;
 
+    // Scheduling parameters
+    size_t priority = 0;
+    size_t ttft_deadline_ms = 0;
+
     /** @brief sets eos_token_id to tokenizer_eos_token_id if eos_token_id is less than 0.
      * Otherwise verifies eos_token_id == tokenizer_eos_token_id.
      */
@@ -194,9 +212,15 @@ extern OPENVINO_GENAI_EXPORTS ov::Property<size_t> rng_seed;
 static constexpr ov::Property<float> assistant_confidence_threshold{"assistant_confidence_threshold"};
 static constexpr ov::Property<size_t> num_assistant_tokens{"num_assistant_tokens"};
 static constexpr ov::Property<size_t> max_ngram_size{"max_ngram_size"};
+static constexpr ov::Property<bool> rank_ngram_candidates_by_frequency{"rank_ngram_candidates_by_frequency"};
+static constexpr ov::Property<size_t> num_assistant_branches{"num_assistant_branches"};
+static constexpr ov::Property<bool> adaptive_num_assistant_tokens{"adaptive_num_assistant_tokens"};
 
 static constexpr ov::Property<bool> apply_chat_template{"apply_chat_template"};
 
+static constexpr ov::Property<size_t> priority{"priority"};
+static constexpr ov::Property<size_t> ttft_deadline_ms{"ttft_deadline_ms"};
+
 // Predefined Configs
 
 OPENVINO_DEPRECATED("Please, use individual parameters instead of predefined configs. This method will be removed in 2026.0.0 release")
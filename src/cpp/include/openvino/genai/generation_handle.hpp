@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "openvino/genai/generation_config.hpp"
 #include "openvino/genai/visibility.hpp"
@@ -67,16 +70,33 @@ struct GenerationOutput {
     std::vector<float> generated_log_probs;
     float score;
     GenerationFinishReason finish_reason;
+    // text which appeared with generated_ids since the previous output of the sequence,
+    // filled only if the pipeline is created with stream_detokenization property
+    std::string text;
 };
 
 using GenerationOutputs = std::unordered_map<uint64_t, GenerationOutput>;
 
+/**
+ * @brief A token generated for a sequence since the previous read, see GenerationHandleImpl::read_available.
+ */
+struct GenerationDelta {
+    uint64_t sequence_id;
+    // -1 if the delta only reports the finish of the sequence
+    int64_t token_id;
+    float log_prob;
+    // NONE except for the last delta of a finished sequence
+    GenerationFinishReason finish_reason;
+};
+
 class GenerationStream;
 
 class OPENVINO_GENAI_EXPORTS 
 GenerationHandleImpl {
     std::shared_ptr<GenerationStream> m_generation_stream;
     ov::genai::GenerationConfig m_sampling_params; 
+    // the stream has a single consumer, so reads from several threads are serialized
+    std::mutex m_read_mutex;
 public:
     GenerationHandleImpl(std::shared_ptr<GenerationStream> generation_stream, const ov::genai::GenerationConfig& sampling_params) :
     m_generation_stream(std::move(generation_stream)),
@@ -110,6 +130,22 @@ public:
     GenerationOutputs read();
     // Reads all generated tokens for all sequences
     std::vector<GenerationOutput> read_all();
+
+    /**
+     * Replaces `deltas` with tokens of all sequences generated since the previous read without blocking. Nothing is
+     * allocated if `deltas` has enough capacity. Text decoded with the stream_detokenization property is available only
+     * via read().
+     * @return The number of deltas.
+     */
+    size_t read_available(std::vector<GenerationDelta>& deltas);
+
+    /**
+     * Sets a callback which is called after new outputs become available for reading, e.g. to write to an eventfd, so
+     * that a single thread can wait for many handles. It's called by the pipeline thread and must return quickly. It's
+     * called right away if there are outputs to read already. An empty function removes the callback. The callback may
+     * set another one, a replaced callback may still be called by a notification which started before the replacement.
+     */
+    void set_notification_callback(std::function<void()> callback);
 };
 
 using GenerationHandle = std::shared_ptr<GenerationHandleImpl>;
@@ -327,5 +327,35 @@ static constexpr ov::Property<SchedulerConfig> scheduler_config{"scheduler_confi
 */
 static constexpr ov::Property<bool> prompt_lookup{"prompt_lookup"};
 
+/**
+* @brief enable async_step property to overlap model inference of a continuous batching step with the post-processing
+* of the previous one. The infer request of step N + 1 is started asynchronously, and while it runs, stop strings are
+* matched and tokens are streamed for the requests sampled at step N. Generated tokens are the same as without it.
+* A request which reaches a stop string at step N is already scheduled for step N + 1, so it takes one extra step in
+* the batch, and the token generated at that step is dropped together with the stop string. Requests finished by EOS or
+* max_new_tokens are not affected. Not applicable to speculative decoding and prompt lookup, which update the requests
+* between steps.
+* Set `true` to activate this mode.
+*/
+static constexpr ov::Property<bool> async_step{"async_step"};
+
+/**
+* @brief enable pipelined_speculative_decoding property to overlap inference of draft and main models in speculative decoding.
+* Requests are split into two groups: while the main model validates candidates of one group, the draft model generates
+* candidates for the other one, so draft inference is hidden behind main model inference when there are several requests.
+* Set `true` together with `draft_model` to activate this mode.
+*/
+static constexpr ov::Property<bool> pipelined_speculative_decoding{"pipelined_speculative_decoding"};
+
+/**
+* @brief enable stream_detokenization property to get text of generated tokens from ContinuousBatchingPipeline handles.
+* After every step, new tokens of all requests are decoded on a background thread and `GenerationOutput::text` of outputs
+* read from handles is filled. Requests share one batched detokenizer inference if the detokenizer skips the pad token,
+* otherwise requests with the same number of tokens to decode are batched together. A callback streamer passed to
+* `generate` gets this text too, a StreamerBase streamer still gets tokens.
+* Set `true` to activate this mode.
+*/
+static constexpr ov::Property<bool> stream_detokenization{"stream_detokenization"};
+
 }  // namespace genai
 }  // namespace ov
@@ -4,10 +4,20 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 #include "openvino/genai/cache_eviction.hpp"
 
 namespace ov::genai {
+/**
+ * @brief Defines the order in which the scheduler admits prompts and chooses sequence groups to preempt.
+ */
+enum class SchedulingPolicy {
+    FCFS,     // requests are served in the arrival order, the latest ones are preempted first
+    PRIORITY  // requests are served in the order of GenerationConfig::priority raised by aging, with the earliest
+              // GenerationConfig::ttft_deadline_ms first among the equal ones; the lowest priority ones are preempted first
+};
+
 struct SchedulerConfig {
     // a maximum number of tokens to batch
     // (in contrast to max_batch_size which combines independent sequences, we consider total amount of tokens in a batch)
@@ -52,11 +62,60 @@ struct SchedulerConfig {
     // when a sequence has finished generation its cache is released.
     bool enable_prefix_caching = false;
 
+    // Directory for the persistent tier of the prefix cache. Has effect only if enable_prefix_caching is turned on.
+    // When set, KV-blocks overridden in memory are saved to files in this directory and restored from there
+    // when a new prompt shares the prefix, including after the pipeline restart.
+    // Files are written in background, files written for another KV cache layout or not matching their checksum are ignored.
+    // The directory must be used by a single pipeline with a given model at a time.
+    std::string persistent_prefix_cache_dir;
+
+    // total size of the persistent prefix cache in GB, 0 means unlimited
+    std::size_t persistent_prefix_cache_size = 0;
+
+    // Size of the host memory pool in GB for KV-blocks of preempted sequences. When set, the scheduler preempts a sequence
+    // either by swapping its KV-blocks to this pool and back, or by discarding them and recomputing later, whichever is
+    // estimated to be cheaper. 0 means that preempted sequences are always recomputed.
+    // Has no effect if enable_prefix_caching or use_cache_eviction is turned on.
+    std::size_t swap_space = 0;
+
+    // Whether requests are admitted for scheduling only while the sum of their forecast KV-cache demands fits into the
+    // KV-cache. The demand of a request is forecast from its prompt length and max_new_tokens. Requests that don't fit
+    // wait for earlier ones to finish instead of being scheduled and preempted later, when the KV-cache runs out during
+    // generation. Has no effect if the KV-cache is allocated dynamically (num_kv_blocks and cache_size are 0).
+    bool enable_admission_control = false;
+
+    // fraction of the KV-cache which admission control keeps unreserved, to absorb forecast errors
+    float admission_headroom = 0.1f;
+
+    // Has effect only if enable_admission_control is turned on. Whether the output length of a request is forecast as
+    // the running average of the output lengths of finished requests (capped by its max_new_tokens) instead of max_new_tokens.
+    bool forecast_average_output_len = false;
+
+    // Has effect only if enable_admission_control is turned on. Output length forecast for requests with neither max_new_tokens
+    // nor max_length set, until the running average of the output lengths of finished requests is known.
+    std::size_t default_forecast_output_len = 256;
+
+    // order in which requests are scheduled and preempted
+    SchedulingPolicy scheduling_policy = SchedulingPolicy::FCFS;
+
+    // Has effect only with SchedulingPolicy::PRIORITY. The priority of a request is raised by one for each
+    // priority_aging_interval_ms milliseconds it spends in the pipeline, so low priority requests are not starved
+    // by a constant flow of high priority ones. 0 disables aging.
+    std::size_t priority_aging_interval_ms = 1000;
+
     bool operator==(const SchedulerConfig& other) const {
         return max_num_batched_tokens == other.max_num_batched_tokens && num_kv_blocks == other.num_kv_blocks &&
                cache_size == other.cache_size &&
                dynamic_split_fuse == other.dynamic_split_fuse && use_cache_eviction == other.use_cache_eviction &&
-               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching;
+               max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching &&
+               persistent_prefix_cache_dir == other.persistent_prefix_cache_dir &&
+               persistent_prefix_cache_size == other.persistent_prefix_cache_size && swap_space == other.swap_space &&
+               enable_admission_control == other.enable_admission_control &&
+               admission_headroom == other.admission_headroom &&
+               forecast_average_output_len == other.forecast_average_output_len &&
+               default_forecast_output_len == other.default_forecast_output_len &&
+               scheduling_policy == other.scheduling_policy &&
+               priority_aging_interval_ms == other.priority_aging_interval_ms;
     }
 };
 }
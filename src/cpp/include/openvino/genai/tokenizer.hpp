@@ -23,6 +23,15 @@ struct TokenizedInputs {
     ov::Tensor attention_mask;
 };
 
+/**
+ * @brief Prompts of similar length encoded together by Tokenizer::encode_bucketed.
+ */
+struct TokenizedBucket {
+    // indices of the prompts in the input vector, in order of rows of the inputs
+    std::vector<size_t> prompt_indices;
+    TokenizedInputs inputs;
+};
+
 /**
  * @brief The class is used to encode prompts and decode resulting tokens
  *
@@ -162,6 +171,48 @@ public:
         return encode(prompts, AnyMap{std::forward<Properties>(properties)...});
     }
 
+    /**
+    * @brief encode many prompts without padding. Prompts are sorted by length and split into buckets, which are encoded
+    * in parallel on the tokenizer infer requests. The number of infer requests depends on properties the tokenizer is
+    * compiled with, e.g. ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT).
+    * @param prompts vector storing prompts
+    * @param bucket_size maximum number of prompts encoded by one inference
+    * @param tokenization_params AnyMap with tokenization parameters, e.g. {{"add_special_tokens", false}, {"max_length", 128}}
+    * @return tokens of every prompt, in order of prompts
+    */
+    std::vector<std::vector<int64_t>> encode_ragged(const std::vector<std::string>& prompts,
+                                                    size_t bucket_size = 16,
+                                                    const ov::AnyMap& tokenization_params = {});
+
+    /**
+    * @brief encode many prompts grouped by length. Prompts are sorted by length and split into buckets, which are encoded
+    * in parallel on the tokenizer infer requests, so that prompts of a bucket are padded to similar length.
+    * @param prompts vector storing prompts
+    * @param bucket_size maximum number of prompts in a bucket
+    * @param tokenization_params AnyMap with tokenization parameters, e.g. {{"add_special_tokens", false}, {"max_length", 128}}
+    * @return buckets with padded [input_ids, attention_mask] and indices of their prompts, from the longest prompts to
+    * the shortest ones
+    */
+    std::vector<TokenizedBucket> encode_bucketed(const std::vector<std::string>& prompts,
+                                                 size_t bucket_size = 16,
+                                                 const ov::AnyMap& tokenization_params = {});
+
+    /**
+    * @brief encode a prompt which extends a previously encoded text, e.g. templated chat history after a new message.
+    * Tokens of the prefix up to the last special token within the common part of the texts are reused and only the rest
+    * of the prompt is tokenized. Falls back to encoding of the whole prompt when the tokens can't be reused, e.g. if
+    * special tokens are added or max_length is set.
+    * @param prompt std::string with input prompt
+    * @param prefix previously encoded text
+    * @param prefix_ids tokens of the prefix
+    * @param tokenization_params AnyMap with tokenization parameters, e.g. {{"add_special_tokens", false}}
+    * @return pair of [input_ids, attention_mask]
+    */
+    TokenizedInputs encode_with_prefix(const std::string& prompt,
+                                       const std::string& prefix,
+                                       const std::vector<int64_t>& prefix_ids,
+                                       const ov::AnyMap& tokenization_params = {});
+
     /**
     * @brief decode sequence of tokens
     * @param tokens vector storing tokens
@@ -269,6 +320,8 @@ public:
     Tokenizer() = default;
     ~Tokenizer();
 private:
+    friend std::shared_ptr<const std::vector<std::string>> get_token_bytes(const Tokenizer& tokenizer);
+
     class TokenizerImpl;
     std::shared_ptr<TokenizerImpl> m_pimpl;
 };
@@ -277,5 +330,11 @@ static constexpr ov::Property<bool> add_special_tokens{"add_special_tokens"};
 static constexpr ov::Property<bool> skip_special_tokens{"skip_special_tokens"};
 static constexpr ov::Property<bool> pad_to_max_length{"pad_to_max_length"};
 
+/**
+ * @brief Number of encoded single prompts kept by the tokenizer, the result of encoding of the same prompt with the same
+ * parameters is taken from the cache. Disabled by default.
+ */
+static constexpr ov::Property<size_t> tokenization_cache_size{"tokenization_cache_size"};
+
 }  // namespace genai
 }  // namespace ov
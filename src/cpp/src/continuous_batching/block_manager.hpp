@@ -11,6 +11,7 @@
 #include <chrono>
 
 #include "sequence_group.hpp"
+#include "continuous_batching/prefix_cache_store.hpp"
 
 namespace ov::genai {
 
@@ -159,6 +160,14 @@ class OverwritableBlocksHashStore {
         return m_blocks.size();
     }
 
+    /**
+     * @param hash The hash value to look up in the store.
+     * @return Whether blocks with this hash are in the store.
+     */
+    bool contains(size_t hash) const {
+        return m_blocks.count(hash) > 0;
+    }
+
     /**
      * @brief Removes blocks matching to the supplied hashes from the store
      * @param hashes_to_discard A set of hashes. For each hash, if it is present in the store, the corresponding block will be discarded
@@ -195,6 +204,9 @@ class BlockAllocator {
     size_t m_num_layers;
     bool m_enable_prefix_caching;
     ov::genai::OverwritableBlocksHashStore m_overwriteable_blocks;
+    // (hash, block index) of the overwritable blocks reused for another hash, tracked if requested
+    bool m_track_overwritten_blocks = false;
+    std::vector<std::pair<uint64_t, size_t>> m_overwritten_blocks;
 
 public:
     /**
@@ -436,6 +448,9 @@ public:
             // get least recently used block from store and reuse it
             BlocksPerLayer blocks_for_all_layers = m_overwriteable_blocks.get_lru_block_to_overwrite();
             cached_blocks.erase(blocks_for_all_layers[0]->get_hash());
+            if (m_track_overwritten_blocks) {
+                m_overwritten_blocks.emplace_back(blocks_for_all_layers[0]->get_hash(), blocks_for_all_layers[0]->get_index());
+            }
 
             // update block with new hash
             for (auto& block : blocks_for_all_layers) {
@@ -448,6 +463,25 @@ public:
         return {};
     }
 
+    /**
+     * Enables tracking of the overwritable blocks which get reused for a new hash by `allocate_block`, so that their
+     * previous contents can be saved before being overwritten.
+     */
+    void enable_overwritten_blocks_tracking() {
+        OPENVINO_ASSERT(m_enable_prefix_caching);
+        m_track_overwritten_blocks = true;
+    }
+
+    /**
+     * Returns the blocks reused for a new hash since the previous call and clears the tracked list.
+     * @return A vector of (previous hash, block index) pairs. Block indices are identical for all layers.
+     */
+    std::vector<std::pair<uint64_t, size_t>> pop_overwritten_blocks() {
+        std::vector<std::pair<uint64_t, size_t>> retval;
+        std::swap(retval, m_overwritten_blocks);
+        return retval;
+    }
+
     /**
      * Returns the blocks corresponding to a given hash either from the internal allocator store,
      * or from the supplied storage map, or nothing if there are no blocks corresponding to this hash.
@@ -475,6 +509,15 @@ public:
         return {};
     }
 
+    /**
+     * @param hash The hash of the blocks to be looked up.
+     * @param cached_blocks The map of known hashes to already allocated and filled blocks.
+     * @return Whether `get_cached_block` would find the blocks for this hash.
+     */
+    bool has_cached_block(size_t hash, const std::map<uint64_t, BlocksPerLayer>& cached_blocks) const {
+        return m_overwriteable_blocks.contains(hash) || cached_blocks.count(hash) > 0;
+    }
+
     /**
      * @return The percentage of the allocator's free block pool utilization.
      */
@@ -492,6 +535,108 @@ public:
     }
 };
 
+/**
+ * @brief Host memory pool keeping the contents of KV cache blocks of the sequences preempted by swapping, until they are
+ * swapped back into the KV cache. The pool capacity is accounted in blocks, the space for all blocks of a sequence
+ * is reserved when the sequence is swapped out, the contents are filled in later when read from the KV cache.
+ * The block contents are treated as opaque byte buffers - layout is defined by the CacheManager.
+ */
+class BlockSwapPool {
+    size_t m_max_num_blocks;
+    size_t m_num_reserved_blocks = 0;
+    size_t m_block_contents_size;
+    // sequence id -> contents of its swapped blocks in the logical block order
+    std::map<uint64_t, std::vector<std::vector<uint8_t>>> m_swapped_sequences;
+
+public:
+    /**
+     * Constructs the BlockSwapPool.
+     * @param max_size_in_bytes The maximum total size of the swapped blocks contents.
+     * @param block_contents_size The size of the contents of one block (across all layers, both for keys and values).
+     */
+    BlockSwapPool(size_t max_size_in_bytes, size_t block_contents_size) : m_block_contents_size(block_contents_size) {
+        OPENVINO_ASSERT(block_contents_size != 0, "block_contents_size must be non-zero");
+        m_max_num_blocks = max_size_in_bytes / block_contents_size;
+    }
+
+    /**
+     * @param num_blocks A number of KV cache blocks
+     * @return Whether this number of blocks may be swapped out in addition to the already swapped ones.
+     */
+    bool can_reserve(size_t num_blocks) const {
+        return m_num_reserved_blocks + num_blocks <= m_max_num_blocks;
+    }
+
+    /**
+     * Reserves space for the blocks of a sequence being swapped out.
+     * @param seq_id The identifier of an ov::genai::Sequence.
+     * @param num_blocks The number of blocks occupied by the sequence.
+     */
+    void reserve(uint64_t seq_id, size_t num_blocks) {
+        OPENVINO_ASSERT(can_reserve(num_blocks), "Not enough space in the swap pool for ", num_blocks, " blocks");
+        OPENVINO_ASSERT(m_swapped_sequences.count(seq_id) == 0, "Sequence ", seq_id, " is already swapped out");
+        m_swapped_sequences[seq_id].resize(num_blocks);
+        m_num_reserved_blocks += num_blocks;
+    }
+
+    /**
+     * Stores the contents of a swapped block.
+     * @param seq_id The identifier of an ov::genai::Sequence.
+     * @param logical_block_idx The position of the block in the sequence's block table.
+     * @param contents The block contents read from the KV cache.
+     */
+    void store(uint64_t seq_id, size_t logical_block_idx, std::vector<uint8_t> contents) {
+        OPENVINO_ASSERT(contents.size() == m_block_contents_size, "Expected block contents of ", m_block_contents_size, " bytes, got ", contents.size());
+        auto it = m_swapped_sequences.find(seq_id);
+        OPENVINO_ASSERT(it != m_swapped_sequences.end() && logical_block_idx < it->second.size());
+        it->second[logical_block_idx] = std::move(contents);
+    }
+
+    /**
+     * @param seq_id The identifier of an ov::genai::Sequence.
+     * @return Whether the sequence is swapped out.
+     */
+    bool contains(uint64_t seq_id) const {
+        return m_swapped_sequences.count(seq_id) > 0;
+    }
+
+    /**
+     * @param seq_id The identifier of a swapped out ov::genai::Sequence.
+     * @return The number of blocks swapped out from the sequence.
+     */
+    size_t num_blocks(uint64_t seq_id) const {
+        return m_swapped_sequences.at(seq_id).size();
+    }
+
+    /**
+     * Removes a sequence from the pool, releasing the reserved space.
+     * @param seq_id The identifier of a swapped out ov::genai::Sequence.
+     * @return The contents of the swapped blocks in the logical block order.
+     */
+    std::vector<std::vector<uint8_t>> release(uint64_t seq_id) {
+        auto it = m_swapped_sequences.find(seq_id);
+        OPENVINO_ASSERT(it != m_swapped_sequences.end(), "Sequence ", seq_id, " is not swapped out");
+        auto contents = std::move(it->second);
+        m_num_reserved_blocks -= contents.size();
+        m_swapped_sequences.erase(it);
+        return contents;
+    }
+
+    /**
+     * @return The size of the contents of one block.
+     */
+    size_t get_block_contents_size() const {
+        return m_block_contents_size;
+    }
+
+    /**
+     * @return Total size in bytes reserved by the swapped blocks.
+     */
+    size_t get_used_size_in_bytes() const {
+        return m_num_reserved_blocks * m_block_contents_size;
+    }
+};
+
 /**
  * @brief Works with `ov::genai::SequenceGroup`s and individual `ov::genai::Sequence`s to assign KV cache blocks to these
  * at each pipeline generation step. A block table is kept for each sequence, storing the indices of "physical"
@@ -499,6 +644,27 @@ public:
  * blocks within the block table being associated with "logical" block indices.
  */
 class BlockManager {
+public:
+    /**
+     * A block of a swapped out sequence, whose contents are to be read from the KV cache into the swap pool.
+     */
+    struct SwappedBlock {
+        uint64_t seq_id;
+        size_t logical_block_idx;
+        size_t block_idx;
+    };
+
+    /**
+     * KV cache block transfers between the KV cache and the swap pool, to be performed by the CacheManager.
+     * Block indices are identical for all layers.
+     */
+    struct SwapTransfers {
+        std::vector<SwappedBlock> m_blocks_to_swap_out;
+        // block index -> contents to be written to the KV cache
+        std::map<size_t, std::vector<uint8_t>> m_blocks_to_swap_in;
+    };
+
+private:
     friend class CacheStateDumper;
     BlockAllocator m_allocator;
     bool m_enable_prefix_caching;
@@ -512,7 +678,122 @@ class BlockManager {
     std::map<uint64_t, std::vector<BlocksPerLayer>> m_block_table;
 
     std::mutex m_cached_blocks_map_mutex;
+
+    // second, persistent tier of the prefix cache
+    std::shared_ptr<PersistentPrefixCacheStore> m_persistent_prefix_cache;
+    // (hash, block index) of the blocks to be saved to the persistent tier before being overwritten
+    std::vector<std::pair<uint64_t, size_t>> m_blocks_to_spill;
+    // block index -> contents read from the persistent tier, to be written to the KV cache before next inference
+    std::map<size_t, std::vector<uint8_t>> m_blocks_to_load;
+
+    // host-side pool for the blocks of sequences preempted by swapping
+    std::shared_ptr<BlockSwapPool> m_swap_pool;
+    // blocks of swapped out sequences to be read from the KV cache before next inference
+    std::vector<SwappedBlock> m_blocks_to_swap_out;
+    // block index -> contents of swapped in sequences, to be written to the KV cache before next inference
+    std::map<size_t, std::vector<uint8_t>> m_blocks_to_swap_in;
+
+    /**
+     * Allocates a block for each layer for a given prefix hash. If the persistent prefix cache is set and the allocated
+     * blocks were reused from the overwritable store, schedules saving of their previous contents.
+     */
+    BlocksPerLayer _allocate_block(size_t hash) {
+        auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+        if (m_persistent_prefix_cache) {
+            for (const auto& [prev_hash, block_idx] : m_allocator.pop_overwritten_blocks()) {
+                if (m_blocks_to_load.erase(block_idx) > 0) {
+                    // contents were never written to the KV cache, but are already in the persistent tier
+                    continue;
+                }
+                bool is_spill_pending = std::any_of(m_blocks_to_spill.begin(), m_blocks_to_spill.end(),
+                    [block_idx = block_idx](const std::pair<uint64_t, size_t>& spill) { return spill.second == block_idx; });
+                if (!is_spill_pending) {
+                    m_blocks_to_spill.emplace_back(prev_hash, block_idx);
+                }
+            }
+        }
+        return blocks_for_all_layers;
+    }
+
+    /**
+     * Looks up a given prefix hash in the contents read from the persistent prefix cache. On hit, allocates blocks for
+     * the hash and schedules writing of the contents into them.
+     * @param persistent_blocks Contents read by `_read_persistent_cached_blocks`, the used ones are moved out.
+     * @return A vector of blocks (one for each layer), or an empty vector if the hash is not found or no blocks can be allocated.
+     */
+    BlocksPerLayer _get_persistent_cached_block(size_t hash, std::map<uint64_t, std::vector<uint8_t>>& persistent_blocks) {
+        auto it = persistent_blocks.find(hash);
+        if (it == persistent_blocks.end() || !m_allocator.can_allocate_blocks(1)) {
+            return {};
+        }
+        auto blocks_for_all_layers = _allocate_block(hash);
+        m_blocks_to_load[blocks_for_all_layers[0]->get_index()] = std::move(it->second);
+        persistent_blocks.erase(it);
+        return blocks_for_all_layers;
+    }
+
+    /**
+     * Reads the contents of the prompt blocks of a sequence which can only be restored from the persistent prefix cache,
+     * visiting the hashes in the order of `restore_cached_blocks`. The files are read without holding the lock,
+     * so that a step is not delayed by disk reads of a request being added.
+     * @return Prefix hash -> block contents.
+     */
+    std::map<uint64_t, std::vector<uint8_t>> _read_persistent_cached_blocks(const Sequence::Ptr& sequence, size_t prompt_len) {
+        std::vector<uint64_t> hashes_to_read;
+        std::shared_ptr<PersistentPrefixCacheStore> persistent_prefix_cache;
+        {
+            const std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+            if (!m_persistent_prefix_cache) {
+                return {};
+            }
+            persistent_prefix_cache = m_persistent_prefix_cache;
+            for (size_t content_len = 0; content_len < prompt_len; content_len += m_block_size) {
+                auto full_block_hash = sequence->get_hash(std::min(content_len + m_block_size, prompt_len));
+                if (m_allocator.has_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map)) {
+                    continue;
+                }
+                if (m_persistent_prefix_cache->contains(full_block_hash)) {
+                    hashes_to_read.push_back(full_block_hash);
+                    continue;
+                }
+                // restore stops at the partially filled block
+                for (size_t i = 1; i < m_block_size && content_len + i <= prompt_len; i++) {
+                    auto hash = sequence->get_hash(content_len + i);
+                    if (m_allocator.has_cached_block(hash, m_prefix_hash_to_occupied_block_map)) {
+                        break;
+                    }
+                    if (m_persistent_prefix_cache->contains(hash)) {
+                        hashes_to_read.push_back(hash);
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        std::map<uint64_t, std::vector<uint8_t>> persistent_blocks;
+        for (uint64_t hash : hashes_to_read) {
+            std::vector<uint8_t> contents;
+            if (!persistent_prefix_cache->load(hash, contents)) {
+                // the following blocks can't be restored without this one
+                break;
+            }
+            persistent_blocks.emplace(hash, std::move(contents));
+        }
+        return persistent_blocks;
+    }
+
 public:
+    /**
+     * KV cache block transfers between the KV cache and the persistent prefix cache, to be performed by the CacheManager.
+     * Block indices are identical for all layers.
+     */
+    struct PrefixCacheTransfers {
+        // (hash, block index) of the blocks whose contents should be saved to the persistent prefix cache
+        std::vector<std::pair<uint64_t, size_t>> m_blocks_to_spill;
+        // block index -> contents to be written to the KV cache
+        std::map<size_t, std::vector<uint8_t>> m_blocks_to_load;
+    };
+
     /**
      * Constructs the BlockManager.
      * @param num_blocks Number of KV cache blocks available for assignment to the sequences.
@@ -733,7 +1014,7 @@ public:
                     num_hashed_tokens = content_length;
                 }
                 auto hash = sequence->get_hash(num_hashed_tokens);
-                auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                auto blocks_for_all_layers = _allocate_block(hash);
                 for (size_t layer_idx = 0; layer_idx < blocks_for_all_layers.size(); layer_idx++) {
                     m_block_table[sequence_id][layer_idx].push_back(blocks_for_all_layers[layer_idx]);
                 }
@@ -763,6 +1044,199 @@ public:
         return m_allocator.get_total_number_of_kv_blocks();
     }
 
+    /**
+     * Sets the second, persistent tier of the prefix cache. Blocks overwritten in the in-memory prefix cache
+     * are saved there, and prefix hashes not found in memory are looked up there by `restore_cached_blocks`.
+     * Can only be used if prefix caching is enabled.
+     * @param persistent_prefix_cache The store for the evicted blocks contents.
+     */
+    void set_persistent_prefix_cache(std::shared_ptr<PersistentPrefixCacheStore> persistent_prefix_cache) {
+        OPENVINO_ASSERT(m_enable_prefix_caching, "Persistent prefix cache requires prefix caching to be enabled");
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        m_persistent_prefix_cache = persistent_prefix_cache;
+        m_allocator.enable_overwritten_blocks_tracking();
+    }
+
+    /**
+     * @return Whether the persistent tier of the prefix cache is set.
+     */
+    bool has_persistent_prefix_cache() const {
+        return m_persistent_prefix_cache != nullptr;
+    }
+
+    /**
+     * Returns the block transfers to/from the persistent prefix cache scheduled since the previous call.
+     * Blocks must be spilled before the loads are performed, since a loaded block may reuse a spilled one,
+     * and both must be done before the next inference.
+     * @return Block transfers to be performed by the CacheManager.
+     */
+    PrefixCacheTransfers pop_prefix_cache_transfers() {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        PrefixCacheTransfers transfers;
+        std::swap(transfers.m_blocks_to_spill, m_blocks_to_spill);
+        std::swap(transfers.m_blocks_to_load, m_blocks_to_load);
+        return transfers;
+    }
+
+    /**
+     * Saves the contents of a spilled block to the persistent prefix cache.
+     * @param hash The prefix hash of the block as returned by `pop_prefix_cache_transfers`.
+     * @param contents The block contents read from the KV cache.
+     */
+    void store_spilled_block(uint64_t hash, std::vector<uint8_t> contents) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        OPENVINO_ASSERT(m_persistent_prefix_cache);
+        m_persistent_prefix_cache->store(hash, std::move(contents));
+    }
+
+    /**
+     * Sets the host-side pool for the blocks of sequences preempted by swapping. Can only be used if prefix caching
+     * is disabled, since prefix cached blocks may be shared between sequences.
+     * @param swap_pool The pool for the swapped out blocks contents.
+     */
+    void set_swap_pool(std::shared_ptr<BlockSwapPool> swap_pool) {
+        OPENVINO_ASSERT(!m_enable_prefix_caching, "Swapping of KV cache blocks is not supported with prefix caching");
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        m_swap_pool = swap_pool;
+    }
+
+    /**
+     * @return Whether the swap pool is set.
+     */
+    bool has_swap_pool() const {
+        return m_swap_pool != nullptr;
+    }
+
+    /**
+     * @param seq_group Pointer to a sequence group.
+     * @return Whether the sequence group can be preempted by swapping: it must have a single not finished sequence with
+     * blocks not shared with other sequences and identical block indices across layers, and the swap pool must have
+     * enough space for these blocks.
+     */
+    bool can_swap_out(SequenceGroup::Ptr seq_group) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        if (!m_swap_pool) {
+            return false;
+        }
+        auto sequences = seq_group->get_not_finished_sequences();
+        if (sequences.size() != 1) {
+            return false;
+        }
+        auto it = m_block_table.find(sequences[0]->get_id());
+        if (it == m_block_table.end() || it->second[0].empty()) {
+            return false;
+        }
+        const auto& block_table = it->second;
+        for (size_t logical_block_idx = 0; logical_block_idx < block_table[0].size(); ++logical_block_idx) {
+            const auto& block = block_table[0][logical_block_idx];
+            if (block->copy_on_write()) {
+                return false;
+            }
+            for (size_t layer_idx = 1; layer_idx < block_table.size(); ++layer_idx) {
+                if (block_table[layer_idx][logical_block_idx]->get_index() != block->get_index()) {
+                    return false;
+                }
+            }
+        }
+        return m_swap_pool->can_reserve(block_table[0].size());
+    }
+
+    /**
+     * Preempts a sequence group by swapping: frees its blocks and schedules reading of their contents into the swap pool.
+     * The sequence group must satisfy `can_swap_out`.
+     * @param seq_group Pointer to a sequence group.
+     * @return The number of blocks freed.
+     */
+    size_t swap_out(SequenceGroup::Ptr seq_group) {
+        OPENVINO_ASSERT(can_swap_out(seq_group), "Sequence group ", seq_group->get_request_id(), " cannot be swapped out");
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        auto seq_id = seq_group->get_not_finished_sequences()[0]->get_id();
+        auto& block_table = m_block_table[seq_id];
+        size_t num_blocks = block_table[0].size();
+        m_swap_pool->reserve(seq_id, num_blocks);
+        for (size_t logical_block_idx = 0; logical_block_idx < num_blocks; ++logical_block_idx) {
+            BlocksPerLayer blocks_to_free;
+            blocks_to_free.reserve(block_table.size());
+            for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
+                blocks_to_free.push_back(block_table[layer_idx][logical_block_idx]);
+            }
+            m_blocks_to_swap_out.push_back({seq_id, logical_block_idx, static_cast<size_t>(blocks_to_free[0]->get_index())});
+            m_allocator.free(blocks_to_free);
+        }
+        m_block_table.erase(seq_id);
+        return num_blocks;
+    }
+
+    /**
+     * @param seq_id The identifier of an ov::genai::Sequence
+     * @return Whether the blocks of the sequence are swapped out.
+     */
+    bool is_swapped(uint64_t seq_id) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        return m_swap_pool && m_swap_pool->contains(seq_id);
+    }
+
+    /**
+     * @param seq_id The identifier of a swapped out ov::genai::Sequence
+     * @return The number of KV cache blocks required to swap the sequence in.
+     */
+    size_t get_number_of_swapped_blocks(uint64_t seq_id) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        OPENVINO_ASSERT(m_swap_pool);
+        return m_swap_pool->num_blocks(seq_id);
+    }
+
+    /**
+     * Swaps in a sequence group preempted by swapping: allocates new blocks for it and schedules writing of the swapped
+     * contents into them.
+     * @param seq_group Pointer to a swapped out sequence group.
+     */
+    void swap_in(SequenceGroup::Ptr seq_group) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        OPENVINO_ASSERT(m_swap_pool);
+        auto seq_id = seq_group->get_not_finished_sequences()[0]->get_id();
+        OPENVINO_ASSERT(std::none_of(m_blocks_to_swap_out.begin(), m_blocks_to_swap_out.end(),
+            [seq_id](const SwappedBlock& block) { return block.seq_id == seq_id; }),
+            "Sequence ", seq_id, " cannot be swapped in at the same step it was swapped out");
+        size_t num_blocks = m_swap_pool->num_blocks(seq_id);
+        OPENVINO_ASSERT(can_allocate_blocks(num_blocks));
+        auto contents = m_swap_pool->release(seq_id);
+        auto& block_table = m_block_table[seq_id];
+        block_table.resize(m_num_layers);
+        for (size_t logical_block_idx = 0; logical_block_idx < num_blocks; ++logical_block_idx) {
+            auto blocks_for_all_layers = m_allocator.allocate_block();
+            for (size_t layer_idx = 0; layer_idx < blocks_for_all_layers.size(); layer_idx++) {
+                block_table[layer_idx].push_back(blocks_for_all_layers[layer_idx]);
+            }
+            m_blocks_to_swap_in[blocks_for_all_layers[0]->get_index()] = std::move(contents[logical_block_idx]);
+        }
+    }
+
+    /**
+     * Returns the block transfers to/from the swap pool scheduled since the previous call. Blocks must be swapped out
+     * before any other writes to the KV cache, since the freed blocks may already be reused, and all transfers must be
+     * done before the next inference.
+     * @return Block transfers to be performed by the CacheManager.
+     */
+    SwapTransfers pop_swap_transfers() {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        SwapTransfers transfers;
+        std::swap(transfers.m_blocks_to_swap_out, m_blocks_to_swap_out);
+        std::swap(transfers.m_blocks_to_swap_in, m_blocks_to_swap_in);
+        return transfers;
+    }
+
+    /**
+     * Saves the contents of a swapped out block to the swap pool.
+     * @param block The swapped out block as returned by `pop_swap_transfers`.
+     * @param contents The block contents read from the KV cache.
+     */
+    void store_swapped_out_block(const SwappedBlock& block, std::vector<uint8_t> contents) {
+        std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        OPENVINO_ASSERT(m_swap_pool);
+        m_swap_pool->store(block.seq_id, block.logical_block_idx, std::move(contents));
+    }
+
     /**
      * @brief Forks a sequence, establishing a new sequence from an existing one, reusing
      * currently allocated blocks of the existing sequence.
@@ -784,11 +1258,17 @@ public:
     }
 
     /**
-     * @brief Frees all blocks for a given sequence.
+     * @brief Frees all blocks for a given sequence, including the ones swapped out to the swap pool.
      * @param seq_id Identifier of the sequence to free.
      */
     void free_sequence(size_t seq_id) {
         std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
+        if (m_swap_pool && m_swap_pool->contains(seq_id)) {
+            m_swap_pool->release(seq_id);
+            m_blocks_to_swap_out.erase(std::remove_if(m_blocks_to_swap_out.begin(), m_blocks_to_swap_out.end(),
+                [seq_id](const SwappedBlock& block) { return block.seq_id == seq_id; }), m_blocks_to_swap_out.end());
+            return;
+        }
         OPENVINO_ASSERT(m_block_table.find(seq_id) != m_block_table.end(), "sequence with id ", seq_id,
                         " not found in BlockManager, but requested to free");
         auto& block_table = m_block_table[seq_id];
@@ -989,6 +1469,10 @@ public:
         }
         for (const auto& sequence : seq_group->get_running_sequences()) {
             auto seq_id = sequence->get_id();
+            if (m_block_table.find(seq_id) == m_block_table.end()) {
+                // swapped out
+                continue;
+            }
             auto& block_table = m_block_table[seq_id];
             size_t num_physical_blocks = block_table[0].size();
             if (num_physical_blocks > num_logical_blocks) {
@@ -1044,7 +1528,7 @@ public:
                     new_blocks_for_all_layers.reserve(effective_num_layers);
                     if (m_enable_prefix_caching) {
                         auto hash = sequence->get_hash();
-                        new_blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                        new_blocks_for_all_layers = _allocate_block(hash);
                     } else {
                         for (size_t i = 0; i < effective_num_layers; i++) {
                             new_blocks_for_all_layers.push_back(m_allocator.allocate_block(i));
@@ -1081,14 +1565,16 @@ public:
     }
 
     void restore_cached_blocks(SequenceGroup::Ptr group) {
-        // When add_request() is executed in multiple threads accessing to cached_blocks causes segfault.
-        // The mutex is needed to prevent such segfaults.
-        const std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
         auto prompt_len = group->get_prompt_len();
         auto sequences = group->get_not_finished_sequences();
         OPENVINO_ASSERT(sequences.size() == 1);
         auto sequence = sequences[0];
         auto seq_id = sequence->get_id();
+        auto persistent_blocks = _read_persistent_cached_blocks(sequence, prompt_len);
+
+        // When add_request() is executed in multiple threads accessing to cached_blocks causes segfault.
+        // The mutex is needed to prevent such segfaults.
+        const std::lock_guard<std::mutex> lock(m_cached_blocks_map_mutex);
 
         if (m_block_table.find(seq_id) == m_block_table.end()) {
             m_block_table[seq_id].resize(m_num_layers);
@@ -1105,6 +1591,9 @@ public:
             // restore fully filled blocks
             auto full_block_hash = sequence->get_hash(content_len);
             auto blocks = m_allocator.get_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map);
+            if (blocks.empty()) {
+                blocks = _get_persistent_cached_block(full_block_hash, persistent_blocks);
+            }
             auto timestamp = std::chrono::steady_clock::now();
             if (!blocks.empty()) {
                 for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
@@ -1121,6 +1610,9 @@ public:
                     }
                     auto hash = sequence->get_hash(prev_iteration_content_len + i);
                     auto blocks = m_allocator.get_cached_block(hash, m_prefix_hash_to_occupied_block_map);
+                    if (blocks.empty()) {
+                        blocks = _get_persistent_cached_block(hash, persistent_blocks);
+                    }
                     if (!blocks.empty()) {
                         auto timestamp = std::chrono::steady_clock::now();
 
@@ -1,13 +1,17 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <numeric>
+
 #include "continuous_batching/cache_eviction.hpp"
 
 namespace ov::genai {
     CacheEvictionAlgorithm::CacheEvictionAlgorithm(const CacheEvictionConfig &eviction_config, size_t block_size,
                                                    size_t num_decoder_layers) :
             m_eviction_config(eviction_config), m_block_size(block_size), m_num_decoder_layers(num_decoder_layers),
-            m_cache_counter(num_decoder_layers), m_scores(num_decoder_layers) {
+            m_scores(num_decoder_layers), m_token_registration_indices(num_decoder_layers),
+            m_num_registered_tokens(num_decoder_layers) {
             OPENVINO_ASSERT(!(m_eviction_config.get_start_size() % m_block_size),
                             "CacheEvictionConfig.start_size in tokens must be a multiple of block size ", m_block_size);
             OPENVINO_ASSERT(!(m_eviction_config.get_recent_size() % m_block_size),
@@ -36,31 +40,31 @@ namespace ov::genai {
         // tokens was being computed.
 
         std::vector<std::set<size_t>> retval(m_num_decoder_layers);
-
-
         for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_scores.size(); decoder_layer_idx++) {
-            const auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-            auto scores_length = accumulated_scores_for_current_decoder_layer.size();
-            if (scores_length + m_eviction_config.get_start_size() <= get_max_cache_size_after_eviction()) {
-                // KV cache is not yet filled, keep all currently occupied blocks
-                continue;
-            }
+            retval[decoder_layer_idx] = evict_logical_blocks(decoder_layer_idx);
+        }
+        return retval;
+    }
 
-            // Only the blocks in the "intermediate" part of the logical KV cache will be considered for eviction
-            auto scores_for_all_evictable_blocks = get_scores_for_all_evictable_blocks(decoder_layer_idx);
-            size_t num_blocks_to_evict = get_num_blocks_to_evict(decoder_layer_idx);
-            auto evicted_block_indices = get_indices_of_blocks_to_evict(scores_for_all_evictable_blocks, num_blocks_to_evict);
+    std::set<std::size_t> CacheEvictionAlgorithm::evict_logical_blocks(size_t decoder_layer_idx) {
+        std::set<std::size_t> retval;
+        auto scores_length = m_scores[decoder_layer_idx].size();
+        if (scores_length + m_eviction_config.get_start_size() <= get_max_cache_size_after_eviction()) {
+            // KV cache is not yet filled, keep all currently occupied blocks
+            return retval;
+        }
 
-            m_num_evicted_tokens += evicted_block_indices.size() * m_block_size;
+        // Only the blocks in the "intermediate" part of the logical KV cache will be considered for eviction
+        auto scores_for_all_evictable_blocks = get_scores_for_all_evictable_blocks(decoder_layer_idx);
+        size_t num_blocks_to_evict = get_num_blocks_to_evict(decoder_layer_idx);
+        auto evicted_block_indices = get_indices_of_blocks_to_evict(scores_for_all_evictable_blocks, num_blocks_to_evict);
 
-            // No longer need to track the overall "heavy-hitter" attention scores for freshly evicted blocks
-            remove_scores_of_evicted_blocks(evicted_block_indices, decoder_layer_idx);
+        // No longer need to track the overall "heavy-hitter" attention scores for freshly evicted blocks
+        remove_scores_of_evicted_blocks(evicted_block_indices, decoder_layer_idx);
 
-            // Adjust indices to account for start area
-            for (auto &idx: evicted_block_indices) idx += get_num_blocks(m_eviction_config.get_start_size());
-            // auto remaining_block_indices = get_remaining_block_indices(evicted_block_indices);
-            for (auto &idx: evicted_block_indices) retval[decoder_layer_idx].insert(idx);
-        }
+        // Adjust indices to account for start area
+        size_t num_start_blocks = get_num_blocks(m_eviction_config.get_start_size());
+        for (auto idx: evicted_block_indices) retval.insert(idx + num_start_blocks);
         return retval;
     }
 
@@ -80,64 +84,53 @@ namespace ov::genai {
 
     void CacheEvictionAlgorithm::register_new_token_scores(
             const AttentionScoresForEachDecoderLayer &attention_scores_for_all_decoder_layers) {
-        for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_cache_counter.size(); decoder_layer_idx++) {
-
-            const auto &attention_scores = attention_scores_for_all_decoder_layers[decoder_layer_idx];
-            // "Start" tokens are never evicted, won't track scores for these
-            // "Recent" tokens are also not evicted just yet, but need to accumulate their scores since they may
-            // ultimately move into the "intermediate" eviction region of cache
-            // Taking the [1, start_size:seq_len] span of the attention scores:
-            auto attn_shape = attention_scores.get_shape();
-            size_t kv_cache_size_in_tokens = attn_shape[0];
-            if (kv_cache_size_in_tokens <= m_eviction_config.get_start_size() + 1) {
-                return;
-            }
+        for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_num_decoder_layers; decoder_layer_idx++) {
+            register_new_token_scores(attention_scores_for_all_decoder_layers[decoder_layer_idx], decoder_layer_idx);
+        }
+    }
 
-            auto hh_score = ov::Tensor(
-                    attention_scores,
-                    ov::Coordinate{m_eviction_config.get_start_size()},
-                    ov::Coordinate{kv_cache_size_in_tokens}
-            );
+    void CacheEvictionAlgorithm::register_new_token_scores(const AttentionScoresForCacheOfSubsequence &attention_scores,
+                                                           size_t decoder_layer_idx) {
+        // "Start" tokens are never evicted, won't track scores for these
+        // "Recent" tokens are also not evicted just yet, but need to accumulate their scores since they may
+        // ultimately move into the "intermediate" eviction region of cache
+        // Taking the [1, start_size:seq_len] span of the attention scores:
+        size_t kv_cache_size_in_tokens = attention_scores.get_shape()[0];
+        if (kv_cache_size_in_tokens <= m_eviction_config.get_start_size() + 1) {
+            return;
+        }
+        const float* hh_score_data = attention_scores.data<const float>() + m_eviction_config.get_start_size();
+        size_t num_scores = kv_cache_size_in_tokens - m_eviction_config.get_start_size();
+
+        auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
+        size_t old_size_in_tokens = accumulated_scores_for_current_decoder_layer.size();
+        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM && num_scores > old_size_in_tokens) {
+            // Each of the new tokens is attended to by itself and the tokens after it, as if the tokens were added
+            // one-by-one from the standpoint of the occurrence tracker
+            auto &registration_indices = m_token_registration_indices[decoder_layer_idx];
+            size_t& num_registered_tokens = m_num_registered_tokens[decoder_layer_idx];
+            registration_indices.resize(num_scores);
+            for (size_t idx = old_size_in_tokens; idx < num_scores; idx++) {
+                registration_indices[idx] = num_registered_tokens + idx - old_size_in_tokens;
+            }
+            num_registered_tokens += num_scores - old_size_in_tokens;
+        }
 
-            auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
+        // new tokens start from zero score
+        accumulated_scores_for_current_decoder_layer.resize(num_scores);
+        double* accumulated_scores = accumulated_scores_for_current_decoder_layer.data();
+        for (size_t i = 0; i < num_scores; ++i) {
+            accumulated_scores[i] += hh_score_data[i];
+        }
+    }
 
-            if (accumulated_scores_for_current_decoder_layer.empty()) {
-                accumulated_scores_for_current_decoder_layer = std::vector<double>(hh_score.get_size());
-                for (size_t idx = 0; idx < accumulated_scores_for_current_decoder_layer.size(); idx++) {
-                    accumulated_scores_for_current_decoder_layer[idx] = hh_score.data<float>()[idx];
-                }
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    // New sequence to track - will simulate that the tokens comprising the sequence were added one-by-one
-                    // from the standpoint of the occurrence tracker
-                    std::size_t new_scores_size = hh_score.get_size();
-                    std::vector<std::size_t> counter(new_scores_size);
-                    std::generate(counter.begin(), counter.begin() + new_scores_size,
-                                  [&new_scores_size] { return new_scores_size--; });
-                    m_cache_counter[decoder_layer_idx] = counter;
-                }
-            } else {
-                size_t old_size_in_tokens = accumulated_scores_for_current_decoder_layer.size();
-                size_t num_new_tokens = hh_score.get_size() - accumulated_scores_for_current_decoder_layer.size();
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    // Increment occurrence counts of all currently tracked cache blocks
-                    auto &counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
-                    for (auto it = counter_for_current_decoder_layer.begin();
-                         it != counter_for_current_decoder_layer.end(); it++) {
-                        *it += num_new_tokens;
-                    }
-                    // Add occurrence counts for new tokens like above
-                    counter_for_current_decoder_layer.resize(hh_score.get_size());
-                    for (size_t i = 0; i < num_new_tokens; i++) {
-                        auto idx = old_size_in_tokens + i;
-                        counter_for_current_decoder_layer[idx] = num_new_tokens - i;
-                    }
-                }
-                accumulated_scores_for_current_decoder_layer.resize(hh_score.get_size());
-                auto hh_score_data = hh_score.data<float>();
-                for (size_t i = 0; i < hh_score.get_size(); ++i) {
-                    accumulated_scores_for_current_decoder_layer[i] += hh_score_data[i];
-                }
-            }
+    void CacheEvictionAlgorithm::reset_scores(size_t decoder_layer_idx) {
+        auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
+        std::fill(accumulated_scores_for_current_decoder_layer.begin(), accumulated_scores_for_current_decoder_layer.end(), 0.0);
+        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
+            // the tracked tokens are counted as attended to only by the tokens registered from now on
+            auto &registration_indices = m_token_registration_indices[decoder_layer_idx];
+            std::fill(registration_indices.begin(), registration_indices.end(), m_num_registered_tokens[decoder_layer_idx]);
         }
     }
 
@@ -160,30 +153,32 @@ namespace ov::genai {
     }
 
     std::vector<double> CacheEvictionAlgorithm::get_scores_for_all_evictable_blocks(size_t decoder_layer_idx) const {
-        auto accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
+        const auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
         auto num_tracked_tokens = accumulated_scores_for_current_decoder_layer.size();
-        auto counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
 
         // Make sure that there is at least one block that can be completely evicted
         OPENVINO_ASSERT((num_tracked_tokens + m_eviction_config.get_start_size()) > get_max_cache_size_after_eviction(),
                         "KV cache must be filled before scores for evictable blocks can be computed");
 
         size_t num_evictable_blocks = get_num_evictable_blocks(decoder_layer_idx);
+        const double* accumulated_scores = accumulated_scores_for_current_decoder_layer.data();
 
         std::vector<double> block_scores(num_evictable_blocks);
-        for (size_t i = 0; i < num_evictable_blocks; ++i) {
-            double normalized_accumulated_attn_score_for_block = 0.0;
-            for (size_t j = 0; j < m_block_size; ++j) {
-                size_t token_offset = m_block_size * i + j;
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    normalized_accumulated_attn_score_for_block +=
-                            accumulated_scores_for_current_decoder_layer[token_offset] /
-                            counter_for_current_decoder_layer[token_offset];
-                } else {
-                    normalized_accumulated_attn_score_for_block += accumulated_scores_for_current_decoder_layer[token_offset];
+        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
+            const size_t* registration_indices = m_token_registration_indices[decoder_layer_idx].data();
+            const size_t num_registered_tokens = m_num_registered_tokens[decoder_layer_idx];
+            for (size_t i = 0; i < num_evictable_blocks; ++i) {
+                double normalized_accumulated_attn_score_for_block = 0.0;
+                for (size_t token_offset = m_block_size * i; token_offset < m_block_size * (i + 1); ++token_offset) {
+                    normalized_accumulated_attn_score_for_block += accumulated_scores[token_offset] /
+                            (num_registered_tokens - registration_indices[token_offset]);
                 }
+                block_scores[i] = normalized_accumulated_attn_score_for_block;
+            }
+        } else {
+            for (size_t i = 0; i < num_evictable_blocks; ++i) {
+                block_scores[i] = std::accumulate(accumulated_scores + m_block_size * i, accumulated_scores + m_block_size * (i + 1), 0.0);
             }
-            block_scores[i] = normalized_accumulated_attn_score_for_block;
         }
         return block_scores;
     }
@@ -229,43 +224,40 @@ namespace ov::genai {
             return;
         }
 
-        const auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-        const auto &counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
-
-        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
+        auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
+        auto &registration_indices_for_current_decoder_layer = m_token_registration_indices[decoder_layer_idx];
+        const bool is_norm_sum = m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM;
+        if (is_norm_sum) {
             OPENVINO_ASSERT(
-                    accumulated_scores_for_current_decoder_layer.size() == counter_for_current_decoder_layer.size());
+                    accumulated_scores_for_current_decoder_layer.size() == registration_indices_for_current_decoder_layer.size());
         }
 
+        // blocks between the evicted ones are shifted to the front in place
         auto old_size = accumulated_scores_for_current_decoder_layer.size();
-        auto new_size =
-                accumulated_scores_for_current_decoder_layer.size() - evicted_block_indices.size() * m_block_size;
-
-        std::vector<double> new_scores;
-        new_scores.reserve(new_size);
-
-        std::vector<size_t> new_counter;
-
-        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-            new_counter.reserve(new_size);
-        }
-
-        for (size_t token_idx = 0, evicted_block_idx = 0; token_idx < old_size;) {
-            if (evicted_block_idx < evicted_block_indices.size() &&
-                token_idx == evicted_block_indices[evicted_block_idx] * m_block_size) {
-                ++evicted_block_idx;
-                token_idx += m_block_size;
+        size_t new_size = 0;
+        for (size_t evicted_block_idx = 0; evicted_block_idx <= evicted_block_indices.size(); ++evicted_block_idx) {
+            size_t kept_begin = evicted_block_idx == 0 ? 0 : (evicted_block_indices[evicted_block_idx - 1] + 1) * m_block_size;
+            size_t kept_end = evicted_block_idx < evicted_block_indices.size() ? evicted_block_indices[evicted_block_idx] * m_block_size : old_size;
+            if (kept_begin == new_size) {
+                // nothing is evicted before the kept range yet
+                new_size = kept_end;
                 continue;
             }
-            new_scores.push_back(accumulated_scores_for_current_decoder_layer[token_idx]);
-            if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                new_counter.push_back(counter_for_current_decoder_layer[token_idx]);
+            std::copy(accumulated_scores_for_current_decoder_layer.begin() + kept_begin,
+                      accumulated_scores_for_current_decoder_layer.begin() + kept_end,
+                      accumulated_scores_for_current_decoder_layer.begin() + new_size);
+            if (is_norm_sum) {
+                std::copy(registration_indices_for_current_decoder_layer.begin() + kept_begin,
+                          registration_indices_for_current_decoder_layer.begin() + kept_end,
+                          registration_indices_for_current_decoder_layer.begin() + new_size);
             }
-            ++token_idx;
+            new_size += kept_end - kept_begin;
         }
 
-        m_scores[decoder_layer_idx] = new_scores;
-        m_cache_counter[decoder_layer_idx] = new_counter;
+        accumulated_scores_for_current_decoder_layer.resize(new_size);
+        if (is_norm_sum) {
+            registration_indices_for_current_decoder_layer.resize(new_size);
+        }
     }
 
     CacheRotationCalculator::CacheRotationCalculator(size_t block_size,
@@ -86,6 +86,22 @@ public:
      */
     void register_new_token_scores(const AttentionScoresForEachDecoderLayer& attention_scores_for_all_decoder_layers);
 
+    /**
+     * Registers attention scores of a single decoder layer, same as above. Calls for different layers are independent and
+     * may be made concurrently.
+     * @param attention_scores Per-token attention scores calculated within the layer.
+     * @param decoder_layer_idx Index of the decoder layer.
+     */
+    void register_new_token_scores(const AttentionScoresForCacheOfSubsequence& attention_scores, size_t decoder_layer_idx);
+
+    /**
+     * Drops the scores accumulated so far for the tokens tracked in the cache of a single decoder layer, so that the
+     * importance of the tokens is determined only by the scores registered afterwards. Used to select the prompt blocks
+     * kept after prefill by the scores of the observation window at the end of the prompt (SnapKV).
+     * @param decoder_layer_idx Index of the decoder layer.
+     */
+    void reset_scores(size_t decoder_layer_idx);
+
     /**
      * Returns the per-layer sets of logical block indices that should be evicted according to the internally computed importance scores
      * and removes the corresponding blocks from the internal algorithm tracking.
@@ -95,6 +111,19 @@ public:
      */
     std::vector<std::set<std::size_t>> evict_logical_blocks();
 
+    /**
+     * Returns the set of logical block indices that should be evicted from the cache of a single decoder layer, same as
+     * above. Calls for different layers are independent and may be made concurrently.
+     * @param decoder_layer_idx Index of the decoder layer.
+     */
+    std::set<std::size_t> evict_logical_blocks(size_t decoder_layer_idx);
+
+    /**
+     * @return The number of decoder layers this CacheEvictionAlgorithm was initialized with.
+     */
+    std::size_t get_num_decoder_layers() const {
+        return m_num_decoder_layers;
+    }
 
 private:
     std::size_t get_num_blocks(std::size_t num_tokens) const;
@@ -111,10 +140,13 @@ private:
 
     CacheEvictionConfig m_eviction_config;
     std::size_t m_block_size;
-    std::size_t m_num_evicted_tokens = 0;
     std::size_t m_num_decoder_layers;
+    // per-layer accumulated scores of the tracked tokens, contiguous in the logical order of the tokens
     std::vector<std::vector<double>> m_scores;
-    std::vector<std::vector<size_t>> m_cache_counter;
+    // for NORM_SUM, per-layer registration order of the tracked tokens and the number of registered tokens, so that
+    // the number of times a token has been attended to is their difference and doesn't need updating for every token
+    std::vector<std::vector<size_t>> m_token_registration_indices;
+    std::vector<size_t> m_num_registered_tokens;
 };
 
 /**
@@ -5,8 +5,11 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 
 #include "openvino/runtime/tensor.hpp"
+#include "openvino/core/parallel.hpp"
+#include "continuous_batching/reserved_host_memory.hpp"
 
 namespace ov::genai {
 
@@ -21,6 +24,8 @@ class CacheManager {
     ov::InferRequest m_request;
     size_t m_k_head_size = 0;
     ov::RemoteContext m_context;
+    // host memory of the key and value caches for each decoder layer, if allocated on host
+    std::vector<std::shared_ptr<ReservedHostMemory>> m_key_cache_memory, m_value_cache_memory;
 
     static ov::Shape set_kv_blocks(ov::PartialShape pshape, size_t num_kv_blocks) {
         pshape[0] = num_kv_blocks;
@@ -32,6 +37,127 @@ class CacheManager {
         m_request.set_tensor(std::string("value_cache.") + std::to_string(decoder_layer_id), m_value_cache[decoder_layer_id]);
     }
 
+    static size_t get_block_stride_in_bytes(const ov::PartialShape& pshape, ov::element::Type precision) {
+        size_t num_elements = pshape[1].get_length() * pshape[2].get_length() * pshape[3].get_length();
+        return num_elements * precision.bitwidth() / 8;
+    }
+
+    size_t copy_block_to_host(const ov::Tensor& cache, const ov::PartialShape& pshape, size_t block_id, uint8_t* dst_ptr) const {
+        const size_t stride = get_block_stride_in_bytes(pshape, cache.get_element_type());
+        if (cache.is<ov::RemoteTensor>()) {
+            OPENVINO_ASSERT(cache.get_element_type().bitwidth() >= 8, "Reading sub-byte KV cache blocks from device memory is not supported");
+            ov::Shape cache_shape = cache.get_shape();
+            ov::Coordinate start_roi(cache_shape.size(), 0), end_roi = cache_shape;
+            end_roi[0] = (start_roi[0] = block_id) + 1;
+            ov::RemoteTensor src_roi(cache.as<ov::RemoteTensor>(), start_roi, end_roi);
+            ov::Tensor dst(cache.get_element_type(), src_roi.get_shape(), dst_ptr);
+            src_roi.copy_to(dst);
+        } else {
+            OPENVINO_SUPPRESS_DEPRECATED_START
+            const uint8_t* src_ptr = reinterpret_cast<const uint8_t*>(cache.data()) + block_id * stride;
+            OPENVINO_SUPPRESS_DEPRECATED_END
+            std::memcpy(dst_ptr, src_ptr, stride);
+        }
+        return stride;
+    }
+
+    size_t copy_block_from_host(ov::Tensor& cache, const ov::PartialShape& pshape, size_t block_id, const uint8_t* src_ptr) {
+        const size_t stride = get_block_stride_in_bytes(pshape, cache.get_element_type());
+        if (cache.is<ov::RemoteTensor>()) {
+            OPENVINO_ASSERT(cache.get_element_type().bitwidth() >= 8, "Writing sub-byte KV cache blocks to device memory is not supported");
+            ov::Shape cache_shape = cache.get_shape();
+            ov::Coordinate start_roi(cache_shape.size(), 0), end_roi = cache_shape;
+            end_roi[0] = (start_roi[0] = block_id) + 1;
+            ov::RemoteTensor dst_roi(cache.as<ov::RemoteTensor>(), start_roi, end_roi);
+            ov::Tensor src(cache.get_element_type(), dst_roi.get_shape(), const_cast<uint8_t*>(src_ptr));
+            dst_roi.copy_from(src);
+        } else {
+            OPENVINO_SUPPRESS_DEPRECATED_START
+            uint8_t* dst_ptr = reinterpret_cast<uint8_t*>(cache.data()) + block_id * stride;
+            OPENVINO_SUPPRESS_DEPRECATED_END
+            std::memcpy(dst_ptr, src_ptr, stride);
+        }
+        return stride;
+    }
+
+    /**
+     * Calls `func(precision, pshape)` for each part of the block contents in the `read_block` layout.
+     */
+    template <typename Func>
+    void for_each_block_contents_part(Func func) const {
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            func(m_key_precisions[decoder_layer_id], m_key_shapes[decoder_layer_id]);
+            func(m_value_precisions[decoder_layer_id], m_value_shapes[decoder_layer_id]);
+        }
+    }
+
+    struct BlockCopyRun {
+        size_t src_block_id;
+        size_t dst_block_id;
+        size_t num_blocks;
+    };
+
+    void copy_block_runs(ov::Tensor& cache, const ov::PartialShape& pshape, const std::vector<BlockCopyRun>& copy_runs) {
+        const bool is_sub_byte = cache.get_element_type().bitwidth() < 8;
+        if (cache.is<ov::RemoteTensor>()) {
+            if (is_sub_byte) {
+                return;
+            }
+            ov::Shape cache_shape = cache.get_shape();
+            for (const auto& copy_run : copy_runs) {
+                ov::Coordinate src_start_roi(cache_shape.size(), 0), src_end_roi = cache_shape;
+                ov::Coordinate dst_start_roi(cache_shape.size(), 0), dst_end_roi = cache_shape;
+                src_end_roi[0] = (src_start_roi[0] = copy_run.src_block_id) + copy_run.num_blocks;
+                dst_end_roi[0] = (dst_start_roi[0] = copy_run.dst_block_id) + copy_run.num_blocks;
+                ov::Tensor src_cache_roi(cache, src_start_roi, src_end_roi);
+                ov::Tensor dst_cache_roi(cache, dst_start_roi, dst_end_roi);
+                src_cache_roi.copy_to(dst_cache_roi);
+            }
+            return;
+        }
+
+        // the whole block is contiguous in memory, including sub-byte precisions
+        const size_t stride = get_block_stride_in_bytes(pshape, cache.get_element_type());
+        OPENVINO_SUPPRESS_DEPRECATED_START
+        uint8_t* cache_ptr = reinterpret_cast<uint8_t*>(cache.data());
+        OPENVINO_SUPPRESS_DEPRECATED_END
+        for (const auto& copy_run : copy_runs) {
+            std::memcpy(cache_ptr + copy_run.dst_block_id * stride, cache_ptr + copy_run.src_block_id * stride, copy_run.num_blocks * stride);
+        }
+    }
+
+    /**
+     * Returns a host cache tensor of a given shape for a decoder layer, placed at the beginning of the layer's reserved memory.
+     * The memory is reserved for as many blocks as fit into the physical memory of the host, so that the cache
+     * normally grows without reallocation. Otherwise, the cache is moved to a new, larger reservation.
+     */
+    ov::Tensor grow_host_cache(std::vector<std::shared_ptr<ReservedHostMemory>>& cache_memory,
+                               const std::vector<ov::Tensor>& cache,
+                               size_t decoder_layer_id,
+                               ov::element::Type precision,
+                               const ov::Shape& shape) {
+        const size_t byte_size = (ov::shape_size(shape) * precision.bitwidth() + 7) / 8;
+        if (cache_memory.size() <= decoder_layer_id || cache_memory[decoder_layer_id]->capacity() < byte_size) {
+            const size_t block_stride = byte_size / shape[0];
+            const size_t max_num_kv_blocks = ReservedHostMemory::get_total_physical_memory() / m_block_size_in_bytes;
+            auto memory = std::make_shared<ReservedHostMemory>(std::max(byte_size, max_num_kv_blocks * block_stride));
+            if (cache.size() > decoder_layer_id) {
+                // reservation is exhausted, previous cache data has to be moved
+                const ov::Tensor& prev_cache = cache[decoder_layer_id];
+                const size_t prev_byte_size = (prev_cache.get_size() * precision.bitwidth() + 7) / 8;
+                memory->commit(prev_byte_size);
+                std::memcpy(memory->data(), prev_cache.data(), prev_byte_size);
+            }
+            if (cache_memory.size() > decoder_layer_id) {
+                cache_memory[decoder_layer_id] = memory;
+            } else {
+                cache_memory.push_back(memory);
+            }
+        }
+        cache_memory[decoder_layer_id]->commit(byte_size);
+        return ov::Tensor(precision, shape, cache_memory[decoder_layer_id]->data());
+    }
+
 public:
     explicit CacheManager(ov::InferRequest request) :
         m_request(request) {
@@ -147,47 +273,16 @@ public:
                 update_request_tensor(decoder_layer_id);
             }
         } else {
+            // on host, caches grow in place within the reserved address space, so the already stored
+            // blocks are neither copied nor temporarily duplicated
             for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
                 ov::Shape value_cache_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks);
                 ov::Shape key_cache_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks);
 
-                ov::element::Type key_precision = get_key_cache_precision(decoder_layer_id);
-                ov::element::Type value_precision = get_value_cache_precision(decoder_layer_id);
-
-                ov::Tensor key_cache(key_precision, key_cache_shape);
-                ov::Tensor value_cache(value_precision, value_cache_shape);
-
-                auto key_cache_roi_end = static_cast<unsigned char*>(key_cache.data());
-                auto value_cache_roi_end = static_cast<unsigned char*>(value_cache.data());
-                size_t key_roi_size_byte = 0;
-                size_t value_roi_size_byte = 0;
-
-                if (m_key_cache.size() > decoder_layer_id) {
-                    ov::Coordinate end_key = m_key_cache[decoder_layer_id].get_shape();
-                    ov::Coordinate end_value = m_value_cache[decoder_layer_id].get_shape();
-                    // copy current cache data
-                    if (key_precision == ov::element::u4) {
-                        size_t key_stride = std::accumulate(end_key.begin(), end_key.end(), 1, std::multiplies<size_t>());
-                        size_t key_roi_size_byte = key_stride + (key_stride & 1) / sub_byte_data_type_multiplier(key_precision);
-                        std::memcpy(reinterpret_cast<uint8_t*>(key_cache.data()), reinterpret_cast<uint8_t*>(m_key_cache[decoder_layer_id].data()), key_roi_size_byte);
-                    } else {
-                        key_roi_size_byte = m_key_cache[decoder_layer_id].get_byte_size();
-                        ov::Tensor dst_key_roi(key_cache, start_key, end_key);
-                        key_cache_roi_end = static_cast<unsigned char*>(key_cache.data()) + key_roi_size_byte;
-                        m_key_cache[decoder_layer_id].copy_to(dst_key_roi);
-                    }
-
-                    if (value_precision == ov::element::u4) {
-                        size_t value_stride = std::accumulate(end_value.begin(), end_value.end(), 1, std::multiplies<size_t>());
-                        size_t value_roi_size_byte = value_stride + (value_stride & 1) / sub_byte_data_type_multiplier(value_precision);
-                        std::memcpy(reinterpret_cast<uint8_t*>(value_cache.data()), reinterpret_cast<uint8_t*>(m_value_cache[decoder_layer_id].data()), value_roi_size_byte);
-                    } else {
-                        value_roi_size_byte = m_value_cache[decoder_layer_id].get_byte_size();
-                        value_cache_roi_end = static_cast<unsigned char*>(value_cache.data()) + value_roi_size_byte;
-                        ov::Tensor dst_value_roi(value_cache, start_value, end_value);
-                        m_value_cache[decoder_layer_id].copy_to(dst_value_roi);
-                    }
-                }
+                ov::Tensor key_cache = grow_host_cache(m_key_cache_memory, m_key_cache, decoder_layer_id,
+                                                       get_key_cache_precision(decoder_layer_id), key_cache_shape);
+                ov::Tensor value_cache = grow_host_cache(m_value_cache_memory, m_value_cache, decoder_layer_id,
+                                                         get_value_cache_precision(decoder_layer_id), value_cache_shape);
 
                 // set new cache tensors
                 if (m_key_cache.size() > decoder_layer_id) {
@@ -217,62 +312,111 @@ public:
         return m_value_shapes[layer_id][3].get_length();
     }
 
+    /**
+     * @return The size in bytes of the contents of a single KV cache block across all decoder layers, both for keys and values,
+     * as read by `read_block` and written by `write_block`.
+     */
+    size_t get_block_contents_size() const {
+        size_t contents_size = 0;
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            contents_size += get_block_stride_in_bytes(m_key_shapes[decoder_layer_id], m_key_precisions[decoder_layer_id]);
+            contents_size += get_block_stride_in_bytes(m_value_shapes[decoder_layer_id], m_value_precisions[decoder_layer_id]);
+        }
+        return contents_size;
+    }
+
+    /**
+     * @return Identifier of the block contents layout: precisions and shapes of the key and value blocks of all decoder layers.
+     * Contents of blocks with different identifiers are not interchangeable, even if they are of the same size.
+     */
+    uint64_t get_block_layout_id() const {
+        // FNV-1a over the layout description
+        uint64_t layout_id = 0xcbf29ce484222325;
+        auto mix = [&layout_id](uint64_t value) {
+            layout_id = (layout_id ^ value) * 0x100000001b3;
+        };
+        for_each_block_contents_part([&](ov::element::Type precision, const ov::PartialShape& pshape) {
+            mix(static_cast<uint64_t>(ov::element::Type_t(precision)));
+            // dimension 0 is the number of blocks
+            for (size_t dim = 1; dim < pshape.size(); ++dim) {
+                mix(pshape[dim].is_static() ? pshape[dim].get_length() : 0);
+            }
+        });
+        return layout_id;
+    }
+
+    /**
+     * Reads the contents of a KV cache block into a host buffer. For each decoder layer, key block contents are followed by value block ones.
+     * @param block_id The index of the block.
+     * @param contents The buffer to read the block contents into.
+     */
+    void read_block(size_t block_id, std::vector<uint8_t>& contents) const {
+        OPENVINO_ASSERT(block_id < m_num_allocated_kv_blocks, "block_id = ", block_id, ", num_allocated_kv_blocks = ", m_num_allocated_kv_blocks);
+        contents.resize(get_block_contents_size());
+        uint8_t* dst_ptr = contents.data();
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            dst_ptr += copy_block_to_host(m_key_cache[decoder_layer_id], m_key_shapes[decoder_layer_id], block_id, dst_ptr);
+            dst_ptr += copy_block_to_host(m_value_cache[decoder_layer_id], m_value_shapes[decoder_layer_id], block_id, dst_ptr);
+        }
+    }
+
+    /**
+     * Writes the contents of a KV cache block from a host buffer with the layout produced by `read_block`.
+     * @param block_id The index of the block.
+     * @param contents The block contents.
+     */
+    void write_block(size_t block_id, const std::vector<uint8_t>& contents) {
+        OPENVINO_ASSERT(block_id < m_num_allocated_kv_blocks, "block_id = ", block_id, ", num_allocated_kv_blocks = ", m_num_allocated_kv_blocks);
+        OPENVINO_ASSERT(contents.size() == get_block_contents_size(), "Expected block contents of ", get_block_contents_size(), " bytes, got ", contents.size());
+        const uint8_t* src_ptr = contents.data();
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            src_ptr += copy_block_from_host(m_key_cache[decoder_layer_id], m_key_shapes[decoder_layer_id], block_id, src_ptr);
+            src_ptr += copy_block_from_host(m_value_cache[decoder_layer_id], m_value_shapes[decoder_layer_id], block_id, src_ptr);
+        }
+    }
+
+    /**
+     * Copies contents of KV cache blocks for all decoder layers. Copies to contiguous destination blocks from contiguous
+     * source blocks are coalesced into a single copy, and on the host memory the layers are processed in parallel.
+     * @param block_copy_map A map where each key is an index of a source block, and the corresponding value is a list of
+     * block indices into which the source block contents should be copied. Source and destination blocks must not intersect.
+     */
     void copy_blocks(const std::map<size_t, std::list<size_t>>& block_copy_map) {
-        for (const auto & blocks_pair : block_copy_map) {
-            size_t src_block_id = blocks_pair.first;
-            const std::list<size_t>& dst_block_ids = blocks_pair.second;
+        if (block_copy_map.empty()) {
+            return;
+        }
+
+        std::vector<std::pair<size_t, size_t>> src_dst_block_ids;
+        for (const auto& [src_block_id, dst_block_ids] : block_copy_map) {
             for (size_t dst_block_id : dst_block_ids) {
-                for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
-                    ov::Shape key_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Shape value_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Coordinate key_src_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_src_end_roi = key_shape;
-                    ov::Coordinate key_dst_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_dst_end_roi = key_shape;
-            
-                    ov::Coordinate value_src_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_src_end_roi = value_shape;
-                    ov::Coordinate value_dst_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_dst_end_roi = value_shape;
-                    key_src_end_roi[0] = (key_src_start_roi[0] = src_block_id) + 1;
-                    value_src_end_roi[0] = (value_src_start_roi[0] = src_block_id) + 1;
-                    key_dst_end_roi[0] = (key_dst_start_roi[0] = dst_block_id) + 1;
-                    value_dst_end_roi[0] = (value_dst_start_roi[0] = dst_block_id) + 1;
-
-                    auto copy_one_block = [&](ov::Tensor& dst, const ov::Tensor& src, size_t src_start, size_t dst_start, size_t stride) {
-                        const bool is_remote = dst.is<ov::RemoteTensor>() || src.is<ov::RemoteTensor>();
-                        if (is_remote) {
-                            return;
-                        }
-                        auto sub_byte_multipyer = sub_byte_data_type_multiplier(dst.get_element_type());
-                        OPENVINO_SUPPRESS_DEPRECATED_START
-                        const uint8_t* src_ptr = reinterpret_cast<const uint8_t*>(src.data()) + src_start * stride;
-                        uint8_t* dst_ptr = reinterpret_cast<uint8_t*>(dst.data()) + dst_start * stride;
-                        OPENVINO_SUPPRESS_DEPRECATED_END
-                        std::memcpy(dst_ptr, src_ptr, 1 * stride);
-                    };
-
-                    const auto& key_cache_prec = m_key_cache[decoder_layer_id].get_element_type();
-                    if (key_cache_prec == ov::element::u4 || key_cache_prec == ov::element::i4) {
-                        size_t stride = std::accumulate(std::next(key_shape.begin()), key_shape.end(), 1, std::multiplies<size_t>()) / 2;
-                        copy_one_block(m_key_cache[decoder_layer_id], m_key_cache[decoder_layer_id], key_src_start_roi[0], key_dst_start_roi[0], stride);
-                    } else {
-                        ov::Tensor key_src_cache_roi(m_key_cache[decoder_layer_id], key_src_start_roi, key_src_end_roi);
-                        ov::Tensor key_dst_cache_roi(m_key_cache[decoder_layer_id], key_dst_start_roi, key_dst_end_roi);
-                        key_src_cache_roi.copy_to(key_dst_cache_roi);
-                    }
-
-                    const auto& value_cache_prec = m_value_cache[decoder_layer_id].get_element_type();
-                    if (value_cache_prec == ov::element::u4 || value_cache_prec == ov::element::i4) {
-                        size_t stride = std::accumulate(std::next(value_shape.begin()), value_shape.end(), 1, std::multiplies<size_t>()) / 2;
-                        copy_one_block(m_value_cache[decoder_layer_id], m_value_cache[decoder_layer_id], value_src_start_roi[0], value_dst_start_roi[0], stride);
-                    } else {
-                        ov::Tensor value_src_cache_roi(m_value_cache[decoder_layer_id], value_src_start_roi, value_src_end_roi);
-                        ov::Tensor value_dst_cache_roi(m_value_cache[decoder_layer_id], value_dst_start_roi, value_dst_end_roi);
-                        value_src_cache_roi.copy_to(value_dst_cache_roi);
-                    }
+                src_dst_block_ids.emplace_back(src_block_id, dst_block_id);
+            }
+        }
+        std::sort(src_dst_block_ids.begin(), src_dst_block_ids.end(), [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+
+        std::vector<BlockCopyRun> copy_runs;
+        for (const auto& [src_block_id, dst_block_id] : src_dst_block_ids) {
+            if (!copy_runs.empty()) {
+                BlockCopyRun& last_run = copy_runs.back();
+                if (last_run.src_block_id + last_run.num_blocks == src_block_id && last_run.dst_block_id + last_run.num_blocks == dst_block_id) {
+                    ++last_run.num_blocks;
+                    continue;
                 }
             }
+            copy_runs.push_back({src_block_id, dst_block_id, 1});
+        }
+
+        auto copy_layer_blocks = [&](size_t decoder_layer_id) {
+            copy_block_runs(m_key_cache[decoder_layer_id], m_key_shapes[decoder_layer_id], copy_runs);
+            copy_block_runs(m_value_cache[decoder_layer_id], m_value_shapes[decoder_layer_id], copy_runs);
+        };
+
+        if (m_context) {
+            for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+                copy_layer_blocks(decoder_layer_id);
+            }
+        } else {
+            ov::parallel_for(m_num_decoder_layers, copy_layer_blocks);
         }
     }
 };
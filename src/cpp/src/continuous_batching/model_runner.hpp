@@ -46,6 +46,17 @@ class ModelRunner {
     // Output shape: [1, conversation length, hidden_size].
     EmbeddingsModel::Ptr m_embedding;
 
+    // Model inputs reused across `forward` calls
+    struct ReusableInputTensor {
+        // grow-only storage sized to the high-water mark
+        ov::Tensor storage;
+        // part of the storage currently set to the infer request
+        ov::Tensor view;
+    };
+    std::map<std::string, ReusableInputTensor> m_input_tensors;
+    std::vector<int64_t> m_gather_indices_values;
+    bool m_is_matmul_gathering_available = false;
+
 public:
     /**
      * Constructs the ModelRunner.
@@ -72,6 +83,10 @@ public:
           m_rotated_block_logical_indices_per_sequence_for_each_layer(num_decoder_layers) {
         OPENVINO_ASSERT(m_num_decoder_layers != 0, "num_decoder_layers must be non-zero");
         _reset_cache_rotation_coefficients();
+        try {
+            std::ignore = m_request.get_tensor("sampled_tokens_indices");
+            m_is_matmul_gathering_available = true;
+        } catch (const ov::Exception&) {}
     }
 
     /**
@@ -114,6 +129,79 @@ public:
      * @return An ov::Tensor with next-token logit scores for each sequence processed during this `forward` call.
      */
     ov::Tensor forward(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
+        _prepare_inputs(sequence_groups, scheduler_output);
+
+        {
+            static thread_local ManualTimer timer("pure generate inference");
+            timer.start();
+            m_request.infer();
+            timer.end();
+        }
+
+        return _process_outputs(sequence_groups, scheduler_output);
+    }
+
+    /**
+     * Same as `forward`, but only fills the model inputs and starts the inference asynchronously, so that the caller
+     * can perform other CPU work while the model is being inferred. Must be followed by a `wait_forward` call with the same arguments
+     * before the sequence groups are modified in a way that affects the scheduled tokens.
+     * @param sequence_groups A vector of pointers to sequence groups to be processed during this `forward` call
+     * @param scheduler_output The scheduler output struct with information on the specifics of the token scheduling during this forward call
+     */
+    void forward_async(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
+        _prepare_inputs(sequence_groups, scheduler_output);
+        m_request.start_async();
+    }
+
+    /**
+     * Waits for the inference started by `forward_async` to complete.
+     * @param sequence_groups A vector of pointers to sequence groups passed to the preceding `forward_async` call
+     * @param scheduler_output The scheduler output struct passed to the preceding `forward_async` call
+     * @return An ov::Tensor with next-token logit scores for each sequence processed during this `forward` call.
+     */
+    ov::Tensor wait_forward(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
+        {
+            static thread_local ManualTimer timer("wait for async generate inference");
+            timer.start();
+            m_request.wait();
+            timer.end();
+        }
+
+        return _process_outputs(sequence_groups, scheduler_output);
+    }
+
+private:
+    /**
+     * Returns a tensor of a given shape to be filled in place for a given model input. The tensor is a view of a storage
+     * which only grows to the high-water mark along the first dimension, and is set to the infer request only when the shape changes.
+     * @param name The name of the model input.
+     * @param type The element type of the input.
+     * @param shape The shape of the input for the current inference.
+     * @return A tensor which is set to the infer request as the input.
+     */
+    ov::Tensor _get_input_tensor(const std::string& name, const ov::element::Type& type, const ov::Shape& shape) {
+        ReusableInputTensor& input = m_input_tensors[name];
+        if (input.view && input.view.get_shape() == shape) {
+            return input.view;
+        }
+
+        if (ov::shape_size(shape) == 0) {
+            input.view = ov::Tensor(type, shape);
+        } else {
+            const ov::Shape& storage_shape = input.storage ? input.storage.get_shape() : ov::Shape{};
+            bool is_storage_sufficient = input.storage && storage_shape.size() == shape.size() &&
+                (shape.empty() || (storage_shape[0] >= shape[0] && std::equal(shape.begin() + 1, shape.end(), storage_shape.begin() + 1)));
+            if (!is_storage_sufficient) {
+                input.storage = ov::Tensor(type, shape);
+            }
+            input.view = input.storage.get_shape() == shape ? input.storage :
+                ov::Tensor(input.storage, ov::Coordinate(shape.size(), 0), ov::Coordinate(shape));
+        }
+        m_request.set_tensor(name, input.view);
+        return input.view;
+    }
+
+    void _prepare_inputs(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
         size_t batch_size_in_sequences = 0;
         size_t total_num_tokens = 0, total_num_blocks = 0;
@@ -136,30 +224,26 @@ public:
             max_context_len_val = std::max(max_context_len_val, sequence_group->get_context_len());
         }
 
+        // inputs are filled in place, tensors are re-set to the request only if their shapes change
         ov::Tensor
-            input_ids(ov::element::i64, {total_num_tokens}),
-            inputs_embeds(ov::element::f32, {total_num_tokens, hidden_size}),
-            position_ids(ov::element::i64, {total_num_tokens}),
+            position_ids = _get_input_tensor("position_ids", ov::element::i64, {total_num_tokens}),
             // PA specific parameters
-            past_lens(ov::element::i32, {batch_size_in_sequences}),
-            subsequence_begins(ov::element::i32, {batch_size_in_sequences + 1}),
+            past_lens = _get_input_tensor("past_lens", ov::element::i32, {batch_size_in_sequences}),
+            subsequence_begins = _get_input_tensor("subsequence_begins", ov::element::i32, {batch_size_in_sequences + 1}),
             // block_indices are handled in a special fashion below
-            block_indices_begins(ov::element::i32, {batch_size_in_sequences + 1}),
-            max_context_len(ov::element::i32, {});
-        
-        ov::Tensor generated_ids_embeds;
-        float *generated_ids_embeds_data = nullptr;
+            block_indices_begins = _get_input_tensor("block_indices_begins", ov::element::i32, {batch_size_in_sequences + 1}),
+            max_context_len = _get_input_tensor("max_context_len", ov::element::i32, {});
 
         max_context_len.data<int32_t>()[0] = max_context_len_val;
 
         // get raw pointers to copy to
         float *inputs_embeds_data = nullptr;
         int64_t *input_ids_data = nullptr;
-        
+
         if (sequence_group_type == SequenceGroupType::EMBEDDINGS) {
-            inputs_embeds_data = inputs_embeds.data<float>();
+            inputs_embeds_data = _get_input_tensor("inputs_embeds", ov::element::f32, {total_num_tokens, hidden_size}).data<float>();
         } else if (sequence_group_type == SequenceGroupType::TOKENS) {
-            input_ids_data = input_ids.data<int64_t>();
+            input_ids_data = _get_input_tensor("input_ids", ov::element::i64, {total_num_tokens}).data<int64_t>();
         }
 
         int64_t
@@ -174,14 +258,10 @@ public:
         subsequence_begins_data[0] = 0;
         block_indices_begins_data[0] = 0;
 
-        bool matmul_gathering_is_available = false;
+        const bool matmul_gathering_is_available = m_is_matmul_gathering_available;
         size_t gathering_current_index = 0;
-        std::vector<int64_t> gather_indices_values;
-        try {
-            std::ignore = m_request.get_tensor("sampled_tokens_indices");
-            matmul_gathering_is_available = true;
-        } catch (const ov::Exception&) {}
-
+        std::vector<int64_t>& gather_indices_values = m_gather_indices_values;
+        gather_indices_values.clear();
 
         for (size_t i = 0; i < num_sequence_groups; ++i) {
             size_t seq_group_id = scheduler_output.m_scheduled_sequence_groups_ids[i];
@@ -255,23 +335,7 @@ public:
             sequence_group->set_output_seq_len(matmul_gathering_is_available ? output_seq_len : num_scheduled_tokens);
         }
 
-        if (sequence_group_type == SequenceGroupType::TOKENS) {
-            m_request.set_tensor("input_ids", input_ids);
-        }
-        else if (sequence_group_type == SequenceGroupType::EMBEDDINGS) {
-            m_request.set_tensor("inputs_embeds", inputs_embeds);
-        }
-
-        // typical LLM parameters
-        m_request.set_tensor("position_ids", position_ids);
-
-        // PA specific parameters
-        m_request.set_tensor("past_lens", past_lens);
-        m_request.set_tensor("subsequence_begins", subsequence_begins);
-
         _set_block_indices(sequence_groups, scheduler_output, total_num_blocks);
-        m_request.set_tensor("block_indices_begins", block_indices_begins);
-        m_request.set_tensor("max_context_len", max_context_len);
 
         if (m_is_use_rotation_inputs) {
             m_request.set_tensor("rotation_trig_lut", m_cache_rotation_trig_lut);
@@ -279,9 +343,8 @@ public:
         }
 
         if (matmul_gathering_is_available) {
-            ov::Tensor gather_indices(ov::element::i64, {gather_indices_values.size()});
+            ov::Tensor gather_indices = _get_input_tensor("sampled_tokens_indices", ov::element::i64, {gather_indices_values.size()});
             std::memcpy(gather_indices.data(), gather_indices_values.data(), gather_indices_values.size() * sizeof(int64_t));
-            m_request.set_tensor("sampled_tokens_indices", gather_indices);
         }
 
         // print_tensor("input_ids", input_ids);
@@ -292,14 +355,9 @@ public:
         // print_tensor("block_indices", block_indices);
         // print_tensor("block_indices_begins", block_indices_begins);
         // print_tensor("max_context_len", max_context_len);
+    }
 
-        {
-            static ManualTimer timer("pure generate inference");
-            timer.start();
-            m_request.infer();
-            timer.end();
-        }
-
+    ov::Tensor _process_outputs(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
         if (m_collect_attention_scores) {
             _collect_attention_scores(sequence_groups, scheduler_output);
         }
@@ -310,6 +368,7 @@ public:
         return m_request.get_tensor("logits");
     }
 
+public:
     void append_embeddings(const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output) {
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
         size_t num_generated_ids_without_embeddings = 0;
@@ -369,6 +428,7 @@ public:
 private:
     void _fill_indices_from_block_tables(
         const std::vector<std::string>& dst_tensor_names,
+        const std::vector<ov::Tensor>& dst_tensors,
         const std::vector<SequenceGroup::Ptr>& sequence_groups,
         const Scheduler::Output& scheduler_output,
         const std::vector<std::map<size_t, std::vector<size_t>>>& seq_id_to_select_logical_idx_maps) {
@@ -380,8 +440,7 @@ private:
 
 
         for (size_t layer_idx = 0; layer_idx < dst_tensor_names.size(); layer_idx++) {
-            auto input_tensor = m_request.get_tensor(dst_tensor_names[layer_idx]);
-            auto block_indices_data = input_tensor.data<int32_t>();
+            auto block_indices_data = dst_tensors[layer_idx].data<int32_t>();
             if (is_fill_all) {
                 for (size_t i = 0; i < num_sequence_groups; ++i) {
                     size_t seq_group_id = scheduler_output.m_scheduled_sequence_groups_ids[i];
@@ -429,7 +488,7 @@ private:
         }
         for (size_t layer_idx = 0; layer_idx < dst_tensor_names.size(); layer_idx++) {
             const auto& target_tensor_name = dst_tensor_names[layer_idx];
-            size_t tensor_size = m_request.get_tensor(target_tensor_name).get_size();
+            size_t tensor_size = dst_tensors[layer_idx].get_size();
             size_t last_filled_element_idx = filled_blocks_per_layer[layer_idx];
             OPENVINO_ASSERT(tensor_size == last_filled_element_idx, "did not fill tensor ", target_tensor_name, " completely, tensor size in elements ", tensor_size, ", last filled idx ", last_filled_element_idx);
         }
@@ -447,16 +506,19 @@ private:
             }
         }
 
+        std::vector<ov::Tensor> block_indices;
+        block_indices.reserve(tensor_names.size());
         for (auto& name : tensor_names) {
-            m_request.get_tensor(name).set_shape({total_num_blocks});
+            block_indices.push_back(_get_input_tensor(name, ov::element::i32, {total_num_blocks}));
         }
 
-        _fill_indices_from_block_tables(tensor_names, sequence_groups, scheduler_output, {});
+        _fill_indices_from_block_tables(tensor_names, block_indices, sequence_groups, scheduler_output, {});
     }
 
     void _set_cache_rotation_coefficients(const std::vector<SequenceGroup::Ptr>& sequence_groups,
                                           const Scheduler::Output& scheduler_output) {
         std::vector<std::string> rotation_indices_tensor_names(m_num_decoder_layers);
+        std::vector<ov::Tensor> rotation_indices_tensors(m_num_decoder_layers);
         for (size_t i = 0; i < m_num_decoder_layers; i++) {
             auto tensor_name = std::string("rotated_block_indices.") + std::to_string(i);
             rotation_indices_tensor_names[i] = tensor_name;
@@ -464,8 +526,7 @@ private:
             for (const auto& entry : m_rotated_block_logical_indices_per_sequence_for_each_layer[i]) {
                 num_indices += entry.second.size();
             }
-            auto rotated_block_indices_tensor = m_request.get_tensor(tensor_name);
-            rotated_block_indices_tensor.set_shape({num_indices});
+            rotation_indices_tensors[i] = _get_input_tensor(tensor_name, ov::element::i32, {num_indices});
         }
 
         for (size_t i = 0; i < m_num_decoder_layers; i++) {
@@ -477,6 +538,7 @@ private:
         // NB: the order of per-sequence index filling in the function below must be the same
         // as the order of `seq_id`s in which the "rotation_coefficients.N" inputs are filled
         _fill_indices_from_block_tables(rotation_indices_tensor_names,
+                                        rotation_indices_tensors,
                                         sequence_groups,
                                         scheduler_output,
                                         m_rotated_block_logical_indices_per_sequence_for_each_layer);
@@ -40,6 +40,26 @@ extract_prompt_lookup_from_config(ov::AnyMap& config) {
     return res;
 }
 
+bool
+extract_pipelined_speculative_decoding_from_config(ov::AnyMap& config) {
+    bool res = false;
+    if (config.find(ov::genai::pipelined_speculative_decoding.name()) != config.end()) {
+        res = config.at(ov::genai::pipelined_speculative_decoding.name()).as<bool>();
+        config.erase(ov::genai::pipelined_speculative_decoding.name());
+    }
+    return res;
+}
+
+bool
+extract_stream_detokenization_from_config(ov::AnyMap& config) {
+    bool res = false;
+    if (config.find(ov::genai::stream_detokenization.name()) != config.end()) {
+        res = config.at(ov::genai::stream_detokenization.name()).as<bool>();
+        config.erase(ov::genai::stream_detokenization.name());
+    }
+    return res;
+}
+
 float get_load_time(std::chrono::steady_clock::time_point start_time) {
     auto stop_time = std::chrono::steady_clock::now();
     return std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time).count();
@@ -57,6 +77,9 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::p
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto is_sd_pipelining_enabled = extract_pipelined_speculative_decoding_from_config(properties_without_draft_model);
+    auto is_stream_detokenization_enabled = extract_stream_detokenization_from_config(properties_without_draft_model);
+    OPENVINO_ASSERT(!is_sd_pipelining_enabled || draft_model_desr.model != nullptr, "Pipelined speculative decoding requires a draft model");
 
     auto model = utils::read_model(models_path, properties);
     auto tokenizer = ov::genai::Tokenizer(models_path, tokenizer_properties);
@@ -74,7 +97,7 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::p
     } else if (draft_model_desr.model != nullptr) {
         OPENVINO_ASSERT(embedder == nullptr, "Speculative decoding is not supported for models with embeddings");
         auto main_model_descr = ov::genai::ModelDesc(model, tokenizer, device, properties_without_draft_model, scheduler_config, generation_config);
-        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr);
+        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr, is_sd_pipelining_enabled);
     } else if (embedder) {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, embedder, tokenizer, scheduler_config, device, properties, generation_config);
     }
@@ -82,6 +105,10 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::p
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, tokenizer, scheduler_config, device, properties, generation_config);
     }
 
+    if (is_stream_detokenization_enabled) {
+        m_impl->enable_stream_detokenization();
+    }
+
     m_impl->m_load_time_ms = get_load_time(start_time);
 }
 
@@ -96,6 +123,9 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto is_sd_pipelining_enabled = extract_pipelined_speculative_decoding_from_config(properties_without_draft_model);
+    auto is_stream_detokenization_enabled = extract_stream_detokenization_from_config(properties_without_draft_model);
+    OPENVINO_ASSERT(!is_sd_pipelining_enabled || draft_model_desr.model != nullptr, "Pipelined speculative decoding requires a draft model");
 
     auto model = utils::read_model(models_path, properties_without_draft_model);
     auto generation_config = utils::from_config_json_if_exists(models_path);
@@ -112,13 +142,17 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     } else if (draft_model_desr.model != nullptr) {
         OPENVINO_ASSERT(embedder == nullptr, "Speculative decoding is not supported for models with embeddings");
         auto main_model_descr = ov::genai::ModelDesc(model, tokenizer, device, properties_without_draft_model, scheduler_config, generation_config);
-        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr);
+        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr, is_sd_pipelining_enabled);
     } else if (embedder) {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, embedder, tokenizer, scheduler_config, device, properties, generation_config);
     } else {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, tokenizer, scheduler_config, device, properties, generation_config);
     }
 
+    if (is_stream_detokenization_enabled) {
+        m_impl->enable_stream_detokenization();
+    }
+
     m_impl->m_load_time_ms = get_load_time(start_time);
 }
 
@@ -135,6 +169,9 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto is_sd_pipelining_enabled = extract_pipelined_speculative_decoding_from_config(properties_without_draft_model);
+    auto is_stream_detokenization_enabled = extract_stream_detokenization_from_config(properties_without_draft_model);
+    OPENVINO_ASSERT(!is_sd_pipelining_enabled || draft_model_desr.model != nullptr, "Pipelined speculative decoding requires a draft model");
     auto model = utils::singleton_core().read_model(model_str, weights_tensor);
 
     auto rt_info = model->get_rt_info();
@@ -155,13 +192,17 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     } else if (draft_model_desr.model != nullptr) {
         OPENVINO_ASSERT(embedder == nullptr, "Speculative decoding is not supported for models with embeddings");
         auto main_model_descr = ov::genai::ModelDesc(model, tokenizer, device, properties_without_draft_model, scheduler_config, generation_config);
-        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr);
+        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr, is_sd_pipelining_enabled);
     } else if (embedder) {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, embedder, tokenizer, scheduler_config, device, properties, generation_config);
     } else {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, tokenizer, scheduler_config, device, properties, generation_config);
     }
 
+    if (is_stream_detokenization_enabled) {
+        m_impl->enable_stream_detokenization();
+    }
+
     m_impl->m_load_time_ms = get_load_time(start_time);
 }
 
@@ -178,6 +219,9 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto is_sd_pipelining_enabled = extract_pipelined_speculative_decoding_from_config(properties_without_draft_model);
+    auto is_stream_detokenization_enabled = extract_stream_detokenization_from_config(properties_without_draft_model);
+    OPENVINO_ASSERT(!is_sd_pipelining_enabled || draft_model_desr.model != nullptr, "Pipelined speculative decoding requires a draft model");
     auto model_pair = utils::get_model_weights_pair(models_map, "language");
     auto model = utils::singleton_core().read_model(model_pair.first, model_pair.second);
 
@@ -203,13 +247,17 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     } else if (draft_model_desr.model != nullptr) {
         OPENVINO_ASSERT(embedder == nullptr, "Speculative decoding is not supported for models with embeddings");
         auto main_model_descr = ov::genai::ModelDesc(model, tokenizer, device, properties_without_draft_model, scheduler_config, generation_config);
-        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr);
+        m_impl = std::make_shared<SpeculativeDecodingImpl>(main_model_descr, draft_model_desr, is_sd_pipelining_enabled);
     } else if (embedder) {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, embedder, tokenizer, scheduler_config, device, properties, generation_config);
     } else {
         m_impl = std::make_shared<ContinuousBatchingImpl>(model, tokenizer, scheduler_config, device, properties, generation_config);
     }
 
+    if (is_stream_detokenization_enabled) {
+        m_impl->enable_stream_detokenization();
+    }
+
     m_impl->m_load_time_ms = get_load_time(start_time);
 }
 
@@ -229,6 +277,10 @@ PipelineMetrics ContinuousBatchingPipeline::get_metrics() const{
     return m_impl->get_metrics();
 }
 
+void ContinuousBatchingPipeline::dump_trace(const std::filesystem::path& path) const {
+    m_impl->dump_trace(path);
+}
+
 GenerationHandle ContinuousBatchingPipeline::add_request(uint64_t request_id, const std::string& prompt, const ov::genai::GenerationConfig& sampling_params) {
     return m_impl->add_request(request_id, prompt, sampling_params);
 }
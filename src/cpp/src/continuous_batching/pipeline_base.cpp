@@ -31,10 +31,24 @@ PipelineMetrics ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_met
     return m_pipeline_metrics;
 }
 
+void ContinuousBatchingPipeline::IContinuousBatchingPipeline::dump_trace(const std::filesystem::path& path) const {
+    OPENVINO_THROW("Step tracing is not supported by this pipeline");
+}
+
 Tokenizer ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_tokenizer() {
     return m_tokenizer;
 }
 
+void ContinuousBatchingPipeline::IContinuousBatchingPipeline::enable_stream_detokenization() {
+    // batched decoding pads shorter lines with pad token, which is usually skipped by the detokenizer as a special token
+    const int64_t pad_token_id = m_tokenizer.get_pad_token_id();
+    const bool is_padding_skipped = pad_token_id != -1 && m_tokenizer.decode(std::vector<int64_t>{pad_token_id}).empty();
+    m_is_stream_detokenization_enabled = true;
+    m_stream_detokenizer = std::make_shared<StreamDetokenizer>([tokenizer = m_tokenizer](const std::vector<std::vector<int64_t>>& lines) mutable {
+        return tokenizer.decode(lines);
+    }, is_padding_skipped);
+}
+
 void ContinuousBatchingPipeline::IContinuousBatchingPipeline::start_chat(const std::string& system_message) {
     if (!system_message.empty()) {
         m_history.push_back({{"role", "system"}, {"content", system_message}});
@@ -277,6 +291,11 @@ void ContinuousBatchingPipeline::IContinuousBatchingPipeline::stream_tokens(
         return;
     }
 
+    if (streamer_ptr->is_text_streamed()) {
+        streamer_ptr->write_text(std::move(generation_outputs.begin()->second.text));
+        return;
+    }
+
     const auto tokens = generation_outputs.begin()->second.generated_ids;
     streamer_ptr->write(tokens);
 }
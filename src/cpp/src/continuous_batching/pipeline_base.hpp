@@ -10,6 +10,7 @@
 #include "sampling/sampler.hpp"
 #include "continuous_batching/model_runner.hpp"
 #include "continuous_batching/scheduler.hpp"
+#include "continuous_batching/stream_detokenizer.hpp"
 #include "continuous_batching/threaded_streamer.hpp"
 
 namespace ov::genai {
@@ -59,6 +60,11 @@ protected:
     std::shared_ptr<InputsEmbedder> m_inputs_embedder;
     std::mutex m_embeddings_mutex;
 
+    // decodes outputs of requests after every step if stream detokenization is enabled
+    std::shared_ptr<StreamDetokenizer> m_stream_detokenizer;
+    // also set by pipelines which delegate the decoding to the pipeline creating their handles
+    bool m_is_stream_detokenization_enabled = false;
+
     void stream_tokens(const std::shared_ptr<ThreadedStreamerWrapper>& streamer_ptr, const GenerationHandle& handle);
 public:
     GenerationConfig get_config() const;
@@ -66,6 +72,11 @@ public:
     PipelineMetrics get_metrics() const;
     Tokenizer get_tokenizer();
 
+    /**
+     * Enables decoding of streamed outputs, so that outputs read from handles have text of generated tokens
+     */
+    virtual void enable_stream_detokenization();
+
     /**
      * Adds requests to awaiting queue using encoded inputs
      */
@@ -100,6 +111,11 @@ public:
      */
     virtual void step() = 0;
 
+    /**
+     * Writes spans of the recent steps recorded by the step tracer as Chrome trace JSON
+     */
+    virtual void dump_trace(const std::filesystem::path& path) const;
+
     /**
      * Performs monolitic generation based on encoded prompts
      */
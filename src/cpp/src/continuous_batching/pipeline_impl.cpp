@@ -95,6 +95,26 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
         sampler_num_threads = sampler_num_threads_it->second.as<size_t>();
         filtered_properties.fork().erase("sampler_num_threads");   // do not use iterator sampler_num_threads_it because a forked container may not be the same container
     }
+    // Extract async_step property if exists and remove it from properties
+    // Note, that async step is not applicable to validation mode, since candidates are updated between steps
+    auto async_step_it = filtered_properties->find(ov::genai::async_step.name());
+    if (async_step_it != filtered_properties->end()) {
+        m_is_async_step_enabled = async_step_it->second.as<bool>() && !m_is_validation_mode_enabled;
+        filtered_properties.fork().erase(ov::genai::async_step.name());
+    }
+    // Enable step tracing, the tracer configured by the environment variables takes precedence over step_trace_capacity property
+    m_step_tracer = m_is_step_tracing_from_env_enabled ? StepTracer::from_env() : nullptr;
+    auto step_trace_capacity_it = filtered_properties->find("step_trace_capacity");
+    if (step_trace_capacity_it != filtered_properties->end()) {
+        if (!m_step_tracer) {
+            m_step_tracer = std::make_shared<StepTracer>(step_trace_capacity_it->second.as<size_t>());
+        }
+        filtered_properties.fork().erase("step_trace_capacity");
+    }
+    // stream_detokenization is applied by ContinuousBatchingPipeline once the pipeline is created
+    if (filtered_properties->count(ov::genai::stream_detokenization.name())) {
+        filtered_properties.fork().erase(ov::genai::stream_detokenization.name());
+    }
 
     ov::CompiledModel compiled_model = utils::singleton_core().compile_model(model, device, *filtered_properties);
     std::vector<std::string> execution_devices = compiled_model.get_property(ov::execution_devices);
@@ -124,6 +144,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
     }
 
     m_scheduler = std::make_shared<Scheduler>(m_block_size, cache_manager, normalized_config, m_num_decoder_layers, can_use_partial_preemption);
+    m_scheduler->set_step_tracer(m_step_tracer);
 
     // Model Runner
     bool is_use_cache_eviction = m_scheduler->get_config().use_cache_eviction;
@@ -136,6 +157,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
                                                        /* collect_attention_scores = */ true,
                                                        /* is_use_per_layer_cache_control = */ true,
                                                        /* is_use_rotation_inputs = */ is_apply_rotation);
+        m_cache_eviction_thread_pool = std::make_unique<ThreadPool>(sampler_num_threads);
         if (eviction_config.apply_rotation) {
             m_rotation_deltas_stores.reserve(m_num_decoder_layers);
             ov::Shape rotation_deltas_store_shape{normalized_config.num_kv_blocks, 1}; // last dim can be later changed to BLOCK_SIZE for per-token granularity
@@ -175,6 +197,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
 
     m_sampler = std::make_shared<Sampler>(m_tokenizer, sampler_num_threads);
     m_sampler->set_seed(m_generation_config.rng_seed);
+    m_sampler->set_postprocessing_deferred(m_is_async_step_enabled);
 
     // If eos_token_id was not provided, take value
     if (m_generation_config.eos_token_id == -1)
@@ -195,6 +218,9 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
     sampling_params.validate();
 
     SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id, input_ids, sampling_params, m_block_size);
+    if (m_stream_detokenizer) {
+        sequence_group->get_generation_stream()->set_detokenizer(m_stream_detokenizer);
+    }
 
     if (m_scheduler->get_config().enable_prefix_caching) {
         m_scheduler->restore_cached_blocks(sequence_group);
@@ -215,7 +241,7 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
     ov::Tensor inputs;
     ov::genai::VLMPerfMetrics metrics;
     if (m_model_input_type == ModelInputType::TOKENS) {
-        static ManualTimer timer("tokenize");
+        static thread_local ManualTimer timer("tokenize");
         timer.start();
         inputs = m_tokenizer.encode(prompt).input_ids;
         timer.end();
@@ -235,24 +261,34 @@ bool ContinuousBatchingPipeline::ContinuousBatchingImpl::has_non_finished_reques
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
-    static ManualTimer step_timer("step()");
+    static thread_local ManualTimer step_timer("step()");
     step_timer.start();
+    if (m_step_tracer) {
+        m_step_tracer->begin_step();
+    }
+    StepTracer::Span step_span(m_step_tracer.get(), "step");
 
     _pull_awaiting_requests();
 
     Scheduler::Output scheduler_output;
 
     {
-        static ManualTimer scheduling_timer("scheduling");
+        StepTracer::Span span(m_step_tracer.get(), "schedule");
+        static thread_local ManualTimer scheduling_timer("scheduling");
         scheduling_timer.start();
         scheduler_output = m_scheduler->schedule(m_requests);
         scheduling_timer.end();
+        if (m_step_tracer) {
+            step_span.set_batch(_get_batch_composition(scheduler_output));
+        }
 
         m_pipeline_metrics.scheduled_requests = scheduler_output.m_scheduled_sequence_groups_ids.size();
         m_pipeline_metrics.cache_usage = scheduler_output.m_cache_usage;
         m_pipeline_metrics.max_cache_usage = std::max(m_pipeline_metrics.max_cache_usage, scheduler_output.m_cache_usage);
         _register_step_cache_usage(scheduler_output.m_cache_usage);
         m_pipeline_metrics.avg_cache_usage = _get_current_running_average_cache_usage();
+        m_pipeline_metrics.forecast_cache_usage = scheduler_output.m_forecast_cache_usage;
+        m_pipeline_metrics.deferred_requests = scheduler_output.m_num_deferred_sequence_groups;
 
         const auto& sched_config = m_scheduler->get_config();
         if (sched_config.use_cache_eviction && sched_config.cache_eviction_config.apply_rotation) {
@@ -272,18 +308,38 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
                 sequence_group->notify_handle();
             }
         }
+        m_requests_to_postprocess.clear();
+        m_pending_stop_string_matches.clear();
         _free_non_running_requests();
+        if (m_stream_detokenizer) {
+            m_stream_detokenizer->flush();
+        }
         return;
     }
     ov::Tensor logits;
 
     {
-        static ManualTimer timer("forward");
+        StepTracer::Span span(m_step_tracer.get(), "forward");
+        static thread_local ManualTimer timer("forward");
         const auto infer_start = std::chrono::steady_clock::now();
         timer.start();
-        logits = m_model_runner->forward(m_requests, scheduler_output);
+        if (m_is_async_step_enabled) {
+            m_model_runner->forward_async(m_requests, scheduler_output);
+            // post-processing runs on the step thread while the inference is in flight, so its span is nested in "forward"
+            try {
+                _postprocess_previous_step();
+            } catch (...) {
+                // infer request must not be in flight when exception leaves the step
+                m_model_runner->get_infer_request().wait();
+                throw;
+            }
+            logits = m_model_runner->wait_forward(m_requests, scheduler_output);
+        } else {
+            logits = m_model_runner->forward(m_requests, scheduler_output);
+        }
         const auto infer_end = std::chrono::steady_clock::now();
         m_pipeline_metrics.inference_duration = PerfMetrics::get_microsec(infer_end - infer_start);
+        m_scheduler->register_inference_time(scheduler_output.m_total_num_scheduled_tokens, m_pipeline_metrics.inference_duration);
         timer.end();
     }
 
@@ -295,6 +351,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     // evict unimportant blocks from KV cache, if requested
     const auto& sched_config = m_scheduler->get_config();
     if (sched_config.use_cache_eviction) {
+        StepTracer::Span span(m_step_tracer.get(), "evict cache blocks");
         _maybe_evict_cache_blocks(sched_config);
     }
 
@@ -309,16 +366,23 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     SamplerOutput sampler_output;
     {
-        static ManualTimer timer("sample");
+        StepTracer::Span span(m_step_tracer.get(), "sample");
+        static thread_local ManualTimer timer("sample");
         timer.start();
         sampler_output = m_sampler->sample(m_requests, logits, m_is_validation_mode_enabled);
         m_batch_size = sampler_output.num_generated_tokens;
         timer.end();
     }
 
+    if (m_is_async_step_enabled) {
+        StepTracer::Span span(m_step_tracer.get(), "finalize sampled requests");
+        _finalize_sampled_requests(scheduler_output, sampler_output);
+    }
+
     // process sampler_output (e.g. fork or drop sequences from BlockScheduler)
     {
-        static ManualTimer free_fork_timer("fork / free sequence");
+        StepTracer::Span span(m_step_tracer.get(), "fork / free sequence");
+        static thread_local ManualTimer free_fork_timer("fork / free sequence");
         free_fork_timer.start();
 
         for (const auto& pair : sampler_output.m_forked_sequences) {
@@ -340,7 +404,8 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     // notify requests dropped by handle
     {
-        static ManualTimer report_tokens_timer("notify requests dropped by handle");
+        StepTracer::Span span(m_step_tracer.get(), "notify requests dropped by handle");
+        static thread_local ManualTimer report_tokens_timer("notify requests dropped by handle");
         report_tokens_timer.start();
         _notify_requests_dropped_by_handle();
         report_tokens_timer.end();
@@ -349,15 +414,45 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     // free non running requests for current step
 
     {
-        static ManualTimer clean_up_requests_timer("free non running requests");
+        StepTracer::Span span(m_step_tracer.get(), "free non running requests");
+        static thread_local ManualTimer clean_up_requests_timer("free non running requests");
         clean_up_requests_timer.start();
         _free_non_running_requests();
         clean_up_requests_timer.end();
     }
 
+    // outputs pushed during the step are decoded in one batch while the next step runs
+    if (m_stream_detokenizer) {
+        StepTracer::Span span(m_step_tracer.get(), "stream");
+        m_stream_detokenizer->flush();
+    }
+
     step_timer.end();
 }
 
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::dump_trace(const std::filesystem::path& path) const {
+    OPENVINO_ASSERT(m_step_tracer, "Step tracing is not enabled, set ", StepTracer::ENVIRONMENT_VARIABLE_NAME,
+                    " environment variable or step_trace_capacity property to enable it");
+    m_step_tracer->dump(path);
+}
+
+StepTracer::BatchComposition
+ContinuousBatchingPipeline::ContinuousBatchingImpl::_get_batch_composition(const Scheduler::Output& scheduler_output) const {
+    StepTracer::BatchComposition batch;
+    batch.num_scheduled_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
+    batch.cache_usage = scheduler_output.m_cache_usage;
+    for (uint64_t sequence_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+        const SequenceGroup::Ptr& sequence_group = m_requests[sequence_group_id];
+        const size_t num_tokens = sequence_group->get_num_scheduled_tokens() * sequence_group->num_running_seqs();
+        if (sequence_group->can_generate_tokens()) {
+            batch.num_decode_tokens += num_tokens;
+        } else {
+            batch.num_prompt_tokens += num_tokens;
+        }
+    }
+    return batch;
+}
+
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::set_adapters(const std::optional<AdapterConfig>& adapters) {
     if (m_adapter_controller) {
         m_adapter_controller->apply(m_model_runner->get_infer_request(), adapters);
@@ -387,7 +482,7 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::generate(const std::vector<o
     }
     set_adapters(sampling_params[0].adapters);
 
-    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer);
+    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer, m_is_stream_detokenization_enabled);
 
     OPENVINO_ASSERT(!streamer_ptr->has_callback() || input_ids.size() == 1 && sampling_params[0].num_return_sequences == 1 &&
         (sampling_params[0].is_greedy_decoding() || sampling_params[0].is_multinomial()),
@@ -485,6 +580,9 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_free_non_running_reque
                     m_scheduler->free_sequence(sequence->get_id());
                 }
             }
+            for (const auto& sequence: request->get_sequences()) {
+                m_seq_group_id_to_cache_eviction_algo_map.erase(sequence->get_id());
+            }
             m_sampler->clear_request_info(request->get_request_id());
             requests_iterator = m_requests.erase(requests_iterator);
         } else {
@@ -502,6 +600,63 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_notify_requests_droppe
     }
 }
 
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_postprocess_previous_step() {
+    StepTracer::Span span(m_step_tracer.get(), "postprocess previous step");
+    static thread_local ManualTimer timer("postprocess previous step");
+    timer.start();
+
+    std::vector<SequenceGroup::Ptr> requests_to_postprocess;
+    requests_to_postprocess.reserve(m_requests_to_postprocess.size());
+    for (const auto& request : m_requests_to_postprocess) {
+        // requests stopped or cancelled by handle can already be freed
+        if (!request->has_finished() && !request->handle_stopped() && !request->handle_cancelled())
+            requests_to_postprocess.push_back(request);
+    }
+    m_requests_to_postprocess.clear();
+
+    m_pending_stop_string_matches = m_sampler->match_stop_strings(requests_to_postprocess);
+
+    // streaming is safe before the matches are applied, since the last tokens which can
+    // form a stop string are held back by the stream window of a sequence group
+    for (const auto& request : requests_to_postprocess) {
+        request->notify_handle();
+    }
+
+    timer.end();
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_finalize_sampled_requests(const Scheduler::Output& scheduler_output,
+                                                                                     SamplerOutput& sampler_output) {
+    std::vector<SequenceGroup::Ptr> sampled_requests;
+    for (size_t seq_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+        sampled_requests.push_back(m_requests[seq_group_id]);
+    }
+
+    // requests with matched stop strings could be not scheduled at the current step
+    for (const auto& match : m_pending_stop_string_matches) {
+        SequenceGroup::Ptr sequence_group = match.m_sequence->get_sequence_group_ptr();
+        if (std::find(sampled_requests.begin(), sampled_requests.end(), sequence_group) == sampled_requests.end()) {
+            sampled_requests.push_back(sequence_group);
+        }
+    }
+
+    for (auto seq_id : m_sampler->apply_stop_string_matches(m_pending_stop_string_matches)) {
+        // sequence can be fully preempted at the current step
+        if (m_scheduler->has_block_table(seq_id))
+            sampler_output.m_dropped_sequences.push_back(seq_id);
+    }
+    m_pending_stop_string_matches.clear();
+
+    for (const auto& request : sampled_requests) {
+        if (request->has_finished()) {
+            // finished requests are freed at the end of current step, so notify them right away
+            request->notify_handle();
+        } else {
+            m_requests_to_postprocess.push_back(request);
+        }
+    }
+}
+
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_register_step_cache_usage(float step_cache_usage) {
     if (m_previous_step_cache_usages.size() >= AVG_CACHE_USAGE_WINDOW_SIZE_IN_STEPS) {
         m_previous_step_cache_usages.pop_front();
@@ -529,6 +684,8 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests() {
         m_sampler->clear_request_info(request->get_request_id());
     }
     m_requests.clear();
+    m_requests_to_postprocess.clear();
+    m_pending_stop_string_matches.clear();
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_compute_cache_rotation_data(const std::vector<SequenceGroup::Ptr>& sequence_groups,
@@ -613,39 +770,84 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_maybe_evict_cache_bloc
     m_previous_evicted_block_logical_indices_per_sequence.clear();
     m_previous_num_blocks_before_eviction_per_sequence.clear();
 
-    for (auto& seq_id_and_attention_scores : sequence_attention_scores) {
-        auto seq_id = seq_id_and_attention_scores.first;
-        const auto& attention_scores_for_all_decoder_layers = seq_id_and_attention_scores.second;
-        if (m_seq_group_id_to_cache_eviction_algo_map.find(seq_id) == m_seq_group_id_to_cache_eviction_algo_map.end()) {
-            m_seq_group_id_to_cache_eviction_algo_map[seq_id] = CacheEvictionAlgorithm(sched_config.cache_eviction_config, m_block_size, num_decoder_layers);
+    std::unordered_map<uint64_t, SequenceGroup::Ptr> seq_id_to_seq_group;
+    for (const auto& seq_group_ptr : m_requests) {
+        for (const auto& sequence : seq_group_ptr->get_sequences()) {
+            seq_id_to_seq_group.emplace(sequence->get_id(), seq_group_ptr);
         }
-        auto& cache_eviction_algo = m_seq_group_id_to_cache_eviction_algo_map[seq_id];
-        cache_eviction_algo.register_new_token_scores(attention_scores_for_all_decoder_layers);
+    }
 
-        auto seq_group_ptr_it = std::find_if(m_requests.begin(), m_requests.end(), [seq_id](const SequenceGroup::Ptr& val) { return val->has_sequence_with_id(seq_id); });
-        OPENVINO_ASSERT(seq_group_ptr_it != m_requests.end(), "could not find sequence group with sequence ", seq_id);
-        auto seq_group_ptr = *seq_group_ptr_it;
+    struct EvictionTask {
+        size_t seq_id;
+        SequenceGroup::Ptr seq_group_ptr;
+        CacheEvictionAlgorithm* cache_eviction_algo;
+        const AttentionScoresForEachDecoderLayer* attention_scores_for_all_decoder_layers;
+        bool is_resetting_scores;
+        bool is_evicting;
+        std::vector<std::set<size_t>> logical_blocks_to_evict;
+    };
+    const auto& eviction_config = sched_config.cache_eviction_config;
+    std::vector<EvictionTask> tasks;
+    tasks.reserve(sequence_attention_scores.size());
+    for (const auto& [seq_id, attention_scores_for_all_decoder_layers] : sequence_attention_scores) {
+        auto cache_eviction_algo_it = m_seq_group_id_to_cache_eviction_algo_map.find(seq_id);
+        if (cache_eviction_algo_it == m_seq_group_id_to_cache_eviction_algo_map.end()) {
+            cache_eviction_algo_it = m_seq_group_id_to_cache_eviction_algo_map.emplace(seq_id,
+                CacheEvictionAlgorithm(sched_config.cache_eviction_config, m_block_size, num_decoder_layers)).first;
+        }
 
-         if (!seq_group_ptr->can_generate_tokens()) {
-             // do not evict during prefill
-             continue;
-         }
+        auto seq_group_ptr_it = seq_id_to_seq_group.find(seq_id);
+        OPENVINO_ASSERT(seq_group_ptr_it != seq_id_to_seq_group.end(), "could not find sequence group with sequence ", seq_id);
+        auto seq_group_ptr = seq_group_ptr_it->second;
+
+        // the scheduler processes the observation window at the end of the prompt as a separate chunk, its scores
+        // replace the ones of the preceding chunks and select the blocks kept once the prompt is processed
+        bool is_prompt_chunk = !seq_group_ptr->can_generate_tokens();
+        size_t prompt_len = seq_group_ptr->get_prompt_len();
+        bool has_snapkv_window = eviction_config.snapkv_window_size > 0 && prompt_len > eviction_config.snapkv_window_size;
+        size_t num_processed_tokens = seq_group_ptr->get_num_processed_tokens();
+        bool is_resetting_scores = is_prompt_chunk && has_snapkv_window &&
+                                   num_processed_tokens == prompt_len - eviction_config.snapkv_window_size;
+        bool is_prompt_processed = num_processed_tokens + seq_group_ptr->get_num_scheduled_tokens() >= prompt_len;
+
+        // during prefill blocks are only evicted if prompt compression is requested or the observation window is processed
+        bool is_evicting = !is_prompt_chunk || eviction_config.evict_during_prefill || (has_snapkv_window && is_prompt_processed);
+        tasks.push_back(EvictionTask{seq_id, seq_group_ptr, &cache_eviction_algo_it->second, &attention_scores_for_all_decoder_layers,
+                                     is_resetting_scores, is_evicting, std::vector<std::set<size_t>>(num_decoder_layers)});
+    }
+
+    // algorithms keep independent state for every sequence and decoder layer
+    m_cache_eviction_thread_pool->parallel_for(tasks.size() * num_decoder_layers, [&tasks, num_decoder_layers](size_t index) {
+        EvictionTask& task = tasks[index / num_decoder_layers];
+        size_t decoder_layer_idx = index % num_decoder_layers;
+        if (task.is_resetting_scores) {
+            task.cache_eviction_algo->reset_scores(decoder_layer_idx);
+        }
+        task.cache_eviction_algo->register_new_token_scores((*task.attention_scores_for_all_decoder_layers)[decoder_layer_idx], decoder_layer_idx);
+        if (task.is_evicting) {
+            task.logical_blocks_to_evict[decoder_layer_idx] = task.cache_eviction_algo->evict_logical_blocks(decoder_layer_idx);
+        }
+    });
 
-        m_previous_num_blocks_before_eviction_per_sequence[seq_id] = seq_group_ptr->get_num_logical_blocks();
+    for (auto& task : tasks) {
+        if (!task.is_evicting) {
+            continue;
+        }
+        auto seq_id = task.seq_id;
+        auto seq_group_ptr = task.seq_group_ptr;
 
-        auto logical_blocks_to_evict = cache_eviction_algo.evict_logical_blocks();
-        m_previous_evicted_block_logical_indices_per_sequence[seq_id] = logical_blocks_to_evict;
+        m_previous_num_blocks_before_eviction_per_sequence[seq_id] = seq_group_ptr->get_num_logical_blocks();
 
-        m_scheduler->free_blocks_from_sequence(seq_id, logical_blocks_to_evict);
+        m_scheduler->free_blocks_from_sequence(seq_id, task.logical_blocks_to_evict);
 
-        size_t num_blocks_evicted = logical_blocks_to_evict[0].size();
+        size_t num_blocks_evicted = task.logical_blocks_to_evict[0].size();
+        m_previous_evicted_block_logical_indices_per_sequence[seq_id] = std::move(task.logical_blocks_to_evict);
 
         if (seq_group_to_num_blocks_evicted_map.find(seq_group_ptr) != seq_group_to_num_blocks_evicted_map.end()) {
             OPENVINO_ASSERT(seq_group_to_num_blocks_evicted_map[seq_group_ptr] == num_blocks_evicted, "internal error - each sequence in the same group must have the same number of blocks evicted");
         } else {
             seq_group_to_num_blocks_evicted_map[seq_group_ptr] = num_blocks_evicted;
         }
-
     }
 
     for (const auto& seq_group_ptr_and_num_blocks_evicted : seq_group_to_num_blocks_evicted_map) {
@@ -7,6 +7,8 @@
 
 #include "openvino/genai/lora_adapter.hpp"
 #include "continuous_batching/cache_eviction.hpp"
+#include "continuous_batching/step_tracer.hpp"
+#include "sampling/threadpool.hpp"
 #include "visual_language/inputs_embedder.hpp"
 
 namespace ov::genai {
@@ -26,6 +28,8 @@ protected:
     std::mutex m_awaiting_requests_mutex;
 
     std::map<size_t, CacheEvictionAlgorithm> m_seq_group_id_to_cache_eviction_algo_map;
+    // runs cache eviction for every sequence and decoder layer in parallel, created only if cache eviction is used
+    std::unique_ptr<ThreadPool> m_cache_eviction_thread_pool;
 
     static const size_t AVG_CACHE_USAGE_WINDOW_SIZE_IN_STEPS = 1000;
     std::deque<float> m_previous_step_cache_usages;
@@ -37,6 +41,19 @@ protected:
     // flag to enable validation mode for sampler
     bool m_is_validation_mode_enabled = false;
 
+    // flag to overlap model inference of the current step with post-processing of the previous one
+    bool m_is_async_step_enabled = false;
+    // sampled requests, whose stop strings matching and streaming are deferred until the next model inference is started
+    std::vector<SequenceGroup::Ptr> m_requests_to_postprocess;
+    // stop strings matched while the model inference was in flight, to be applied after sampling
+    std::vector<StopStringMatch> m_pending_stop_string_matches;
+
+    // records spans of steps if tracing is enabled by the environment variable or the step_trace_capacity property
+    std::shared_ptr<StepTracer> m_step_tracer;
+    // whether the environment variable enables step tracing, it's off for the draft pipeline of speculative decoding,
+    // which would otherwise write its trace to the same file as the main pipeline
+    bool m_is_step_tracing_from_env_enabled = true;
+
     size_t m_num_decoder_layers = 0;
     size_t m_block_size = 0;
 
@@ -90,9 +107,23 @@ protected:
      */
     void _maybe_evict_cache_blocks(const SchedulerConfig& sched_config);
 
+    /**
+     * Matches stop strings and streams tokens of the requests sampled at the previous step.
+     * Called in async step mode while the model inference of the current step is in flight
+     */
+    void _postprocess_previous_step();
+
+    /**
+     * Applies stop strings matched by _postprocess_previous_step, notifies handles of finished requests
+     * and defers the post-processing of the remaining ones to the next step. Called in async step mode after sampling.
+     * The requests with matched stop strings have already been through the current step, its tokens are dropped here
+     */
+    void _finalize_sampled_requests(const Scheduler::Output& scheduler_output, SamplerOutput& sampler_output);
+
     void _register_step_cache_usage(float step_cache_usage);
     void _reset_cache_usage_statistics();
     float _get_current_running_average_cache_usage() const;
+    StepTracer::BatchComposition _get_batch_composition(const Scheduler::Output& scheduler_output) const;
     void _compute_cache_rotation_data(const std::vector<SequenceGroup::Ptr>& sequence_groups, const Scheduler::Output& scheduler_output);
 
     virtual void drop_requests();
@@ -129,6 +160,8 @@ public:
 
     void step() override;
 
+    void dump_trace(const std::filesystem::path& path) const override;
+
     std::vector<EncodedGenerationResult>
     generate(const std::vector<ov::Tensor>& input_ids,
              const std::vector<GenerationConfig>& sampling_params,
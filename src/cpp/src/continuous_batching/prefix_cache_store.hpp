@@ -0,0 +1,327 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Second (host-side) tier of the prefix cache. Keeps contents of KV cache blocks that were evicted from the
+ * in-memory prefix cache as separate files in a directory, keyed by the same prefix hash as used by the
+ * `OverwritableBlocksHashStore`. The directory is scanned at construction, so that the blocks spilled by a
+ * previous pipeline instance can be reused after a restart. The total size of the stored blocks is capped, least
+ * recently used blocks are removed from disk first.
+ * Files are written by a background thread, so that storing a block only copies its contents to memory. A block which
+ * is being written can already be loaded.
+ * The block contents are treated as opaque byte buffers - layout is defined by the CacheManager.
+ */
+class PersistentPrefixCacheStore {
+    static constexpr uint64_t FILE_MAGIC = 0x4b56424c4f434b32;  // "KVBLOCK2"
+    static constexpr const char* FILE_EXTENSION = ".kvblock";
+    // blocks waiting to be written are dropped beyond this size, so that a slow disk doesn't use up the host memory
+    static constexpr size_t MAX_PENDING_WRITES_SIZE_IN_BYTES = 256 * 1024 * 1024;
+
+    struct FileHeader {
+        uint64_t magic;
+        uint64_t layout_id;
+        uint64_t hash;
+        uint64_t payload_size;
+        uint64_t checksum;
+    };
+
+    struct Entry {
+        size_t payload_size;
+        std::list<uint64_t>::iterator lru_position;
+    };
+
+    std::filesystem::path m_directory;
+    size_t m_max_size_in_bytes;
+    size_t m_block_size_in_bytes;
+    uint64_t m_layout_id;
+    size_t m_used_size_in_bytes = 0;
+
+    std::map<uint64_t, Entry> m_entries;
+    // hashes of stored blocks, least recently used first
+    std::list<uint64_t> m_lru;
+
+    // blocks to be written by the writer thread, kept until they are written
+    std::map<uint64_t, std::vector<uint8_t>> m_pending_writes;
+    std::deque<uint64_t> m_write_queue;
+    bool m_is_writing = false;
+    bool m_stop_writer = false;
+    std::mutex m_mutex;
+    std::condition_variable m_writer_cv;
+    std::condition_variable m_flush_cv;
+    std::thread m_writer;
+
+    static uint64_t _get_checksum(const std::vector<uint8_t>& data) {
+        // FNV-1a over 64-bit words, the tail is zero padded
+        uint64_t checksum = 0xcbf29ce484222325;
+        for (size_t offset = 0; offset < data.size(); offset += sizeof(uint64_t)) {
+            uint64_t word = 0;
+            std::memcpy(&word, data.data() + offset, std::min(sizeof(uint64_t), data.size() - offset));
+            checksum = (checksum ^ word) * 0x100000001b3;
+        }
+        return checksum;
+    }
+
+    std::filesystem::path _get_block_path(uint64_t hash) const {
+        std::stringstream ss;
+        ss << std::hex << hash << FILE_EXTENSION;
+        return m_directory / ss.str();
+    }
+
+    void _register(uint64_t hash, size_t payload_size) {
+        m_lru.push_back(hash);
+        m_entries[hash] = Entry{payload_size, std::prev(m_lru.end())};
+        m_used_size_in_bytes += payload_size;
+    }
+
+    void _discard(uint64_t hash) {
+        auto it = m_entries.find(hash);
+        if (it == m_entries.end()) {
+            return;
+        }
+        m_used_size_in_bytes -= it->second.payload_size;
+        m_lru.erase(it->second.lru_position);
+        m_entries.erase(it);
+        std::error_code ec;
+        std::filesystem::remove(_get_block_path(hash), ec);
+    }
+
+    void _touch(const Entry& entry) {
+        m_lru.splice(m_lru.end(), m_lru, entry.lru_position);
+    }
+
+    void _load_index() {
+        for (const auto& dir_entry : std::filesystem::directory_iterator(m_directory)) {
+            if (!dir_entry.is_regular_file() || dir_entry.path().extension() != FILE_EXTENSION) {
+                continue;
+            }
+            std::ifstream file(dir_entry.path(), std::ios::binary);
+            FileHeader header;
+            bool is_valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+                            header.magic == FILE_MAGIC && header.layout_id == m_layout_id &&
+                            header.payload_size == m_block_size_in_bytes &&
+                            dir_entry.file_size() == sizeof(header) + header.payload_size &&
+                            dir_entry.path() == _get_block_path(header.hash);
+            file.close();
+            if (!is_valid) {
+                // written by a pipeline with another KV cache layout, or partially written
+                std::error_code ec;
+                std::filesystem::remove(dir_entry.path(), ec);
+                continue;
+            }
+            _register(header.hash, header.payload_size);
+        }
+        _shrink_to_fit(0);
+    }
+
+    void _shrink_to_fit(size_t size_to_add) {
+        while (m_max_size_in_bytes != 0 && !m_lru.empty() && m_used_size_in_bytes + size_to_add > m_max_size_in_bytes) {
+            _discard(m_lru.front());
+        }
+    }
+
+    bool _write_file(uint64_t hash, const std::vector<uint8_t>& data) const {
+        auto path = _get_block_path(hash);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        FileHeader header{FILE_MAGIC, m_layout_id, hash, data.size(), _get_checksum(data)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.close();
+        if (!file) {
+            // e.g. out of disk space - the block is simply not cached
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool _read_file(uint64_t hash, std::vector<uint8_t>& data) const {
+        std::ifstream file(_get_block_path(hash), std::ios::binary);
+        FileHeader header;
+        data.resize(m_block_size_in_bytes);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+               header.magic == FILE_MAGIC && header.layout_id == m_layout_id && header.hash == hash &&
+               header.payload_size == data.size() &&
+               static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), data.size())) &&
+               header.checksum == _get_checksum(data);
+    }
+
+    void _run_writer() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_writer_cv.wait(lock, [this] { return m_stop_writer || !m_write_queue.empty(); });
+            if (m_write_queue.empty()) {
+                return;
+            }
+            const uint64_t hash = m_write_queue.front();
+            m_write_queue.pop_front();
+            const std::vector<uint8_t>& data = m_pending_writes.at(hash);
+            _shrink_to_fit(data.size());
+            m_is_writing = true;
+
+            // contents of a pending write are not modified until it's erased by this thread
+            lock.unlock();
+            const bool is_written = _write_file(hash, data);
+            lock.lock();
+
+            if (is_written) {
+                _register(hash, data.size());
+            }
+            m_pending_writes.erase(hash);
+            m_is_writing = false;
+            m_flush_cv.notify_all();
+        }
+    }
+
+public:
+    /**
+     * Constructs the PersistentPrefixCacheStore and registers the blocks already stored in the directory.
+     * @param directory The directory to store the block files in. Created if it does not exist.
+     * @param block_size_in_bytes The size of the contents of one block (across all layers, both for keys and values).
+     * Files with a different payload size are considered stale and are removed.
+     * @param max_size_in_bytes The maximum total size of the stored blocks. 0 means unlimited.
+     * @param layout_id Identifier of the block contents layout, e.g. as returned by `CacheManager::get_block_layout_id`.
+     * Files with a different layout identifier are considered stale and are removed.
+     */
+    PersistentPrefixCacheStore(const std::filesystem::path& directory, size_t block_size_in_bytes, size_t max_size_in_bytes = 0, uint64_t layout_id = 0) :
+        m_directory(directory), m_max_size_in_bytes(max_size_in_bytes), m_block_size_in_bytes(block_size_in_bytes), m_layout_id(layout_id) {
+        OPENVINO_ASSERT(block_size_in_bytes != 0, "block_size_in_bytes must be non-zero");
+        std::filesystem::create_directories(m_directory);
+        OPENVINO_ASSERT(std::filesystem::is_directory(m_directory), "Prefix cache path ", m_directory, " is not a directory");
+        _load_index();
+        m_writer = std::thread([this] { _run_writer(); });
+    }
+
+    /**
+     * Writes the pending blocks, so that they are found by the next instance.
+     */
+    ~PersistentPrefixCacheStore() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop_writer = true;
+        }
+        m_writer_cv.notify_one();
+        m_writer.join();
+    }
+
+    PersistentPrefixCacheStore(const PersistentPrefixCacheStore&) = delete;
+    PersistentPrefixCacheStore& operator=(const PersistentPrefixCacheStore&) = delete;
+
+    /**
+     * @param hash The prefix hash of a block.
+     * @return Whether the contents of the block with this hash are stored or being written.
+     */
+    bool contains(uint64_t hash) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.count(hash) > 0 || m_pending_writes.count(hash) > 0;
+    }
+
+    /**
+     * Schedules writing of the contents of a block, least recently used blocks are removed when it's written if the
+     * size limit is exceeded. If a block with the same hash is already stored, it is only marked as recently used.
+     * The block is dropped if too many blocks are waiting to be written.
+     * @param hash The prefix hash of the block.
+     * @param data The block contents, must be of the size passed at construction.
+     */
+    void store(uint64_t hash, std::vector<uint8_t> data) {
+        OPENVINO_ASSERT(data.size() == m_block_size_in_bytes, "Expected block contents of ", m_block_size_in_bytes, " bytes, got ", data.size());
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(hash);
+        if (it != m_entries.end()) {
+            _touch(it->second);
+            return;
+        }
+        if (m_pending_writes.count(hash) > 0 || (m_max_size_in_bytes != 0 && data.size() > m_max_size_in_bytes)) {
+            return;
+        }
+        const size_t pending_writes_size = m_pending_writes.size() * m_block_size_in_bytes;
+        if (!m_pending_writes.empty() && pending_writes_size + data.size() > MAX_PENDING_WRITES_SIZE_IN_BYTES) {
+            return;
+        }
+        m_pending_writes.emplace(hash, std::move(data));
+        m_write_queue.push_back(hash);
+        m_writer_cv.notify_one();
+    }
+
+    /**
+     * Reads the contents of a stored block and marks it as recently used.
+     * @param hash The prefix hash of the block.
+     * @param data The buffer to read the block contents into.
+     * @return Whether the block was read successfully. A block which cannot be read, or whose contents don't match the
+     * checksum, is removed from the store.
+     */
+    bool load(uint64_t hash, std::vector<uint8_t>& data) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto pending_it = m_pending_writes.find(hash);
+            if (pending_it != m_pending_writes.end()) {
+                data = pending_it->second;
+                return true;
+            }
+            if (m_entries.count(hash) == 0) {
+                return false;
+            }
+        }
+        // the file is read without the lock, it may be removed by the writer meanwhile, which makes the read fail
+        const bool is_read = _read_file(hash, data);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!is_read) {
+            _discard(hash);
+            data.clear();
+            return false;
+        }
+        auto it = m_entries.find(hash);
+        if (it != m_entries.end()) {
+            _touch(it->second);
+        }
+        return true;
+    }
+
+    /**
+     * Waits until the pending blocks are written.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_flush_cv.wait(lock, [this] { return m_write_queue.empty() && !m_is_writing; });
+    }
+
+    /**
+     * @return Number of blocks currently written to the store.
+     */
+    size_t num_blocks() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    /**
+     * @return Total size in bytes of the blocks currently written to the store.
+     */
+    size_t get_used_size_in_bytes() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_used_size_in_bytes;
+    }
+};
+
+}
@@ -0,0 +1,81 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "continuous_batching/reserved_host_memory.hpp"
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+namespace {
+size_t get_page_size() {
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwPageSize;
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t align_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+ReservedHostMemory::ReservedHostMemory(size_t capacity) : m_capacity(align_up(capacity, get_page_size())) {
+    OPENVINO_ASSERT(capacity != 0, "capacity must be non-zero");
+#ifdef _WIN32
+    m_data = VirtualAlloc(nullptr, m_capacity, MEM_RESERVE, PAGE_NOACCESS);
+    OPENVINO_ASSERT(m_data != nullptr, "Failed to reserve ", m_capacity, " bytes of address space");
+#else
+    m_data = mmap(nullptr, m_capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    OPENVINO_ASSERT(m_data != MAP_FAILED, "Failed to reserve ", m_capacity, " bytes of address space");
+#endif
+}
+
+ReservedHostMemory::~ReservedHostMemory() {
+#ifdef _WIN32
+    VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    munmap(m_data, m_capacity);
+#endif
+}
+
+void ReservedHostMemory::commit(size_t size) {
+    OPENVINO_ASSERT(size <= m_capacity, "Cannot commit ", size, " bytes, reserved capacity is ", m_capacity, " bytes");
+    if (size <= m_committed_size) {
+        return;
+    }
+    size_t new_committed_size = align_up(size, get_page_size());
+    char* commit_begin = static_cast<char*>(m_data) + m_committed_size;
+    size_t commit_size = new_committed_size - m_committed_size;
+#ifdef _WIN32
+    OPENVINO_ASSERT(VirtualAlloc(commit_begin, commit_size, MEM_COMMIT, PAGE_READWRITE) != nullptr,
+                    "Failed to commit ", commit_size, " bytes of memory");
+#else
+    OPENVINO_ASSERT(mprotect(commit_begin, commit_size, PROT_READ | PROT_WRITE) == 0,
+                    "Failed to commit ", commit_size, " bytes of memory");
+#endif
+    m_committed_size = new_committed_size;
+}
+
+size_t ReservedHostMemory::get_total_physical_memory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX memory_status;
+    memory_status.dwLength = sizeof(memory_status);
+    GlobalMemoryStatusEx(&memory_status);
+    return static_cast<size_t>(memory_status.ullTotalPhys);
+#else
+    return static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * get_page_size();
+#endif
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,56 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+namespace ov::genai {
+
+/**
+ * @brief A range of virtual address space reserved up front, with physical memory committed on demand from its beginning.
+ * Allows a host buffer to grow in place, without reallocation and copying of the already stored data.
+ */
+class ReservedHostMemory {
+    void* m_data = nullptr;
+    size_t m_capacity = 0;
+    size_t m_committed_size = 0;
+
+public:
+    /**
+     * Reserves address space without committing any physical memory.
+     * @param capacity The size in bytes of the address space to reserve. The buffer can not grow beyond this size.
+     */
+    explicit ReservedHostMemory(size_t capacity);
+
+    ~ReservedHostMemory();
+
+    ReservedHostMemory(const ReservedHostMemory&) = delete;
+    ReservedHostMemory& operator=(const ReservedHostMemory&) = delete;
+
+    /**
+     * Commits physical memory so that at least `size` bytes from the beginning of the reserved range are accessible.
+     * Already committed memory and its contents are kept intact.
+     * @param size The size in bytes to be accessible, must not exceed the capacity.
+     */
+    void commit(size_t size);
+
+    void* data() const {
+        return m_data;
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+    size_t committed_size() const {
+        return m_committed_size;
+    }
+
+    /**
+     * @return Total size in bytes of the physical memory of the host.
+     */
+    static size_t get_total_physical_memory();
+};
+
+}
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "openvino/runtime/intel_gpu/properties.hpp"
@@ -12,6 +15,8 @@
 #include "continuous_batching/block_manager.hpp"
 #include "sequence_group.hpp"
 #include "continuous_batching/cache_manager.hpp"
+#include "continuous_batching/scheduling_policy.hpp"
+#include "continuous_batching/step_tracer.hpp"
 #include "continuous_batching/timer.hpp"
 #include "utils.hpp"
 
@@ -21,6 +26,7 @@ class Scheduler {
 
     SchedulerConfig m_config;
     std::shared_ptr<BlockManager> m_block_manager;
+    ISchedulingPolicy::Ptr m_scheduling_policy;
     friend class CacheStateDumper;
 
     bool m_dynamic_memory_allocation = false;
@@ -30,6 +36,27 @@ class Scheduler {
     const float m_cache_growth_factor = 2; // commmon values 1.5 or 2
 
     std::shared_ptr<CacheManager> m_cache_manager;
+
+    // records spans of the KV cache transfers if step tracing is enabled
+    std::shared_ptr<StepTracer> m_step_tracer;
+
+    // Preemption cost estimates, used to choose between preemption by swapping and by recompute:
+    // running averages of the model inference duration and the number of tokens processed by it,
+    // and the speed of the transfers between the KV cache and the swap pool
+    float m_avg_inference_time_us = 0.0f;
+    float m_avg_inference_num_tokens = 0.0f;
+    float m_swap_bytes_per_us = 1000.0f; // 1 GB/s until measured
+    static constexpr float PREEMPTION_COST_SMOOTHING_FACTOR = 0.1f;
+
+    // Admission control: sequence groups allowed to be scheduled and their forecast KV cache demand in blocks, by request id
+    struct AdmittedSequenceGroup {
+        SequenceGroup::Ptr sequence_group;
+        size_t num_forecast_blocks;
+    };
+    std::unordered_map<uint64_t, AdmittedSequenceGroup> m_admitted_sequence_groups;
+    // running average of the output lengths of finished requests, 0 until a request finishes
+    float m_avg_output_len = 0.0f;
+    static constexpr float OUTPUT_LEN_SMOOTHING_FACTOR = 0.1f;
 public:
     struct Output {
         // IDs of scheduled groups
@@ -42,6 +69,10 @@ public:
         bool is_prompt = false;
         // current cache usage
         float m_cache_usage = 0.0;
+        // percentage of KV cache reserved by admission control for the admitted sequence groups
+        float m_forecast_cache_usage = 0.0;
+        // number of sequence groups not admitted for scheduling
+        size_t m_num_deferred_sequence_groups = 0;
     };
 
     Scheduler(size_t block_size, std::shared_ptr<CacheManager> cache_manager, const SchedulerConfig & config = {}, size_t num_layers = 1, bool can_use_partial_preemption = true) :
@@ -49,7 +80,27 @@ public:
         m_can_use_partial_preemption(can_use_partial_preemption),
         m_config(config) {
         m_block_manager = std::make_shared<BlockManager>(m_config.num_kv_blocks, m_config.enable_prefix_caching, block_size, num_layers);
+        m_scheduling_policy = ISchedulingPolicy::create(m_config);
         OPENVINO_ASSERT(num_layers != 0, "num_layers must be non-zero");
+        // blocks are cached by the hash of the prefix they hold, which doesn't match the contents of a prompt evicted from
+        OPENVINO_ASSERT(!(m_config.enable_prefix_caching && m_config.use_cache_eviction && m_config.cache_eviction_config.evict_during_prefill),
+                        "CacheEvictionConfig.evict_during_prefill is not compatible with SchedulerConfig.enable_prefix_caching");
+        // without dynamic split fuse the whole prompt is processed at once, so there are no chunks to evict from or to
+        // take the observation window scores from
+        OPENVINO_ASSERT(m_config.dynamic_split_fuse || !m_config.use_cache_eviction || !m_config.cache_eviction_config.evict_during_prefill,
+                        "CacheEvictionConfig.evict_during_prefill requires SchedulerConfig.dynamic_split_fuse");
+        OPENVINO_ASSERT(m_config.dynamic_split_fuse || !m_config.use_cache_eviction || m_config.cache_eviction_config.snapkv_window_size == 0,
+                        "CacheEvictionConfig.snapkv_window_size requires SchedulerConfig.dynamic_split_fuse");
+        if (m_config.enable_prefix_caching && !m_config.persistent_prefix_cache_dir.empty()) {
+            const size_t max_size_in_bytes = m_config.persistent_prefix_cache_size * 1024 * 1024 * 1024;
+            m_block_manager->set_persistent_prefix_cache(std::make_shared<PersistentPrefixCacheStore>(
+                m_config.persistent_prefix_cache_dir, m_cache_manager->get_block_contents_size(), max_size_in_bytes,
+                m_cache_manager->get_block_layout_id()));
+        }
+        if (m_config.swap_space > 0 && !m_config.enable_prefix_caching && !m_config.use_cache_eviction) {
+            const size_t max_size_in_bytes = m_config.swap_space * 1024 * 1024 * 1024;
+            m_block_manager->set_swap_pool(std::make_shared<BlockSwapPool>(max_size_in_bytes, m_cache_manager->get_block_contents_size()));
+        }
     }
 
     void release() {
@@ -65,10 +116,17 @@ public:
         // free some blocks taken by non-confirmed condidates in SD / prompt look-up
         clean_empty_blocks(sequence_groups);
 
+        // sequence groups are scheduled in the policy order and preempted in the reverse one
+        m_scheduling_policy->order(sequence_groups, std::chrono::steady_clock::now());
+
         if (m_block_manager->get_total_number_of_kv_blocks() == 0) {
             _initialize_cache(sequence_groups);
         }
 
+        if (m_config.enable_admission_control && !m_dynamic_memory_allocation) {
+            _admit_sequence_groups(sequence_groups, scheduler_output);
+        }
+
         if (m_config.dynamic_split_fuse) {
             // deepspeed-mii case
             // generation phase is always scheduled first
@@ -87,14 +145,29 @@ public:
             }
         }
 
+        // ModelRunner lays out the logits in the order of scheduled IDs, while Sampler consumes them in the order
+        // of sequence groups, which doesn't match the scheduling order if the generate phase is scheduled first
+        std::sort(scheduler_output.m_scheduled_sequence_groups_ids.begin(), scheduler_output.m_scheduled_sequence_groups_ids.end());
+
         m_cache_manager->allocate_cache_if_needed(m_block_manager->get_total_number_of_kv_blocks());
         _clear_waiting_sequences(sequence_groups);
         scheduler_output.m_cache_usage = m_block_manager->get_used_percentage();
 
-        static ManualTimer copy_blocks_timer("copy block");
-        copy_blocks_timer.start();
-        m_cache_manager->copy_blocks(block_copy_map);
-        copy_blocks_timer.end();
+        if (m_block_manager->has_swap_pool()) {
+            _transfer_swapped_blocks();
+        }
+
+        if (m_block_manager->has_persistent_prefix_cache()) {
+            _transfer_persistent_prefix_cache_blocks();
+        }
+
+        {
+            StepTracer::Span span(m_step_tracer.get(), "copy blocks");
+            static thread_local ManualTimer copy_blocks_timer("copy block");
+            copy_blocks_timer.start();
+            m_cache_manager->copy_blocks(block_copy_map);
+            copy_blocks_timer.end();
+        }
 
         return scheduler_output;
     }
@@ -120,8 +193,11 @@ public:
         return m_block_manager->get_block_tables(seq_id);
     }
 
+    /**
+     * @return Whether the sequence holds KV cache blocks, including the ones swapped out to the swap pool.
+     */
     const bool has_block_table(uint64_t seq_id) {
-        return m_block_manager->has_block_table(seq_id);
+        return m_block_manager->has_block_table(seq_id) || (m_block_manager->has_swap_pool() && m_block_manager->is_swapped(seq_id));
     }
 
     void free_sequence(uint64_t seq_id) {
@@ -140,6 +216,40 @@ public:
         return m_config;
     }
 
+    /**
+     * Updates the estimate of the time needed to recompute a token, which is used to choose between preemption
+     * by swapping and by recompute.
+     * @param num_tokens The number of tokens processed by a model inference
+     * @param inference_time_us The duration of this inference in microseconds
+     */
+    void register_inference_time(size_t num_tokens, float inference_time_us) {
+        if (num_tokens == 0) {
+            return;
+        }
+        if (m_avg_inference_num_tokens == 0.0f) {
+            m_avg_inference_time_us = inference_time_us;
+            m_avg_inference_num_tokens = num_tokens;
+            return;
+        }
+        // averaging the numerator and the denominator separately lets the prompt inferences, which are close to
+        // the recompute workload, dominate over the generation ones
+        m_avg_inference_time_us += PREEMPTION_COST_SMOOTHING_FACTOR * (inference_time_us - m_avg_inference_time_us);
+        m_avg_inference_num_tokens += PREEMPTION_COST_SMOOTHING_FACTOR * (num_tokens - m_avg_inference_num_tokens);
+    }
+
+    /**
+     * Replaces the scheduling policy created from SchedulerConfig::scheduling_policy
+     * @param scheduling_policy The policy defining the order of sequence groups for scheduling and preemption
+     */
+    void set_scheduling_policy(ISchedulingPolicy::Ptr scheduling_policy) {
+        OPENVINO_ASSERT(scheduling_policy, "Scheduling policy must not be null");
+        m_scheduling_policy = std::move(scheduling_policy);
+    }
+
+    void set_step_tracer(std::shared_ptr<StepTracer> step_tracer) {
+        m_step_tracer = std::move(step_tracer);
+    }
+
     void free_blocks_from_sequence(size_t seq_id, const std::vector<std::set<size_t>>& per_layer_logical_block_indices_to_free) {
         m_block_manager->free_blocks_from_sequence(seq_id, per_layer_logical_block_indices_to_free);
     }
@@ -156,6 +266,113 @@ private:
     }
 
 
+    /**
+     * Forecasts the number of KV cache blocks a sequence group occupies by the end of generation: blocks of the prompt,
+     * shared by the sequences of the group, and blocks of the output of each sequence.
+     */
+    size_t _forecast_num_blocks(const SequenceGroup::Ptr& sequence_group) const {
+        const size_t block_size = get_block_size();
+        const auto& sampling_params = sequence_group->get_sampling_parameters();
+        size_t num_sequences = 1;
+        if (sampling_params.is_beam_search()) {
+            num_sequences = sampling_params.num_beams;
+        } else if (sampling_params.is_multinomial()) {
+            num_sequences = sampling_params.num_return_sequences;
+        }
+
+        const size_t prompt_len = sequence_group->get_prompt_len();
+        size_t output_len = sequence_group->get_max_new_tokens();
+        const size_t avg_output_len = static_cast<size_t>(std::ceil(m_avg_output_len));
+        if (sampling_params.max_new_tokens == SIZE_MAX && sampling_params.max_length == SIZE_MAX) {
+            // output length is unknown, the request runs till EOS or a stop condition
+            output_len = avg_output_len > 0 ? avg_output_len : m_config.default_forecast_output_len;
+        } else if (m_config.forecast_average_output_len && avg_output_len > 0) {
+            output_len = std::min(output_len, avg_output_len);
+        }
+        auto get_num_blocks = [block_size](size_t num_tokens) {
+            return num_tokens / block_size + (num_tokens % block_size != 0);
+        };
+        // a sequence can't take more than the whole KV cache anyway
+        const size_t num_output_blocks = std::min(get_num_blocks(output_len), m_block_manager->get_total_number_of_kv_blocks());
+        size_t num_blocks = get_num_blocks(prompt_len) + num_sequences * num_output_blocks;
+
+        if (m_config.use_cache_eviction) {
+            // eviction caps the number of tokens kept for each sequence
+            const auto& eviction_config = m_config.cache_eviction_config;
+            size_t max_num_tokens = eviction_config.get_max_cache_size() + block_size;
+            if (!eviction_config.evict_during_prefill) {
+                max_num_tokens = std::max(max_num_tokens, prompt_len + block_size);
+            }
+            num_blocks = std::min(num_blocks, num_sequences * get_num_blocks(max_num_tokens));
+        }
+        return num_blocks;
+    }
+
+    /**
+     * Admits sequence groups in the scheduling order while their forecast KV cache demand fits into the KV cache,
+     * except for the headroom. Once a sequence group is deferred, the following ones are deferred as well, so that it
+     * is not starved by smaller ones. At least one sequence group is always admitted.
+     */
+    void _admit_sequence_groups(const std::vector<SequenceGroup::Ptr>& sequence_groups, Output& scheduler_output) {
+        std::unordered_set<uint64_t> present_request_ids;
+        for (const auto& sequence_group : sequence_groups) {
+            present_request_ids.insert(sequence_group->get_request_id());
+        }
+        for (auto it = m_admitted_sequence_groups.begin(); it != m_admitted_sequence_groups.end(); ) {
+            const SequenceGroup::Ptr& sequence_group = it->second.sequence_group;
+            if (present_request_ids.count(it->first) > 0) {
+                ++it;
+                continue;
+            }
+            // removed from the pipeline
+            if (sequence_group->has_finished() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
+                _register_output_len(sequence_group);
+            }
+            it = m_admitted_sequence_groups.erase(it);
+        }
+
+        size_t num_reserved_blocks = 0;
+        for (const auto& [request_id, admitted_sequence_group] : m_admitted_sequence_groups) {
+            num_reserved_blocks += admitted_sequence_group.num_forecast_blocks;
+        }
+
+        const size_t num_total_blocks = m_block_manager->get_total_number_of_kv_blocks();
+        const size_t num_admissible_blocks = static_cast<size_t>(num_total_blocks * (1.0f - m_config.admission_headroom));
+        bool is_deferring = false;
+        for (const auto& sequence_group : sequence_groups) {
+            if (m_admitted_sequence_groups.count(sequence_group->get_request_id()) > 0 || sequence_group->has_finished() ||
+                sequence_group->handle_stopped() || sequence_group->handle_cancelled()) {
+                continue;
+            }
+            const size_t num_forecast_blocks = _forecast_num_blocks(sequence_group);
+            if (!is_deferring && (m_admitted_sequence_groups.empty() || num_reserved_blocks + num_forecast_blocks <= num_admissible_blocks)) {
+                m_admitted_sequence_groups.emplace(sequence_group->get_request_id(), AdmittedSequenceGroup{sequence_group, num_forecast_blocks});
+                num_reserved_blocks += num_forecast_blocks;
+            } else {
+                is_deferring = true;
+                ++scheduler_output.m_num_deferred_sequence_groups;
+            }
+        }
+        scheduler_output.m_forecast_cache_usage = num_total_blocks == 0 ? 0.0f : 100.0f * num_reserved_blocks / num_total_blocks;
+    }
+
+    void _register_output_len(const SequenceGroup::Ptr& sequence_group) {
+        size_t output_len = 0;
+        for (const auto& sequence : sequence_group->get_sequences()) {
+            output_len = std::max(output_len, sequence->get_generated_len());
+        }
+        if (m_avg_output_len == 0.0f) {
+            m_avg_output_len = output_len;
+        } else {
+            m_avg_output_len += OUTPUT_LEN_SMOOTHING_FACTOR * (output_len - m_avg_output_len);
+        }
+    }
+
+    bool _is_admitted(const SequenceGroup::Ptr& sequence_group) const {
+        return !m_config.enable_admission_control || m_dynamic_memory_allocation ||
+               m_admitted_sequence_groups.count(sequence_group->get_request_id()) > 0;
+    }
+
     bool _preempt_by_recompute(SequenceGroup::Ptr sequence_group, size_t blocks_needed) {
         size_t processed_tokens = sequence_group->get_num_processed_tokens();
         size_t prev_blocks_count = m_block_manager->num_free_blocks();
@@ -209,11 +426,11 @@ private:
         return m_block_manager->num_free_blocks() > prev_blocks_count;
     }
 
-    static size_t _get_low_priority_sequence_group_id(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    size_t _get_low_priority_sequence_group_id(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
         for (size_t seq_group_id = 0, num_groups = sequence_groups.size(); seq_group_id < num_groups; ++seq_group_id) {
             size_t group_idx = num_groups - seq_group_id - 1;
-            SequenceGroup::CPtr sequence_group = sequence_groups[group_idx];
-            if (sequence_group->get_num_processed_tokens() > 0) {
+            const SequenceGroup::Ptr& sequence_group = sequence_groups[group_idx];
+            if (sequence_group->get_num_processed_tokens() > 0 && !_is_swapped(sequence_group)) {
                 // we are here, because current sequence group has some reserved KV blocks in block manager
                 // which can be freed
                 return group_idx;
@@ -223,6 +440,52 @@ private:
         return std::numeric_limits<size_t>::max();
     }
 
+    bool _is_swapped(const SequenceGroup::Ptr& sequence_group) {
+        if (!m_block_manager->has_swap_pool()) {
+            return false;
+        }
+        auto sequences = sequence_group->get_not_finished_sequences();
+        return sequences.size() == 1 && m_block_manager->is_swapped(sequences[0]->get_id());
+    }
+
+    /**
+     * Estimates whether swapping the blocks of a sequence group out and back in is cheaper than recomputing the tokens
+     * which would be preempted by recompute.
+     */
+    bool _is_swap_preferred(SequenceGroup::Ptr sequence_group, size_t blocks_needed) {
+        // swapped in blocks are restored in the generation phase only
+        if (m_avg_inference_num_tokens == 0.0f || !sequence_group->can_generate_tokens() || !m_block_manager->can_swap_out(sequence_group)) {
+            return false;
+        }
+        size_t num_blocks = m_block_manager->get_number_of_blocks_occupied_by_sequence(sequence_group);
+        size_t num_tokens_to_recompute = sequence_group->get_num_processed_tokens();
+        if (num_blocks > blocks_needed && m_can_use_partial_preemption && sequence_group->get_num_evicted_tokens() == 0) {
+            num_tokens_to_recompute = std::min(num_tokens_to_recompute, blocks_needed * get_block_size());
+        }
+        float recompute_time_us = num_tokens_to_recompute * m_avg_inference_time_us / m_avg_inference_num_tokens;
+        float swap_time_us = 2.0f * num_blocks * m_cache_manager->get_block_contents_size() / m_swap_bytes_per_us;
+        return swap_time_us < recompute_time_us;
+    }
+
+    bool _preempt_by_swap(SequenceGroup::Ptr sequence_group) {
+        size_t prev_blocks_count = m_block_manager->num_free_blocks();
+        m_block_manager->swap_out(sequence_group);
+        sequence_group->set_waiting();
+        return m_block_manager->num_free_blocks() > prev_blocks_count;
+    }
+
+    bool _try_swap_in(SequenceGroup::Ptr sequence_group) {
+        uint64_t seq_id = sequence_group->get_not_finished_sequences()[0]->get_id();
+        size_t num_blocks = m_block_manager->get_number_of_swapped_blocks(seq_id);
+        while (!m_block_manager->can_allocate_blocks(num_blocks)) {
+            if (!_try_increase_cache()) {
+                return false;
+            }
+        }
+        m_block_manager->swap_in(sequence_group);
+        return true;
+    }
+
     void _apply_preemption(size_t sequence_group_id, const std::vector<SequenceGroup::Ptr>& sequence_groups) {
         SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
 
@@ -236,7 +499,10 @@ private:
                 break;
             }
             size_t blocks_needed = m_block_manager->required_blocks_count(sequence_group);
-            if (!_preempt_by_recompute(sequence_groups[evicted_sequence_group_id], blocks_needed)){
+            SequenceGroup::Ptr evicted_sequence_group = sequence_groups[evicted_sequence_group_id];
+            bool is_preempted = _is_swap_preferred(evicted_sequence_group, blocks_needed) ?
+                _preempt_by_swap(evicted_sequence_group) : _preempt_by_recompute(evicted_sequence_group, blocks_needed);
+            if (!is_preempted) {
                 break;
             }
         }
@@ -253,7 +519,8 @@ private:
 
         for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
             SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
-            if (!sequence_group->can_generate_tokens() && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
+            if (!sequence_group->can_generate_tokens() && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled() &&
+                _is_admitted(sequence_group)) {
                 size_t num_running_seqs = sequence_group->num_running_seqs();
                 // prompt phases can have a single running sequence
                 OPENVINO_ASSERT(num_running_seqs == 1);
@@ -266,6 +533,17 @@ private:
                 // apply megabatch limitations
                 size_t num_scheduled_tokens = std::min(num_tokens_in_megabatch, num_available_tokens);
 
+                // the observation window at the end of the prompt is processed in separate chunks, so that its
+                // attention scores are reported apart from the ones of the preceding prompt tokens
+                if (m_config.use_cache_eviction && m_config.cache_eviction_config.snapkv_window_size > 0) {
+                    size_t prompt_len = sequence_group->get_prompt_len();
+                    size_t window_size = m_config.cache_eviction_config.snapkv_window_size;
+                    size_t num_processed_tokens = sequence_group->get_num_processed_tokens();
+                    if (prompt_len > window_size && num_processed_tokens < prompt_len - window_size) {
+                        num_scheduled_tokens = std::min(num_scheduled_tokens, prompt_len - window_size - num_processed_tokens);
+                    }
+                }
+
                 // apply KV cache limitations
                 size_t block_size = get_block_size();
                 size_t currently_allocated_token_slots = sequence_group->get_num_blocks() * block_size;
@@ -318,6 +596,10 @@ private:
             //         keep latencies for sequence groups of high priority
             if (sequence_group->can_generate_tokens() && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
                 OPENVINO_ASSERT(!sequence_group->has_finished());
+                if (_is_swapped(sequence_group) && !_try_swap_in(sequence_group)) {
+                    // not enough KV cache blocks to bring the swapped out blocks back
+                    continue;
+                }
                 size_t num_running_seqs = sequence_group->num_running_seqs();
                 size_t num_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
                 size_t available_tokens_per_seq_in_megabatch = num_tokens_in_megabatch / num_running_seqs;
@@ -395,7 +677,8 @@ private:
         for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
             SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
             const bool recompute_evicted_sequences = sequence_group->get_num_processed_tokens() == 0 && !m_can_use_partial_preemption;
-            if ((!sequence_group->can_generate_tokens() || recompute_evicted_sequences) && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
+            if ((!sequence_group->can_generate_tokens() || recompute_evicted_sequences) && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled() &&
+                _is_admitted(sequence_group)) {
                 size_t num_running_seqs = sequence_group->num_running_seqs();
                 // prompt phases can have a single running sequence
                 OPENVINO_ASSERT(num_running_seqs == 1);
@@ -461,6 +744,50 @@ private:
         }
     }
 
+    void _transfer_swapped_blocks() {
+        StepTracer::Span span(m_step_tracer.get(), "swap blocks");
+        static thread_local ManualTimer swap_timer("swap blocks");
+        swap_timer.start();
+        auto transfers = m_block_manager->pop_swap_transfers();
+        const size_t num_blocks = transfers.m_blocks_to_swap_out.size() + transfers.m_blocks_to_swap_in.size();
+        if (num_blocks > 0) {
+            const auto transfer_start = std::chrono::steady_clock::now();
+            // swapped out blocks may be reused by swapped in ones, so their contents must be read first
+            for (const auto& block : transfers.m_blocks_to_swap_out) {
+                std::vector<uint8_t> contents;
+                m_cache_manager->read_block(block.block_idx, contents);
+                m_block_manager->store_swapped_out_block(block, std::move(contents));
+            }
+            for (const auto& [block_idx, contents] : transfers.m_blocks_to_swap_in) {
+                m_cache_manager->write_block(block_idx, contents);
+            }
+            const float transfer_time_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - transfer_start).count();
+            if (transfer_time_us > 0.0f) {
+                const float bytes_per_us = num_blocks * m_cache_manager->get_block_contents_size() / transfer_time_us;
+                m_swap_bytes_per_us += PREEMPTION_COST_SMOOTHING_FACTOR * (bytes_per_us - m_swap_bytes_per_us);
+            }
+        }
+        swap_timer.end();
+    }
+
+    void _transfer_persistent_prefix_cache_blocks() {
+        StepTracer::Span span(m_step_tracer.get(), "persistent prefix cache transfer");
+        static thread_local ManualTimer prefix_cache_transfer_timer("persistent prefix cache transfer");
+        prefix_cache_transfer_timer.start();
+        auto transfers = m_block_manager->pop_prefix_cache_transfers();
+        // spilled blocks may be reused by loaded ones, so their contents must be saved first,
+        // they are written to disk in background
+        for (const auto& [hash, block_idx] : transfers.m_blocks_to_spill) {
+            std::vector<uint8_t> contents;
+            m_cache_manager->read_block(block_idx, contents);
+            m_block_manager->store_spilled_block(hash, std::move(contents));
+        }
+        for (const auto& [block_idx, block_contents] : transfers.m_blocks_to_load) {
+            m_cache_manager->write_block(block_idx, block_contents);
+        }
+        prefix_cache_transfer_timer.end();
+    }
+
     size_t _get_available_gpu_memory() {
         auto device = m_cache_manager->get_device();
         OPENVINO_ASSERT(device.find("GPU") != std::string::npos, "_get_available_gpu_memory() is applicable for GPU only.");
@@ -0,0 +1,128 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "openvino/genai/scheduler_config.hpp"
+#include "sequence_group.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Defines the order of sequence groups for the Scheduler. The scheduler serves the sequence groups (both
+ * prompt admission and generation) in this order, and chooses groups to preempt starting from the end of it.
+ */
+class ISchedulingPolicy {
+public:
+    using Ptr = std::shared_ptr<ISchedulingPolicy>;
+
+    virtual ~ISchedulingPolicy() = default;
+
+    /**
+     * Reorders the sequence groups in place, so that the most important ones come first.
+     * @param sequence_groups Sequence groups to be scheduled, in the order they were added to the pipeline.
+     * @param now Current time point, used to compute the waiting time of the requests.
+     */
+    virtual void order(std::vector<SequenceGroup::Ptr>& sequence_groups, std::chrono::steady_clock::time_point now) const = 0;
+
+    static Ptr create(const SchedulerConfig& config);
+};
+
+/**
+ * @brief First come, first served: keeps the arrival order of sequence groups.
+ */
+class FCFSSchedulingPolicy : public ISchedulingPolicy {
+public:
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups, std::chrono::steady_clock::time_point now) const override {}
+};
+
+/**
+ * @brief Orders sequence groups by GenerationConfig::priority raised by one for each `aging_interval_ms` the request
+ * spent in the pipeline, so that low priority requests are not starved. Among the groups with equal effective
+ * priority, the ones with the earliest time to first token deadline (GenerationConfig::ttft_deadline_ms) go first,
+ * the rest are served in the arrival order. The order is recomputed from scratch on each step, so it doesn't depend on
+ * the order left by the previous one.
+ */
+class PrioritySchedulingPolicy : public ISchedulingPolicy {
+    size_t m_aging_interval_ms;
+
+public:
+    /**
+     * @param aging_interval_ms Waiting time which raises the request priority by one. 0 disables aging.
+     */
+    explicit PrioritySchedulingPolicy(size_t aging_interval_ms) : m_aging_interval_ms(aging_interval_ms) {}
+
+    size_t get_effective_priority(const SequenceGroup::CPtr& sequence_group, std::chrono::steady_clock::time_point now) const {
+        size_t priority = sequence_group->get_sampling_parameters().priority;
+        if (m_aging_interval_ms == 0 || now <= sequence_group->get_arrival_time()) {
+            return priority;
+        }
+        auto waiting_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - sequence_group->get_arrival_time()).count();
+        return priority + static_cast<size_t>(waiting_time_ms) / m_aging_interval_ms;
+    }
+
+    /**
+     * @return Time point by which the first token of the group is expected, or time_point::max() if the group has no
+     * deadline or the first token has already been generated.
+     */
+    static std::chrono::steady_clock::time_point get_ttft_deadline(const SequenceGroup::CPtr& sequence_group) {
+        size_t ttft_deadline_ms = sequence_group->get_sampling_parameters().ttft_deadline_ms;
+        if (ttft_deadline_ms == 0 || (*sequence_group)[0]->get_generated_len() > 0) {
+            return std::chrono::steady_clock::time_point::max();
+        }
+        return sequence_group->get_arrival_time() + std::chrono::milliseconds(ttft_deadline_ms);
+    }
+
+    void order(std::vector<SequenceGroup::Ptr>& sequence_groups, std::chrono::steady_clock::time_point now) const override {
+        struct Key {
+            size_t priority;
+            std::chrono::steady_clock::time_point deadline;
+            std::chrono::steady_clock::time_point arrival_time;
+            uint64_t request_id;
+        };
+        // keys are computed once, as the sequence group state must be consistent within a single sort
+        std::vector<std::pair<Key, SequenceGroup::Ptr>> keyed_groups;
+        keyed_groups.reserve(sequence_groups.size());
+        for (const auto& sequence_group : sequence_groups) {
+            keyed_groups.push_back({Key{get_effective_priority(sequence_group, now), get_ttft_deadline(sequence_group),
+                                        sequence_group->get_arrival_time(), sequence_group->get_request_id()}, sequence_group});
+        }
+
+        // the input comes in the order left by the previous step, so ties are broken by arrival explicitly;
+        // request ids are increasing and order the requests which arrived within the same clock tick
+        std::sort(keyed_groups.begin(), keyed_groups.end(), [](const auto& lhs, const auto& rhs) {
+            if (lhs.first.priority != rhs.first.priority) {
+                return lhs.first.priority > rhs.first.priority;
+            }
+            if (lhs.first.deadline != rhs.first.deadline) {
+                return lhs.first.deadline < rhs.first.deadline;
+            }
+            if (lhs.first.arrival_time != rhs.first.arrival_time) {
+                return lhs.first.arrival_time < rhs.first.arrival_time;
+            }
+            return lhs.first.request_id < rhs.first.request_id;
+        });
+
+        for (size_t i = 0; i < keyed_groups.size(); ++i) {
+            sequence_groups[i] = std::move(keyed_groups[i].second);
+        }
+    }
+};
+
+inline ISchedulingPolicy::Ptr ISchedulingPolicy::create(const SchedulerConfig& config) {
+    switch (config.scheduling_policy) {
+    case SchedulingPolicy::FCFS:
+        return std::make_shared<FCFSSchedulingPolicy>();
+    case SchedulingPolicy::PRIORITY:
+        return std::make_shared<PrioritySchedulingPolicy>(config.priority_aging_interval_ms);
+    default:
+        OPENVINO_THROW("Unsupported scheduling policy");
+    }
+}
+
+}
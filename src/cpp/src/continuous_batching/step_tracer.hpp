@@ -0,0 +1,223 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Records spans of the continuous batching steps (scheduling, model inference, sampling etc.) into a ring buffer
+ * of a fixed capacity, so that tracing can stay enabled for a long running pipeline, and writes the recorded spans as
+ * Chrome trace JSON, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+ */
+class StepTracer {
+public:
+    // path of the file the trace is written to when the pipeline is destroyed, tracing is enabled if it's set
+    static constexpr const char* ENVIRONMENT_VARIABLE_NAME = "OV_GENAI_STEP_TRACE";
+    // number of spans kept by the tracer enabled with the environment variable
+    static constexpr const char* CAPACITY_ENVIRONMENT_VARIABLE_NAME = "OV_GENAI_STEP_TRACE_CAPACITY";
+    static constexpr size_t DEFAULT_CAPACITY = 100000;
+
+    /**
+     * Composition of the batch processed at a step, recorded together with the step span
+     */
+    struct BatchComposition {
+        size_t num_prompt_tokens = 0;
+        size_t num_decode_tokens = 0;
+        size_t num_scheduled_groups = 0;
+        float cache_usage = 0.0f;
+    };
+
+    struct Event {
+        // string literal, so that recording a span doesn't copy the name
+        const char* name = nullptr;
+        size_t step = 0;
+        // index of the thread which recorded the span, in the order the threads recorded their first spans
+        size_t tid = 0;
+        int64_t begin_us = 0;
+        int64_t duration_us = 0;
+        std::optional<BatchComposition> batch;
+    };
+
+    /**
+     * @brief Records the span from its construction till its destruction. Does nothing if the tracer is null, so that
+     * the spans cost nothing when tracing is disabled.
+     */
+    class Span {
+        StepTracer* m_tracer;
+        const char* m_name;
+        std::chrono::steady_clock::time_point m_begin;
+        std::optional<BatchComposition> m_batch;
+    public:
+        Span(StepTracer* tracer, const char* name) : m_tracer(tracer), m_name(name) {
+            if (m_tracer) {
+                m_begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Span() {
+            if (m_tracer) {
+                m_tracer->record(m_name, m_begin, std::chrono::steady_clock::now(), m_batch);
+            }
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        void set_batch(const BatchComposition& batch) {
+            m_batch = batch;
+        }
+    };
+
+    explicit StepTracer(size_t capacity, const std::filesystem::path& output_path = {})
+        : m_capacity(capacity), m_output_path(output_path), m_origin(std::chrono::steady_clock::now()) {
+        OPENVINO_ASSERT(m_capacity > 0, "Step trace capacity must be greater than zero");
+        m_events.reserve(m_capacity);
+    }
+
+    /**
+     * @return The tracer configured by the environment variables or nullptr if tracing is not requested
+     */
+    static std::shared_ptr<StepTracer> from_env() {
+        const char* output_path = std::getenv(ENVIRONMENT_VARIABLE_NAME);
+        if (output_path == nullptr || output_path[0] == '\0') {
+            return nullptr;
+        }
+        size_t capacity = DEFAULT_CAPACITY;
+        if (const char* capacity_value = std::getenv(CAPACITY_ENVIRONMENT_VARIABLE_NAME)) {
+            try {
+                capacity = std::stoull(capacity_value);
+            } catch (const std::exception&) {
+                OPENVINO_THROW(CAPACITY_ENVIRONMENT_VARIABLE_NAME, " must be a number of spans, got '", capacity_value, "'");
+            }
+        }
+        return std::make_shared<StepTracer>(capacity, output_path);
+    }
+
+    ~StepTracer() {
+        if (m_output_path.empty()) {
+            return;
+        }
+        try {
+            dump(m_output_path);
+        } catch (...) {
+            // destructor must not throw, the trace is lost
+        }
+    }
+
+    /**
+     * Starts a new step, spans recorded after the call are attributed to it
+     */
+    void begin_step() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_step;
+    }
+
+    void record(const char* name,
+                std::chrono::steady_clock::time_point begin,
+                std::chrono::steady_clock::time_point end,
+                const std::optional<BatchComposition>& batch = std::nullopt) {
+        Event event;
+        event.name = name;
+        event.begin_us = std::chrono::duration_cast<std::chrono::microseconds>(begin - m_origin).count();
+        event.duration_us = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+        event.batch = batch;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        event.step = m_step;
+        event.tid = m_thread_indices.emplace(std::this_thread::get_id(), m_thread_indices.size()).first->second;
+        if (m_events.size() < m_capacity) {
+            m_events.push_back(std::move(event));
+        } else {
+            m_events[m_num_recorded % m_capacity] = std::move(event);
+        }
+        ++m_num_recorded;
+    }
+
+    /**
+     * @return Recorded spans which are not overwritten yet, the oldest first
+     */
+    std::vector<Event> get_events() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() < m_capacity) {
+            return m_events;
+        }
+        const size_t oldest = m_num_recorded % m_capacity;
+        std::vector<Event> events(m_events.begin() + oldest, m_events.end());
+        events.insert(events.end(), m_events.begin(), m_events.begin() + oldest);
+        return events;
+    }
+
+    /**
+     * Writes recorded spans as Chrome trace JSON, the spans of each thread on a separate track. Batch composition of
+     * a step is written as the arguments of the step span and as counter tracks.
+     */
+    void dump(std::ostream& os) const {
+        const std::vector<Event> events = get_events();
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool is_first = true;
+        auto begin_event = [&](const char* name, const char* phase, size_t tid, int64_t ts) {
+            os << (is_first ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"continuous_batching\",\"ph\":\""
+               << phase << "\",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << ts;
+            is_first = false;
+        };
+        for (const Event& event : events) {
+            begin_event(event.name, "X", event.tid, event.begin_us);
+            os << ",\"dur\":" << event.duration_us << ",\"args\":{\"step\":" << event.step;
+            if (event.batch) {
+                os << ",\"num_prompt_tokens\":" << event.batch->num_prompt_tokens
+                   << ",\"num_decode_tokens\":" << event.batch->num_decode_tokens
+                   << ",\"num_scheduled_groups\":" << event.batch->num_scheduled_groups
+                   << ",\"cache_usage\":" << event.batch->cache_usage;
+            }
+            os << "}}";
+
+            if (event.batch) {
+                begin_event("tokens", "C", event.tid, event.begin_us);
+                os << ",\"args\":{\"prompt\":" << event.batch->num_prompt_tokens
+                   << ",\"decode\":" << event.batch->num_decode_tokens << "}}";
+                begin_event("cache usage", "C", event.tid, event.begin_us);
+                os << ",\"args\":{\"percentage\":" << event.batch->cache_usage << "}}";
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    void dump(const std::filesystem::path& path) const {
+        std::ofstream file(path);
+        file.imbue(std::locale::classic());
+        OPENVINO_ASSERT(file.is_open(), "Cannot open step trace file ", path.string(), " for writing");
+        dump(file);
+    }
+
+private:
+    size_t m_capacity;
+    std::filesystem::path m_output_path;
+    std::chrono::steady_clock::time_point m_origin;
+
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_events;
+    std::unordered_map<std::thread::id, size_t> m_thread_indices;
+    size_t m_num_recorded = 0;
+    size_t m_step = 0;
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,164 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "openvino/core/except.hpp"
+
+#include "continuous_batching/stream_detokenizer.hpp"
+#include "generation_stream.hpp"
+
+namespace {
+bool is_incomplete(const std::string& text) {
+    // MSVC with /utf-8 fails to compile � directly with newline in string literal error.
+    constexpr char replacement[] = "\xef\xbf\xbd";
+    return text.size() >= 3 && text.compare(text.size() - 3, 3, replacement) == 0;
+}
+}  // namespace
+
+namespace ov::genai {
+
+StreamDetokenizer::StreamDetokenizer(DecodeFunction decode, bool is_padding_skipped)
+    : m_decode(std::move(decode)), m_is_padding_skipped(is_padding_skipped) {
+    m_worker = std::thread(&StreamDetokenizer::worker, this);
+}
+
+StreamDetokenizer::~StreamDetokenizer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // readers of collected outputs must not be blocked forever
+        if (!m_submissions.empty())
+            m_batches.push(std::make_shared<Batch>(std::move(m_submissions)));
+    }
+    m_batches.push(nullptr);
+    m_worker.join();
+}
+
+void StreamDetokenizer::submit(std::shared_ptr<GenerationStream> stream, GenerationOutputs outputs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_submissions.push_back(Submission{std::move(stream), std::move(outputs)});
+}
+
+void StreamDetokenizer::flush() {
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_submissions.empty()) {
+            m_batches.push(std::make_shared<Batch>(std::move(m_submissions)));
+            m_submissions.clear();
+        }
+        std::swap(exception, m_exception);
+    }
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+void StreamDetokenizer::worker() {
+    while (auto batch = m_batches.pull()) {
+        try {
+            process(*batch);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception)
+                m_exception = std::current_exception();
+        }
+        // streams count outputs in decoding, so every submitted output has to reach its stream
+        for (auto& submission : *batch) {
+            submission.stream->push_detokenized(std::move(submission.outputs));
+        }
+    }
+}
+
+std::vector<std::string> StreamDetokenizer::decode(const std::vector<std::vector<int64_t>>& lines) {
+    if (m_is_padding_skipped) {
+        std::vector<std::string> texts = m_decode(lines);
+        OPENVINO_ASSERT(texts.size() == lines.size(), "Detokenizer returned ", texts.size(), " texts for ", lines.size(), " sequences");
+        return texts;
+    }
+
+    // otherwise text of the pad tokens would be appended to shorter lines
+    std::map<size_t, std::vector<size_t>> line_indices_by_length;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        line_indices_by_length[lines[i].size()].push_back(i);
+    }
+
+    std::vector<std::string> texts(lines.size());
+    std::vector<std::vector<int64_t>> batch;
+    for (const auto& [length, line_indices] : line_indices_by_length) {
+        batch.clear();
+        for (size_t i : line_indices) {
+            batch.push_back(lines[i]);
+        }
+        std::vector<std::string> batch_texts = m_decode(batch);
+        OPENVINO_ASSERT(batch_texts.size() == batch.size(), "Detokenizer returned ", batch_texts.size(), " texts for ", batch.size(), " sequences");
+        for (size_t j = 0; j < line_indices.size(); ++j) {
+            texts[line_indices[j]] = std::move(batch_texts[j]);
+        }
+    }
+    return texts;
+}
+
+void StreamDetokenizer::process(Batch& batch) {
+    // states of destroyed streams are dropped before new streams can reuse their addresses
+    for (auto it = m_sequences.begin(); it != m_sequences.end(); ) {
+        it = it->second.stream.expired() ? m_sequences.erase(it) : std::next(it);
+    }
+
+    struct Line {
+        decltype(m_sequences)::iterator state;
+        // text goes to the latest output of the sequence in the batch
+        GenerationOutput* output;
+    };
+    std::vector<Line> lines;
+    std::map<const SequenceState*, size_t> line_indices;
+    for (auto& submission : batch) {
+        for (auto& [sequence_id, output] : submission.outputs) {
+            if (output.generated_ids.empty() && output.finish_reason == GenerationFinishReason::NONE)
+                continue;
+            auto state = m_sequences.try_emplace({submission.stream.get(), sequence_id}, SequenceState{submission.stream}).first;
+            state->second.tokens.insert(state->second.tokens.end(), output.generated_ids.begin(), output.generated_ids.end());
+            if (state->second.tokens.empty()) {
+                // finished right after a new line, nothing to decode
+                m_sequences.erase(state);
+                continue;
+            }
+            auto [line_index, is_new_line] = line_indices.try_emplace(&state->second, lines.size());
+            if (is_new_line) {
+                lines.push_back(Line{state, &output});
+            } else {
+                lines[line_index->second].output = &output;
+            }
+        }
+    }
+    if (lines.empty())
+        return;
+
+    std::vector<std::vector<int64_t>> tokens;
+    tokens.reserve(lines.size());
+    for (const auto& line : lines) {
+        tokens.push_back(line.state->second.tokens);
+    }
+    std::vector<std::string> texts = decode(tokens);
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        SequenceState& state = lines[i].state->second;
+        GenerationOutput& output = *lines[i].output;
+        const std::string& text = texts[i];
+        const bool is_finished = output.finish_reason != GenerationFinishReason::NONE;
+        if (is_finished || (!text.empty() && text.back() == '\n')) {
+            // flush the cache after the new line symbol or the last token
+            if (text.size() > state.printed_len)
+                output.text = text.substr(state.printed_len);
+            if (is_finished) {
+                m_sequences.erase(lines[i].state);
+            } else {
+                state.tokens.clear();
+                state.printed_len = 0;
+            }
+        } else if (!is_incomplete(text) && text.size() > state.printed_len) {
+            // it is possible to have a shorter text after adding new tokens, only the increased part is printed
+            output.text = text.substr(state.printed_len);
+            state.printed_len = text.size();
+        }
+    }
+}
+
+}  // namespace ov::genai
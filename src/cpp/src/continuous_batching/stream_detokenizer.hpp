@@ -0,0 +1,85 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "openvino/genai/generation_handle.hpp"
+#include "synchronized_queue.hpp"
+
+namespace ov::genai {
+
+class GenerationStream;
+
+/**
+ * @brief Decodes streamed outputs of continuous batching requests, so that handles receive text together with tokens.
+ * Outputs pushed by requests during a step are collected and, after the step, decoded on a background thread, which
+ * overlaps with the next step. All sequences share one batched detokenizer inference, or one per number of tokens to
+ * decode if the detokenizer doesn't skip the padding of shorter sequences. Like TextStreamer, every sequence keeps its
+ * tokens since the last new line and an output gets the text which appeared since the previous output of the sequence.
+ * Text ending with an incomplete UTF-8 character is held back until more tokens arrive.
+ */
+class StreamDetokenizer {
+public:
+    using DecodeFunction = std::function<std::vector<std::string>(const std::vector<std::vector<int64_t>>&)>;
+
+    /**
+     * @param decode Decodes a batch of token sequences, called from the background thread.
+     * @param is_padding_skipped Whether `decode` drops the pad tokens appended to shorter sequences of a batch, e.g. as
+     * special tokens. Otherwise only sequences of the same length are decoded together.
+     */
+    explicit StreamDetokenizer(DecodeFunction decode, bool is_padding_skipped = true);
+    ~StreamDetokenizer();
+
+    StreamDetokenizer(const StreamDetokenizer&) = delete;
+    StreamDetokenizer& operator=(const StreamDetokenizer&) = delete;
+
+    /**
+     * Collects outputs of a stream, they are decoded and pushed to the stream after the next `flush`.
+     */
+    void submit(std::shared_ptr<GenerationStream> stream, GenerationOutputs outputs);
+
+    /**
+     * Sends collected outputs to decoding. Rethrows an exception which happened while decoding previous outputs, their
+     * tokens are pushed to the streams without text in that case.
+     */
+    void flush();
+
+private:
+    struct Submission {
+        std::shared_ptr<GenerationStream> stream;
+        GenerationOutputs outputs;
+    };
+    using Batch = std::vector<Submission>;
+
+    struct SequenceState {
+        // the state is dropped once the stream is destroyed, e.g. after its handle is stopped
+        std::weak_ptr<GenerationStream> stream;
+        std::vector<int64_t> tokens;
+        size_t printed_len = 0;
+    };
+
+    void worker();
+    void process(Batch& batch);
+    std::vector<std::string> decode(const std::vector<std::vector<int64_t>>& lines);
+
+    DecodeFunction m_decode;
+    bool m_is_padding_skipped;
+    std::mutex m_mutex;
+    Batch m_submissions;
+    std::exception_ptr m_exception;
+    // nullptr stops the worker
+    SynchronizedQueue<std::shared_ptr<Batch>> m_batches;
+    // { (stream, sequence id), state }, accessed by the worker only
+    std::map<std::pair<const GenerationStream*, uint64_t>, SequenceState> m_sequences;
+    std::thread m_worker;
+};
+
+}  // namespace ov::genai
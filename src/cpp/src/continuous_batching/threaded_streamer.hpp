@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+#include <string>
 #include <thread>
 
 #include "openvino/genai/llm_pipeline.hpp"
@@ -16,11 +18,30 @@ namespace genai {
 
 class ThreadedStreamerWrapper {
 public:
-    ThreadedStreamerWrapper(const StreamerVariant& streamer, Tokenizer& tokenizer)
-        : m_streamer_ptr{utils::create_streamer(streamer, tokenizer)} {}
+    /**
+     * @param is_text_streamed Whether outputs of the streamed request carry decoded text, i.e. the pipeline has the
+     * stream_detokenization property. Then a callback streamer gets the text passed to `write_text` and no TextStreamer
+     * decoding tokens is created for it. A StreamerBase streamer still gets tokens.
+     */
+    ThreadedStreamerWrapper(const StreamerVariant& streamer, Tokenizer& tokenizer, bool is_text_streamed = false) {
+        if (is_text_streamed) {
+            if (auto callback = std::get_if<std::function<bool(std::string)>>(&streamer)) {
+                m_text_callback = [callback = *callback](std::string text) -> CallbackTypeVariant {
+                    return callback(std::move(text));
+                };
+            } else if (auto callback = std::get_if<std::function<StreamingStatus(std::string)>>(&streamer)) {
+                m_text_callback = [callback = *callback](std::string text) -> CallbackTypeVariant {
+                    return callback(std::move(text));
+                };
+            }
+        }
+        if (!m_text_callback) {
+            m_streamer_ptr = utils::create_streamer(streamer, tokenizer);
+        }
+    }
 
     void start() {
-        if (!m_streamer_ptr) {
+        if (!has_callback()) {
             return;
         }
 
@@ -43,8 +64,16 @@ public:
         m_squeue.push(token);
     }
 
+    void write_text(std::string text) {
+        if (!m_text_callback || text.empty() || m_status != StreamingStatus::RUNNING) {
+            return;
+        }
+
+        m_squeue.push(std::move(text));
+    }
+
     void end() {
-        if (!m_streamer_ptr) {
+        if (!has_callback()) {
             return;
         }
 
@@ -55,7 +84,10 @@ public:
             m_worker_thread->join();
         }
 
-        m_streamer_ptr->end();
+        // the text streamed by the pipeline is complete once the request finishes, nothing is held back here
+        if (m_streamer_ptr) {
+            m_streamer_ptr->end();
+        }
     }
 
     StreamingStatus get_status() const {
@@ -63,26 +95,36 @@ public:
     }
 
     bool has_callback() const {
-        return static_cast<bool>(m_streamer_ptr);
+        return m_streamer_ptr || m_text_callback;
+    }
+
+    /**
+     * @return Whether the streamer expects the decoded text passed to `write_text` rather than tokens.
+     */
+    bool is_text_streamed() const {
+        return static_cast<bool>(m_text_callback);
     }
 
 private:
     std::shared_ptr<StreamerBase> m_streamer_ptr = nullptr;
+    std::function<CallbackTypeVariant(std::string)> m_text_callback;
     std::shared_ptr<std::thread> m_worker_thread = nullptr;
-    SynchronizedQueue<std::variant<int64_t, std::vector<int64_t>, std::monostate>> m_squeue;
+    SynchronizedQueue<std::variant<int64_t, std::vector<int64_t>, std::string, std::monostate>> m_squeue;
 
     std::atomic<StreamingStatus> m_status = StreamingStatus::RUNNING;
 
     void _worker() {
         while (m_status == StreamingStatus::RUNNING) {
             // wait for queue pull
-            std::variant<int64_t, std::vector<int64_t>, std::monostate> token_variant = m_squeue.pull();
+            std::variant<int64_t, std::vector<int64_t>, std::string, std::monostate> token_variant = m_squeue.pull();
 
             // wait for streamer_ptr result
             if (auto token = std::get_if<int64_t>(&token_variant)) {
                 m_status = _get_streaming_status(m_streamer_ptr->write(*token));
             } else if (auto tokens = std::get_if<std::vector<int64_t>>(&token_variant)) {
                 m_status = _get_streaming_status(m_streamer_ptr->write(*tokens));
+            } else if (auto text = std::get_if<std::string>(&token_variant)) {
+                m_status = _get_streaming_status(m_text_callback(std::move(*text)));
             } else if (auto stop_token = std::get_if<std::monostate>(&token_variant)) {
                 break;
             } else {
@@ -89,6 +89,13 @@ GenerationConfig::GenerationConfig(const std::filesystem::path& json_path) {
     read_json_param(data, "assistant_confidence_threshold", assistant_confidence_threshold);
     read_json_param(data, "num_assistant_tokens", num_assistant_tokens);
     read_json_param(data, "max_ngram_size", max_ngram_size);
+    read_json_param(data, "rank_ngram_candidates_by_frequency", rank_ngram_candidates_by_frequency);
+    read_json_param(data, "num_assistant_branches", num_assistant_branches);
+    read_json_param(data, "adaptive_num_assistant_tokens", adaptive_num_assistant_tokens);
+
+    // scheduling
+    read_json_param(data, "priority", priority);
+    read_json_param(data, "ttft_deadline_ms", ttft_deadline_ms);
 
     // append EOS to stop_token_ids
     if (eos_token_id != -1)
@@ -148,6 +155,13 @@ void GenerationConfig::update_generation_config(const ov::AnyMap& properties) {
     read_anymap_param(properties, "assistant_confidence_threshold", assistant_confidence_threshold);
     read_anymap_param(properties, "num_assistant_tokens", num_assistant_tokens);
     read_anymap_param(properties, "max_ngram_size", max_ngram_size);
+    read_anymap_param(properties, "rank_ngram_candidates_by_frequency", rank_ngram_candidates_by_frequency);
+    read_anymap_param(properties, "num_assistant_branches", num_assistant_branches);
+    read_anymap_param(properties, "adaptive_num_assistant_tokens", adaptive_num_assistant_tokens);
+
+    // scheduling
+    read_anymap_param(properties, "priority", priority);
+    read_anymap_param(properties, "ttft_deadline_ms", ttft_deadline_ms);
 }
 
 size_t GenerationConfig::get_max_new_tokens(size_t prompt_length) const {
@@ -265,6 +279,20 @@ void GenerationConfig::validate() const {
     if (num_assistant_tokens == 0) {
         OPENVINO_ASSERT(max_ngram_size == 0, "'max_ngram_size' should be set to default value 0 when prompt lookup is disabled");
     }
+
+    if (rank_ngram_candidates_by_frequency) {
+        OPENVINO_ASSERT(is_prompt_lookup(), "'rank_ngram_candidates_by_frequency' can be enabled only for prompt lookup decoding");
+    }
+
+    OPENVINO_ASSERT(num_assistant_branches > 0, "'num_assistant_branches' should be positive");
+    if (num_assistant_branches > 1) {
+        OPENVINO_ASSERT(is_prompt_lookup(), "'num_assistant_branches' > 1 is supported only by prompt lookup decoding, set 'max_ngram_size' and 'num_assistant_tokens' to enable it");
+        OPENVINO_ASSERT(!is_multinomial(), "'num_assistant_branches' > 1 is not supported by multinomial sampling, candidate branches are validated by greedy decoding only");
+    }
+
+    if (adaptive_num_assistant_tokens) {
+        OPENVINO_ASSERT(num_assistant_tokens > 0, "'adaptive_num_assistant_tokens' requires 'num_assistant_tokens' to be set as the upper bound of candidates number");
+    }
 }
 
 GenerationConfig beam_search() {
@@ -42,9 +42,20 @@ void GenerationHandleImpl::cancel() {
 
 std::unordered_map<uint64_t, GenerationOutput> GenerationHandleImpl::read() {
     OPENVINO_ASSERT(!is_stopped() && !is_cancelled(), "GenerationHandle cannot be used after it is stopped / cancelled.");
+    std::lock_guard<std::mutex> lock(m_read_mutex);
     return m_generation_stream->read();
 }
 
+size_t GenerationHandleImpl::read_available(std::vector<GenerationDelta>& deltas) {
+    OPENVINO_ASSERT(!is_stopped() && !is_cancelled(), "GenerationHandle cannot be used after it is stopped / cancelled.");
+    std::lock_guard<std::mutex> lock(m_read_mutex);
+    return m_generation_stream->read_available(deltas);
+}
+
+void GenerationHandleImpl::set_notification_callback(std::function<void()> callback) {
+    m_generation_stream->set_notification_callback(std::move(callback));
+}
+
 void add_partial_result(std::unordered_map<uint64_t, GenerationOutput>& partial_results, std::unordered_map<uint64_t, GenerationOutput>& iteration_results) {
     for (auto& iteration_result: iteration_results) {
         auto partial_result_iter = partial_results.find(iteration_result.first);
@@ -57,6 +68,7 @@ void add_partial_result(std::unordered_map<uint64_t, GenerationOutput>& partial_
                 partial_result_iter->second.generated_ids.push_back(iteration_result.second.generated_ids[i]);
                 partial_result_iter->second.generated_log_probs.push_back(iteration_result.second.generated_log_probs[i]);
             }
+            partial_result_iter->second.text += iteration_result.second.text;
             partial_result_iter->second.score = iteration_result.second.score;
             partial_result_iter->second.finish_reason = iteration_result.second.finish_reason;
         }
@@ -67,10 +79,12 @@ std::vector<GenerationOutput> GenerationHandleImpl::read_all() {
     OPENVINO_ASSERT(!is_stopped() && !is_cancelled(), "GenerationHandle cannot be used after it is stopped / cancelled.");
     std::vector<GenerationOutput> results;
     std::unordered_map<uint64_t, GenerationOutput> partial_results;
+    // the lock is held for all reads, so that another reader can't take the output can_read() reported
+    std::lock_guard<std::mutex> lock(m_read_mutex);
     // We iterate until generation is running or there are tokens we haven't read yet
     while (get_status() == GenerationStatus::RUNNING || can_read()) {
         // For unary case there's only one iteration and we get all results in a single read() call
-        std::unordered_map<uint64_t, GenerationOutput> iteration_results = read();
+        std::unordered_map<uint64_t, GenerationOutput> iteration_results = m_generation_stream->read();
         add_partial_result(partial_results, iteration_results);
     }
 
@@ -2,17 +2,100 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
-#include <mutex>
 #include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "openvino/genai/generation_handle.hpp"
-#include "synchronized_queue.hpp"
+#include "continuous_batching/stream_detokenizer.hpp"
+#include "spsc_queue.hpp"
 
 namespace ov::genai {
-class GenerationStream {
-    std::mutex m_mutex;
-    GenerationStatus m_status = GenerationStatus::RUNNING;
-    SynchronizedQueue<GenerationOutputs> m_output_queue;
+/**
+ * @brief Channel of outputs of a request from the pipeline to its handle.
+ * Outputs are flattened into per-token records of a single-producer single-consumer queue. The producer is the thread
+ * running the pipeline steps, or the StreamDetokenizer thread if the stream is attached to one before the first push.
+ * The consumer is the thread reading the handle, GenerationHandleImpl serializes reads from several threads.
+ */
+class GenerationStream : public std::enable_shared_from_this<GenerationStream> {
+    static constexpr uint64_t NO_SEQUENCE = std::numeric_limits<uint64_t>::max();
+
+    struct Record {
+        // NO_SEQUENCE for a pushed output without sequences
+        uint64_t sequence_id = NO_SEQUENCE;
+        // -1 if the output of the sequence has no tokens
+        int64_t token_id = -1;
+        float log_prob = 0.0f;
+        float score = 0.0f;
+        // finish reason and text are kept in the last record of the sequence in the output
+        GenerationFinishReason finish_reason = GenerationFinishReason::NONE;
+        std::string text;
+        // the last record of a pushed output
+        bool is_last = false;
+    };
+
+    std::atomic<GenerationStatus> m_status = GenerationStatus::RUNNING;
+    SPSCQueue<Record> m_output_queue;
+    // not owned, the detokenizer thread must not be the one to destroy the detokenizer
+    std::weak_ptr<StreamDetokenizer> m_detokenizer;
+    // outputs are counted when pushed by the pipeline and when their last record is read, the difference covers
+    // outputs being decoded by the detokenizer, so that can_read() neither misses them nor reports already read ones
+    std::atomic<size_t> m_num_pushed_outputs = 0;
+    std::atomic<size_t> m_num_read_outputs = 0;
+
+    std::atomic<bool> m_has_notification_callback = false;
+    std::mutex m_notification_mutex;
+    // shared, so that notify() calls the callback without the lock and without copying it
+    std::shared_ptr<const std::function<void()>> m_notification_callback;
+
+    void write_sequence(uint64_t sequence_id, const int64_t* generated_ids, const float* generated_log_probs, size_t num_tokens,
+                        size_t num_log_probs, float score, GenerationFinishReason finish_reason, std::string text, bool is_last) {
+        for (size_t i = 0; i < std::max<size_t>(num_tokens, 1); ++i) {
+            Record record;
+            record.sequence_id = sequence_id;
+            if (i < num_tokens) {
+                record.token_id = generated_ids[i];
+                record.log_prob = i < num_log_probs ? generated_log_probs[i] : 0.0f;
+            }
+            record.score = score;
+            if (i + 1 >= num_tokens) {
+                record.finish_reason = finish_reason;
+                record.text = std::move(text);
+                record.is_last = is_last;
+            }
+            m_output_queue.push(std::move(record));
+        }
+    }
+
+    void write(GenerationOutputs outputs) {
+        if (outputs.empty()) {
+            Record record;
+            record.is_last = true;
+            m_output_queue.push(std::move(record));
+        }
+        size_t num_sequences_left = outputs.size();
+        for (auto& [sequence_id, output] : outputs) {
+            write_sequence(sequence_id, output.generated_ids.data(), output.generated_log_probs.data(), output.generated_ids.size(),
+                           output.generated_log_probs.size(), output.score, output.finish_reason, std::move(output.text),
+                           num_sequences_left == 1);
+            --num_sequences_left;
+        }
+        m_output_queue.commit();
+    }
+
+    void notify() {
+        if (m_has_notification_callback.load()) {
+            std::shared_ptr<const std::function<void()>> callback;
+            {
+                std::lock_guard<std::mutex> lock(m_notification_mutex);
+                callback = m_notification_callback;
+            }
+            // called without the lock, so that the callback can set another one
+            if (callback)
+                (*callback)();
+        }
+    }
 
 public:
     using Ptr = std::shared_ptr<GenerationStream>;
@@ -24,35 +107,116 @@ public:
         return std::make_shared<GenerationStream>();
     }
 
+    // Outputs pushed after this call get decoded text
+    void set_detokenizer(const std::shared_ptr<StreamDetokenizer>& detokenizer) {
+        m_detokenizer = detokenizer;
+    }
+
+    void set_notification_callback(std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lock(m_notification_mutex);
+            m_notification_callback = callback ? std::make_shared<const std::function<void()>>(std::move(callback)) : nullptr;
+            m_has_notification_callback = static_cast<bool>(m_notification_callback);
+        }
+        // outputs pushed before the callback is set would not be reported otherwise
+        if (can_read())
+            notify();
+    }
+
     void push(GenerationOutputs outputs) {
-        m_output_queue.push(std::move(outputs));
+        ++m_num_pushed_outputs;
+        if (auto detokenizer = m_detokenizer.lock()) {
+            detokenizer->submit(shared_from_this(), std::move(outputs));
+        } else {
+            write(std::move(outputs));
+            notify();
+        }
+    }
+
+    /**
+     * Pushes an output of a single sequence. Unlike `push`, it doesn't build GenerationOutputs unless the stream is
+     * attached to a detokenizer, so that streaming a token doesn't allocate.
+     */
+    void push(uint64_t sequence_id, const int64_t* generated_ids, const float* generated_log_probs, size_t num_tokens,
+              float score, GenerationFinishReason finish_reason) {
+        if (!m_detokenizer.expired()) {
+            GenerationOutput output;
+            output.generated_ids.assign(generated_ids, generated_ids + num_tokens);
+            output.generated_log_probs.assign(generated_log_probs, generated_log_probs + num_tokens);
+            output.score = score;
+            output.finish_reason = finish_reason;
+            push({{sequence_id, std::move(output)}});
+            return;
+        }
+        ++m_num_pushed_outputs;
+        write_sequence(sequence_id, generated_ids, generated_log_probs, num_tokens, num_tokens, score, finish_reason, {}, true);
+        m_output_queue.commit();
+        notify();
+    }
+
+    // Called by StreamDetokenizer when the text of outputs is ready
+    void push_detokenized(GenerationOutputs outputs) {
+        write(std::move(outputs));
+        notify();
     }
 
     GenerationOutputs read() {
-        return m_output_queue.pull();
+        GenerationOutputs outputs;
+        while (true) {
+            m_output_queue.wait();
+            Record& record = *m_output_queue.front();
+            if (record.sequence_id != NO_SEQUENCE) {
+                GenerationOutput& output = outputs[record.sequence_id];
+                if (record.token_id != -1) {
+                    output.generated_ids.push_back(record.token_id);
+                    output.generated_log_probs.push_back(record.log_prob);
+                }
+                output.score = record.score;
+                output.finish_reason = record.finish_reason;
+                output.text += record.text;
+            }
+            const bool is_last = record.is_last;
+            m_output_queue.pop();
+            if (is_last) {
+                ++m_num_read_outputs;
+                return outputs;
+            }
+        }
+    }
+
+    size_t read_available(std::vector<GenerationDelta>& deltas) {
+        deltas.clear();
+        while (Record* record = m_output_queue.front()) {
+            if (record->sequence_id != NO_SEQUENCE && (record->token_id != -1 || record->finish_reason != GenerationFinishReason::NONE)) {
+                deltas.push_back(GenerationDelta{record->sequence_id, record->token_id, record->log_prob, record->finish_reason});
+            }
+            if (record->is_last) {
+                ++m_num_read_outputs;
+            }
+            m_output_queue.pop();
+        }
+        return deltas.size();
     }
 
     bool can_read() {
-        return !m_output_queue.empty();
+        // outputs are read only after they are pushed, so the read counter is loaded first
+        const size_t num_read_outputs = m_num_read_outputs.load();
+        return m_num_pushed_outputs.load() > num_read_outputs;
     }
 
     void set_generation_status(GenerationStatus status) {
-        std::lock_guard<std::mutex> lock(m_mutex);
         m_status = status;
     }
 
     GenerationStatus get_status() {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return m_status;
     }
 
     void stop() {
-        std::lock_guard<std::mutex> lock(m_mutex);
         m_status = GenerationStatus::STOP;
     }
 
     void cancel() {
-        std::lock_guard<std::mutex> lock(m_mutex);
         m_status = GenerationStatus::CANCEL;
     }
 };
@@ -135,7 +135,9 @@ DecodedResults StatefulLLMPipeline::generate(
             constexpr bool add_generation_prompt = true;
             auto new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
             // Do not add special tokens in chat scenario to be aligned with HF.
-            auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+            auto new_chat_tokens = m_tokenizer.encode_with_prefix(new_templated_chat_history, m_templated_chat_history, m_templated_chat_history_ids, ov::genai::add_special_tokens(false));
+            m_templated_chat_history = std::move(new_templated_chat_history);
+            m_templated_chat_history_ids.assign(new_chat_tokens.input_ids.data<int64_t>(), new_chat_tokens.input_ids.data<int64_t>() + new_chat_tokens.input_ids.get_size());
 
             if (m_use_full_chat_history) {
                 encoded_input = new_chat_tokens;
@@ -419,6 +421,8 @@ void StatefulLLMPipeline::finish_chat() {
         m_tokenized_chat_history.clear();
         m_kv_cache_state.reset_state();
     }
+    m_templated_chat_history.clear();
+    m_templated_chat_history_ids.clear();
 }
 
 } // namespace ov::genai
@@ -19,6 +19,9 @@ class StatefulLLMPipeline final : public LLMPipelineImplBase {
     bool is_chat_conversation = false;
     ChatHistory m_history;
     std::vector<int64_t> m_tokenized_chat_history;
+    // templated history of the previous turn and its tokens, which are reused when the next turn is tokenized
+    std::string m_templated_chat_history;
+    std::vector<int64_t> m_templated_chat_history_ids;
     ov::genai::utils::GenerationChatInputsType m_chat_input_type = ov::genai::utils::GenerationChatInputsType::UNDEF;
     // Finish reason of last generation for chat scenario
     ov::genai::GenerationStatus m_chat_generation_finish_status = ov::genai::GenerationStatus::RUNNING;
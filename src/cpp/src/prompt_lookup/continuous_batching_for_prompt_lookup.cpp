@@ -17,70 +17,80 @@ ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::get_generated
     return result;
 }
 
-TokenIds ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size) {
-    if (num_pred_tokens == 0) {
-        return std::vector<int64_t>{};
-    }
-
-    const size_t input_length = input_ids.size();
-
-    for (int32_t ngram_size = max_ngram_size; ngram_size > 0; ngram_size--) {
-        // extract last ngram_size tokens as search ngram
-        std::vector<int64_t> ngram = std::vector<int64_t>{input_ids.cend() - ngram_size, input_ids.cend()};
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates() {
+    // indices of requests which are not running anymore are dropped
+    std::map<uint64_t, NgramIndex> ngram_indices;
+    for (auto& request : m_requests) {
+        const auto& prompt = request->get_prompt_ids();
+        const auto& sampling_params = request->get_sampling_parameters();
+        const auto running_sequences = request->get_running_sequences();
+        if (running_sequences.empty()) {
+            request->set_num_validated_tokens(0);
+            continue;
+        }
+        // prompt lookup runs a single sequence per request, candidate branches exist only within a step
+        OPENVINO_ASSERT(running_sequences.size() == 1, "Prompt lookup supports a single running sequence per request");
+        const auto& running_sequence = running_sequences.front();
 
-        // find ngram match in input_ids
-        size_t ngram_i = 0;
-        for (size_t input_i = 0; input_i < input_length - ngram_size; input_i++) {
-            if (ngram[ngram_i] != input_ids[input_i]) {
-                ngram_i = 0;
-                continue;
+        // index of a request covers the accepted tokens only: candidates of the previous step are either accepted or removed by now
+        const auto request_id = request->get_request_id();
+        auto index_it = m_ngram_indices.find(request_id);
+        auto& ngram_index = index_it != m_ngram_indices.end() ?
+            ngram_indices.emplace(request_id, std::move(index_it->second)).first->second :
+            ngram_indices.emplace(request_id, NgramIndex(sampling_params.max_ngram_size)).first->second;
+        ngram_index.extend(prompt, running_sequence->get_generated_ids());
+
+        size_t num_assistant_tokens = sampling_params.num_assistant_tokens;
+        if (sampling_params.adaptive_num_assistant_tokens) {
+            if (!m_draft_length_controller.has_request(request_id)) {
+                m_draft_length_controller.add_request(request_id, sampling_params.num_assistant_tokens);
             }
+            num_assistant_tokens = m_draft_length_controller.get_num_draft_tokens(request_id);
+        }
 
-            ngram_i++;
+        size_t min_num_assistant_tokens = 0;
+        {
+            const auto generated_len = running_sequence->get_generated_len();
+            const auto left_generated_len = request->get_max_new_tokens() - generated_len - 1;
+            min_num_assistant_tokens = std::min(num_assistant_tokens, left_generated_len);
+        }
 
-            if (ngram_i < ngram_size) {
-                continue;
+        std::vector<TokenIds> branches;
+        // branches are forked only in generation phase, when KV cache holds all tokens except the last generated one
+        const bool is_generation_phase = running_sequence->get_generated_len() > 0 &&
+            request->get_num_processed_tokens() + 1 == request->get_prompt_len() + running_sequence->get_generated_len();
+        if (sampling_params.num_assistant_branches > 1 && is_generation_phase) {
+            branches = ngram_index.find_candidate_branches(min_num_assistant_tokens, sampling_params.num_assistant_branches,
+                                                           sampling_params.rank_ngram_candidates_by_frequency);
+            // all sequences of a group are processed with the same number of tokens, so only branches of the first branch length are kept
+            if (!branches.empty()) {
+                const size_t num_candidates = branches.front().size();
+                branches.erase(std::remove_if(branches.begin(), branches.end(), [num_candidates](const TokenIds& branch) {
+                    return branch.size() != num_candidates;
+                }), branches.end());
+            }
+        } else {
+            TokenIds candidates = ngram_index.find_candidates(min_num_assistant_tokens, sampling_params.rank_ngram_candidates_by_frequency);
+            if (!candidates.empty()) {
+                branches.push_back(std::move(candidates));
             }
-
-            // match found with the end at input_i
-            size_t avaliable_num_pred = std::min(input_length - (input_i + 1), num_pred_tokens);
-
-            // return candidates with length of avaliable_num_pred
-            return std::vector<int64_t>{input_ids.cbegin() + input_i + 1,
-                                        input_ids.cbegin() + input_i + 1 + avaliable_num_pred};
         }
-    }
 
-    return std::vector<int64_t>{};
-}
-
-void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates() {
-    for (auto& request : m_requests) {
-        const auto prompt = request->get_prompt_ids();
-        size_t max_validation_len = 0;
-        for (auto& running_sequence : request->get_running_sequences()) {
-            const auto generated_tokens = running_sequence->get_generated_ids();
-            TokenIds full_input_ids = prompt;
-            full_input_ids.insert(full_input_ids.end(), generated_tokens.begin(), generated_tokens.end());
-
-            size_t min_num_assistant_tokens = 0;
-            const auto sampling_params = request->get_sampling_parameters();
-            {
-                const auto generated_len = running_sequence->get_generated_len();
-                const auto left_generated_len = request->get_max_new_tokens() - generated_len - 1;
-                min_num_assistant_tokens = std::min(sampling_params.num_assistant_tokens, left_generated_len);
+        for (size_t branch_idx = 1; branch_idx < branches.size(); ++branch_idx) {
+            const auto forked_sequence = request->fork_sequence(running_sequence);
+            m_scheduler->fork_sequence(running_sequence->get_id(), forked_sequence->get_id());
+            for (const auto& candidate : branches[branch_idx]) {
+                forked_sequence->append_token(candidate, 0);
             }
-            TokenIds candidates = generate_candidates(full_input_ids, min_num_assistant_tokens, sampling_params.max_ngram_size);
-
-            if (!candidates.empty()) {
-                for (const auto& candidate : candidates) {
-                    running_sequence->append_token(candidate, 0);
-                }
-                max_validation_len = std::max(max_validation_len, candidates.size());
+        }
+        if (!branches.empty()) {
+            for (const auto& candidate : branches.front()) {
+                running_sequence->append_token(candidate, 0);
             }
         }
-        request->set_num_validated_tokens(max_validation_len);
+        request->set_num_validated_tokens(branches.empty() ? 0 : branches.front().size());
     }
+    m_ngram_indices = std::move(ngram_indices);
 }
 
 bool ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::is_requests_empty() {
@@ -6,6 +6,8 @@
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "continuous_batching/pipeline_impl.hpp"
+#include "prompt_lookup/ngram_index.hpp"
+#include "speculative_decoding/draft_length_controller.hpp"
 
 namespace ov::genai {
 class ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl : public ContinuousBatchingPipeline::ContinuousBatchingImpl {
@@ -39,8 +41,15 @@ public:
 
     size_t get_processed_tokens_per_iteration();
 
+    DraftLengthController& get_draft_length_controller() {
+        return m_draft_length_controller;
+    }
+
     using ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests;
 protected:
-    TokenIds generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size);
+    // { request_id, n-gram index of its prompt and generated tokens }
+    std::map<uint64_t, NgramIndex> m_ngram_indices;
+    // chooses number of candidates for requests with `adaptive_num_assistant_tokens`
+    DraftLengthController m_draft_length_controller;
 };
 }
\ No newline at end of file
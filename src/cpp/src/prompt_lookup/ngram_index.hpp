@@ -0,0 +1,203 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Incremental index of n-grams of a sequence (prompt and generated tokens) for prompt lookup decoding.
+ * Every n-gram up to `max_ngram_size` is hashed into a table with the position of its first continuation and the
+ * position of its most frequent continuation, distinct continuations of an n-gram are chained to propose several
+ * candidate branches. The index is extended by the tokens appended to the sequence since the
+ * last call, so that the work per step is O(max_ngram_size) per new token, and a lookup is O(max_ngram_size).
+ */
+class NgramIndex {
+public:
+    using TokenIds = std::vector<int64_t>;
+
+    explicit NgramIndex(size_t max_ngram_size) : m_max_ngram_size(max_ngram_size) {
+        OPENVINO_ASSERT(max_ngram_size > 0, "max_ngram_size should be positive");
+    }
+
+    /**
+     * Indexes tokens of the sequence which are not indexed yet. The index is rebuilt if the sequence became shorter
+     * than the indexed part.
+     * @param prompt_ids Prompt tokens of the sequence.
+     * @param generated_ids Generated tokens of the sequence.
+     */
+    void extend(const TokenIds& prompt_ids, const TokenIds& generated_ids) {
+        const size_t num_tokens = prompt_ids.size() + generated_ids.size();
+        if (num_tokens < m_tokens.size()) {
+            reset();
+        }
+        if (m_tokens.empty()) {
+            m_tokens.reserve(num_tokens);
+            m_ngrams.reserve(num_tokens * m_max_ngram_size);
+        }
+        for (size_t position = m_tokens.size(); position < num_tokens; ++position) {
+            append(position < prompt_ids.size() ? prompt_ids[position] : generated_ids[position - prompt_ids.size()]);
+        }
+    }
+
+    /**
+     * Looks for the longest n-gram at the end of the sequence which occurred earlier in the sequence and returns the
+     * tokens following it.
+     * @param num_pred_tokens Maximum number of tokens to return.
+     * @param rank_by_frequency If true, the most frequent continuation of the n-gram is taken, otherwise the first one.
+     */
+    TokenIds find_candidates(size_t num_pred_tokens, bool rank_by_frequency = false) const {
+        const auto infos = find_ngram_infos();
+        if (num_pred_tokens == 0 || infos.empty())
+            return {};
+        const NgramInfo* info = infos.front();
+        return get_candidates(rank_by_frequency ? info->best_continuation : info->first_continuation, num_pred_tokens);
+    }
+
+    /**
+     * Returns up to `num_branches` candidate sequences starting with distinct tokens. Continuations of the longest
+     * matched n-gram come first, then continuations of shorter ones. The first branch is the same as the result of
+     * `find_candidates`.
+     * @param num_pred_tokens Maximum number of tokens in a branch.
+     * @param num_branches Maximum number of branches.
+     * @param rank_by_frequency If true, continuations of an n-gram are ordered by frequency, otherwise by position.
+     */
+    std::vector<TokenIds> find_candidate_branches(size_t num_pred_tokens, size_t num_branches, bool rank_by_frequency = false) const {
+        std::vector<TokenIds> branches;
+        if (num_pred_tokens == 0 || num_branches == 0)
+            return branches;
+        for (const NgramInfo* info : find_ngram_infos()) {
+            std::vector<const ContinuationInfo*> continuations;
+            for (uint64_t key = info->last_continuation; key != NO_CONTINUATION; ) {
+                const ContinuationInfo& continuation = m_continuations.at(key);
+                continuations.push_back(&continuation);
+                key = continuation.previous_sibling;
+            }
+            std::sort(continuations.begin(), continuations.end(), [rank_by_frequency](const ContinuationInfo* lhs, const ContinuationInfo* rhs) {
+                if (rank_by_frequency && lhs->count != rhs->count)
+                    return lhs->count > rhs->count;
+                return lhs->first_position < rhs->first_position;
+            });
+            for (const ContinuationInfo* continuation : continuations) {
+                const int64_t first_token = m_tokens[continuation->first_position];
+                const bool is_new_branch = std::none_of(branches.begin(), branches.end(), [first_token](const TokenIds& branch) {
+                    return branch.front() == first_token;
+                });
+                if (is_new_branch) {
+                    branches.push_back(get_candidates(continuation->first_position, num_pred_tokens));
+                    if (branches.size() == num_branches)
+                        return branches;
+                }
+            }
+        }
+        return branches;
+    }
+
+    size_t size() const {
+        return m_tokens.size();
+    }
+
+private:
+    static constexpr uint64_t NO_CONTINUATION = 0;
+
+    struct NgramInfo {
+        // position of the token following the first occurrence of the n-gram
+        size_t first_continuation;
+        // position of the first occurrence of the most frequent token following the n-gram, the earliest one on a tie
+        size_t best_continuation;
+        size_t best_continuation_count;
+        // key of the latest distinct continuation, continuations of the n-gram are chained through `previous_sibling`
+        uint64_t last_continuation;
+    };
+
+    struct ContinuationInfo {
+        size_t first_position;
+        size_t count;
+        uint64_t previous_sibling;
+    };
+
+    // hashes the longest n-grams at the end of the sequence and returns the ones which occurred earlier, longest first
+    std::vector<const NgramInfo*> find_ngram_infos() const {
+        std::vector<const NgramInfo*> infos;
+        const size_t num_tokens = m_tokens.size();
+        if (num_tokens < 2)
+            return infos;
+        uint64_t hash = 0;
+        for (size_t ngram_size = 1; ngram_size <= std::min(m_max_ngram_size, num_tokens - 1); ++ngram_size) {
+            hash = extend_hash(hash, m_tokens[num_tokens - ngram_size], ngram_size);
+            auto it = m_ngrams.find(hash);
+            // n-gram can occur only if its suffixes occurred
+            if (it == m_ngrams.end())
+                break;
+            // hash collision, the first occurrence of the n-gram has to be the same tokens as the end of the sequence
+            if (std::equal(m_tokens.end() - ngram_size, m_tokens.end(), m_tokens.begin() + it->second.first_continuation - ngram_size))
+                infos.push_back(&it->second);
+        }
+        std::reverse(infos.begin(), infos.end());
+        return infos;
+    }
+
+    TokenIds get_candidates(size_t begin, size_t num_pred_tokens) const {
+        const size_t end = std::min(m_tokens.size(), begin + num_pred_tokens);
+        return TokenIds(m_tokens.begin() + begin, m_tokens.begin() + end);
+    }
+
+    static uint64_t mix(uint64_t value) {
+        // splitmix64 finalizer
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    // hash of an n-gram is built from its last token backward, so hashes of all n-grams ending at a position come in one pass
+    static uint64_t extend_hash(uint64_t hash, int64_t token, size_t ngram_size) {
+        return mix(hash ^ mix(static_cast<uint64_t>(token) + (static_cast<uint64_t>(ngram_size) << 56)));
+    }
+
+    void append(int64_t token) {
+        const size_t position = m_tokens.size();
+        m_tokens.push_back(token);
+        // n-grams ending right before the new token get it as a continuation
+        uint64_t hash = 0;
+        for (size_t ngram_size = 1; ngram_size <= std::min(m_max_ngram_size, position); ++ngram_size) {
+            hash = extend_hash(hash, m_tokens[position - ngram_size], ngram_size);
+            NgramInfo& ngram = m_ngrams.try_emplace(hash, NgramInfo{position, position, 0, NO_CONTINUATION}).first->second;
+            // zero is reserved for the end of the continuations chain
+            const uint64_t continuation_key = std::max<uint64_t>(mix(hash ^ static_cast<uint64_t>(token)), 1);
+            auto [continuation_it, is_new_continuation] = m_continuations.try_emplace(continuation_key, ContinuationInfo{position, 0, ngram.last_continuation});
+            if (is_new_continuation) {
+                ngram.last_continuation = continuation_key;
+            }
+            ContinuationInfo& continuation = continuation_it->second;
+            // counts grow by one, so the running maximum is exact
+            ++continuation.count;
+            if (continuation.count > ngram.best_continuation_count ||
+                (continuation.count == ngram.best_continuation_count && continuation.first_position < ngram.best_continuation)) {
+                ngram.best_continuation_count = continuation.count;
+                ngram.best_continuation = continuation.first_position;
+            }
+        }
+    }
+
+    void reset() {
+        m_tokens.clear();
+        m_ngrams.clear();
+        m_continuations.clear();
+    }
+
+    size_t m_max_ngram_size;
+    TokenIds m_tokens;
+    std::unordered_map<uint64_t, NgramInfo> m_ngrams;
+    // { hash of (n-gram, next token), statistics }
+    std::unordered_map<uint64_t, ContinuationInfo> m_continuations;
+};
+
+}  // namespace ov::genai
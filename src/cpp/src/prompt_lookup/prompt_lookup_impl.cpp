@@ -32,6 +32,11 @@ bool ContinuousBatchingPipeline::PromptLookupImpl::has_non_finished_requests() {
     return m_pipeline->has_non_finished_requests();
 }
 
+void ContinuousBatchingPipeline::PromptLookupImpl::enable_stream_detokenization() {
+    m_pipeline->enable_stream_detokenization();
+    m_is_stream_detokenization_enabled = true;
+}
+
 void ContinuousBatchingPipeline::PromptLookupImpl::step() {
     auto& raw_perf_counters = m_perf_metrics.raw_metrics;
 
@@ -53,10 +58,17 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
     m_pipeline_metrics = m_pipeline->get_metrics();
     auto generated_len_after = m_pipeline->get_generated_request_len();
 
+    auto& draft_length_controller = m_pipeline->get_draft_length_controller();
+    size_t num_candidates = 0;
     for (const auto request : generated_len_before) {
         auto request_id = request.first;
         auto prev_validation_len = request.second.second;
+        num_candidates += prev_validation_len;
+        if (!generated_len_after.count(request_id)) {
+            draft_length_controller.remove_request(request_id);
+        }
         if (prev_validation_len == 0) {
+            draft_length_controller.update_acceptance(request_id, 0, 0);
             continue;
         }
         size_t num_matches = prev_validation_len;
@@ -67,11 +79,16 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
 
             num_matches = (present_req_len - prev_full_req_len - 1);
             acceptance_rate = static_cast<float>(num_matches) / static_cast<float>(prev_validation_len);
+            draft_length_controller.update_acceptance(request_id, prev_validation_len, prev_validation_len - num_matches);
         }        
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
         m_sd_metrics.update_draft_accepted_tokens(request_id, num_matches);
     }
 
+    if (num_candidates > 0) {
+        draft_length_controller.update_costs(candidates_timer.get_duration() / num_candidates, main_timer.get_duration());
+    }
+
     // update perf metrics
     const auto num_generated_tokens = m_pipeline->get_processed_tokens_per_iteration();
     if (num_generated_tokens > 0) {    
@@ -110,7 +127,7 @@ ContinuousBatchingPipeline::PromptLookupImpl::generate(const std::vector<ov::Ten
     }
     m_pipeline->set_adapters(sampling_params[0].adapters);
 
-    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer);
+    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer, m_is_stream_detokenization_enabled);
 
     OPENVINO_ASSERT(!streamer_ptr->has_callback() || input_ids.size() == 1 && (sampling_params[0].is_greedy_decoding() || sampling_params[0].is_multinomial()),
         "Currently streaming is possible only with batch size=1 and only for greedy or multinomial decoding");
@@ -196,5 +213,6 @@ ContinuousBatchingPipeline::PromptLookupImpl::get_metrics() {
 
 void ContinuousBatchingPipeline::PromptLookupImpl::drop_requests() {
     m_pipeline->drop_requests();
+    m_pipeline->get_draft_length_controller().clear();
 }
 }
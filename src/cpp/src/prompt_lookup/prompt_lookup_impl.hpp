@@ -40,6 +40,8 @@ public:
 
     bool has_non_finished_requests() override;
 
+    void enable_stream_detokenization() override;
+
     void step() override;
 
     std::vector<EncodedGenerationResult>
@@ -0,0 +1,531 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sampling/logit_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "openvino/runtime/system_conf.hpp"
+#include "sampling/logit_processor.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    define LOGIT_KERNELS_X86
+#    include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#    define LOGIT_KERNELS_TARGET(isa) __attribute__((target(isa)))
+#else
+#    define LOGIT_KERNELS_TARGET(isa)
+#endif
+
+namespace LogitKernels {
+namespace {
+
+enum class Isa { SCALAR, AVX2, AVX512 };
+
+Isa get_isa() {
+#ifdef LOGIT_KERNELS_X86
+    static const Isa isa = ov::with_cpu_x86_avx512f() ? Isa::AVX512 : (ov::with_cpu_x86_avx2() ? Isa::AVX2 : Isa::SCALAR);
+    return isa;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+// exp() arguments below this value are flushed to zero by the vector kernels
+constexpr float EXP_LOWER_BOUND = -87.3f;
+
+float max_scalar(const float* data, size_t size) {
+    float max_value = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < size; ++i) {
+        max_value = std::max(max_value, data[i]);
+    }
+    return max_value;
+}
+
+float exp_and_sum_scalar(float* data, size_t size, float shift, float scale) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = std::exp((data[i] - shift) * scale);
+        sum += data[i];
+    }
+    return sum;
+}
+
+void multiply_scalar(float* data, size_t size, float multiplier) {
+    for (size_t i = 0; i < size; ++i) {
+        data[i] *= multiplier;
+    }
+}
+
+// Selection kernels scan the data by blocks, skipping the blocks without values above the threshold
+constexpr size_t BLOCK_SIZE = 16;
+
+/**
+ * Finds the first block starting from `begin` with values not less than `threshold`.
+ * @return Start of the found block or `end` if there is none, `mask` is set to the bit mask of matching values.
+ */
+size_t find_block_scalar(const float* data, size_t begin, size_t end, float threshold, uint32_t& mask) {
+    for (; begin + BLOCK_SIZE <= end; begin += BLOCK_SIZE) {
+        mask = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            mask |= static_cast<uint32_t>(data[begin + i] >= threshold) << i;
+        }
+        if (mask != 0)
+            return begin;
+    }
+    return end;
+}
+
+// Top-p cutoff candidates: max probability multiplied by 2^0, 2^-4, ..., 2^-28
+constexpr size_t NUM_MASS_THRESHOLDS = 8;
+constexpr float MASS_THRESHOLD_STEP = 1.0f / 16;
+
+void masses_above_scalar(const float* data, size_t size, const float* thresholds, double* masses) {
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+            masses[t] += data[i] >= thresholds[t] ? data[i] : 0.0f;
+        }
+    }
+}
+
+#ifdef LOGIT_KERNELS_X86
+
+// Cephes-style exp: exp(x) = 2^n * exp(r), |r| <= ln(2) / 2, exp(r) approximated by a polynomial
+LOGIT_KERNELS_TARGET("avx2,fma")
+inline __m256 exp_avx2(__m256 x) {
+    const __m256 zero_mask = _mm256_cmp_ps(x, _mm256_set1_ps(EXP_LOWER_BOUND), _CMP_LT_OQ);
+    x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(EXP_LOWER_BOUND));
+
+    __m256 n = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f)));
+    x = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    x = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), x);
+
+    __m256 y = _mm256_set1_ps(1.9875691500E-4f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507E-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073E-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894E-2f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201E-1f));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+    __m256i pow2n = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    y = _mm256_mul_ps(y, _mm256_castsi256_ps(pow2n));
+    return _mm256_andnot_ps(zero_mask, y);
+}
+
+LOGIT_KERNELS_TARGET("avx2,fma")
+float max_avx2(const float* data, size_t size) {
+    __m256 max_vec = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        max_vec = _mm256_max_ps(max_vec, _mm256_loadu_ps(data + i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, max_vec);
+    return std::max(max_scalar(lanes, 8), max_scalar(data + i, size - i));
+}
+
+LOGIT_KERNELS_TARGET("avx2,fma")
+float exp_and_sum_avx2(float* data, size_t size, float shift, float scale) {
+    const __m256 shift_vec = _mm256_set1_ps(shift), scale_vec = _mm256_set1_ps(scale);
+    __m256 sum_vec = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256 value = exp_avx2(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(data + i), shift_vec), scale_vec));
+        _mm256_storeu_ps(data + i, value);
+        sum_vec = _mm256_add_ps(sum_vec, value);
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum_vec);
+    float sum = exp_and_sum_scalar(data + i, size - i, shift, scale);
+    for (float lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+LOGIT_KERNELS_TARGET("avx2,fma")
+void multiply_avx2(float* data, size_t size, float multiplier) {
+    const __m256 multiplier_vec = _mm256_set1_ps(multiplier);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), multiplier_vec));
+    }
+    multiply_scalar(data + i, size - i, multiplier);
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+inline __m512 exp_avx512(__m512 x) {
+    const __mmask16 zero_mask = _mm512_cmp_ps_mask(x, _mm512_set1_ps(EXP_LOWER_BOUND), _CMP_LT_OQ);
+    x = _mm512_min_ps(x, _mm512_set1_ps(88.3762626647949f));
+    x = _mm512_max_ps(x, _mm512_set1_ps(EXP_LOWER_BOUND));
+
+    __m512 n = _mm512_roundscale_ps(_mm512_fmadd_ps(x, _mm512_set1_ps(1.44269504088896341f), _mm512_set1_ps(0.5f)),
+                                    _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    x = _mm512_fnmadd_ps(n, _mm512_set1_ps(0.693359375f), x);
+    x = _mm512_fnmadd_ps(n, _mm512_set1_ps(-2.12194440e-4f), x);
+
+    __m512 y = _mm512_set1_ps(1.9875691500E-4f);
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.3981999507E-3f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(8.3334519073E-3f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.1665795894E-2f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.6666665459E-1f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(5.0000001201E-1f));
+    y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), _mm512_add_ps(x, _mm512_set1_ps(1.0f)));
+
+    __m512i pow2n = _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23);
+    y = _mm512_mul_ps(y, _mm512_castsi512_ps(pow2n));
+    return _mm512_maskz_mov_ps(static_cast<__mmask16>(~zero_mask), y);
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+float max_avx512(const float* data, size_t size) {
+    const __m512 lowest = _mm512_set1_ps(-std::numeric_limits<float>::infinity());
+    __m512 max_vec = lowest;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        max_vec = _mm512_max_ps(max_vec, _mm512_loadu_ps(data + i));
+    }
+    const __mmask16 tail_mask = static_cast<__mmask16>((1u << (size - i)) - 1);
+    max_vec = _mm512_max_ps(max_vec, _mm512_mask_loadu_ps(lowest, tail_mask, data + i));
+    return _mm512_reduce_max_ps(max_vec);
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+float exp_and_sum_avx512(float* data, size_t size, float shift, float scale) {
+    const __m512 shift_vec = _mm512_set1_ps(shift), scale_vec = _mm512_set1_ps(scale);
+    __m512 sum_vec = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m512 value = exp_avx512(_mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(data + i), shift_vec), scale_vec));
+        _mm512_storeu_ps(data + i, value);
+        sum_vec = _mm512_add_ps(sum_vec, value);
+    }
+    const __mmask16 tail_mask = static_cast<__mmask16>((1u << (size - i)) - 1);
+    __m512 value = exp_avx512(_mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(tail_mask, data + i), shift_vec), scale_vec));
+    _mm512_mask_storeu_ps(data + i, tail_mask, value);
+    sum_vec = _mm512_mask_add_ps(sum_vec, tail_mask, sum_vec, value);
+    return _mm512_reduce_add_ps(sum_vec);
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+void multiply_avx512(float* data, size_t size, float multiplier) {
+    const __m512 multiplier_vec = _mm512_set1_ps(multiplier);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), multiplier_vec));
+    }
+    const __mmask16 tail_mask = static_cast<__mmask16>((1u << (size - i)) - 1);
+    _mm512_mask_storeu_ps(data + i, tail_mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail_mask, data + i), multiplier_vec));
+}
+
+
+LOGIT_KERNELS_TARGET("avx2,fma")
+size_t find_block_avx2(const float* data, size_t begin, size_t end, float threshold, uint32_t& mask) {
+    const __m256 threshold_vec = _mm256_set1_ps(threshold);
+    for (; begin + BLOCK_SIZE <= end; begin += BLOCK_SIZE) {
+        const uint32_t low = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + begin), threshold_vec, _CMP_GE_OQ));
+        const uint32_t high = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + begin + 8), threshold_vec, _CMP_GE_OQ));
+        mask = low | (high << 8);
+        if (mask != 0)
+            return begin;
+    }
+    return end;
+}
+
+LOGIT_KERNELS_TARGET("avx2,fma")
+void masses_above_avx2(const float* data, size_t size, const float* thresholds, double* masses) {
+    __m256 mass_vecs[NUM_MASS_THRESHOLDS], threshold_vecs[NUM_MASS_THRESHOLDS];
+    for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+        mass_vecs[t] = _mm256_setzero_ps();
+        threshold_vecs[t] = _mm256_set1_ps(thresholds[t]);
+    }
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256 value = _mm256_loadu_ps(data + i);
+        for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+            const __m256 above = _mm256_cmp_ps(value, threshold_vecs[t], _CMP_GE_OQ);
+            mass_vecs[t] = _mm256_add_ps(mass_vecs[t], _mm256_and_ps(above, value));
+        }
+    }
+    masses_above_scalar(data + i, size - i, thresholds, masses);
+    for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, mass_vecs[t]);
+        for (float lane : lanes) {
+            masses[t] += lane;
+        }
+    }
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+size_t find_block_avx512(const float* data, size_t begin, size_t end, float threshold, uint32_t& mask) {
+    const __m512 threshold_vec = _mm512_set1_ps(threshold);
+    for (; begin + BLOCK_SIZE <= end; begin += BLOCK_SIZE) {
+        mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(data + begin), threshold_vec, _CMP_GE_OQ);
+        if (mask != 0)
+            return begin;
+    }
+    return end;
+}
+
+LOGIT_KERNELS_TARGET("avx512f")
+void masses_above_avx512(const float* data, size_t size, const float* thresholds, double* masses) {
+    __m512 mass_vecs[NUM_MASS_THRESHOLDS], threshold_vecs[NUM_MASS_THRESHOLDS];
+    for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+        mass_vecs[t] = _mm512_setzero_ps();
+        threshold_vecs[t] = _mm512_set1_ps(thresholds[t]);
+    }
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m512 value = _mm512_loadu_ps(data + i);
+        for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+            const __mmask16 above = _mm512_cmp_ps_mask(value, threshold_vecs[t], _CMP_GE_OQ);
+            mass_vecs[t] = _mm512_mask_add_ps(mass_vecs[t], above, mass_vecs[t], value);
+        }
+    }
+    masses_above_scalar(data + i, size - i, thresholds, masses);
+    for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+        masses[t] += _mm512_reduce_add_ps(mass_vecs[t]);
+    }
+}
+
+#endif  // LOGIT_KERNELS_X86
+
+float max(const float* data, size_t size) {
+    switch (get_isa()) {
+#ifdef LOGIT_KERNELS_X86
+    case Isa::AVX512:
+        return max_avx512(data, size);
+    case Isa::AVX2:
+        return max_avx2(data, size);
+#endif
+    default:
+        return max_scalar(data, size);
+    }
+}
+
+float exp_and_sum(float* data, size_t size, float shift, float scale) {
+    switch (get_isa()) {
+#ifdef LOGIT_KERNELS_X86
+    case Isa::AVX512:
+        return exp_and_sum_avx512(data, size, shift, scale);
+    case Isa::AVX2:
+        return exp_and_sum_avx2(data, size, shift, scale);
+#endif
+    default:
+        return exp_and_sum_scalar(data, size, shift, scale);
+    }
+}
+
+void multiply(float* data, size_t size, float multiplier) {
+    switch (get_isa()) {
+#ifdef LOGIT_KERNELS_X86
+    case Isa::AVX512:
+        return multiply_avx512(data, size, multiplier);
+    case Isa::AVX2:
+        return multiply_avx2(data, size, multiplier);
+#endif
+    default:
+        return multiply_scalar(data, size, multiplier);
+    }
+}
+
+size_t find_block(const float* data, size_t begin, size_t end, float threshold, uint32_t& mask) {
+    switch (get_isa()) {
+#ifdef LOGIT_KERNELS_X86
+    case Isa::AVX512:
+        return find_block_avx512(data, begin, end, threshold, mask);
+    case Isa::AVX2:
+        return find_block_avx2(data, begin, end, threshold, mask);
+#endif
+    default:
+        return find_block_scalar(data, begin, end, threshold, mask);
+    }
+}
+
+void masses_above(const float* data, size_t size, const float* thresholds, double* masses) {
+    std::fill(masses, masses + NUM_MASS_THRESHOLDS, 0.0);
+    switch (get_isa()) {
+#ifdef LOGIT_KERNELS_X86
+    case Isa::AVX512:
+        return masses_above_avx512(data, size, thresholds, masses);
+    case Isa::AVX2:
+        return masses_above_avx2(data, size, thresholds, masses);
+#endif
+    default:
+        return masses_above_scalar(data, size, thresholds, masses);
+    }
+}
+
+// Descending order of values, ties are resolved in favor of smaller indices
+struct Greater {
+    bool operator()(const Token& lhs, const Token& rhs) const {
+        return lhs.m_log_prob > rhs.m_log_prob || (lhs.m_log_prob == rhs.m_log_prob && lhs.m_index < rhs.m_index);
+    }
+};
+
+/**
+ * Appends the values not less than `threshold` to `tokens`. `on_append` is called after each append and may raise
+ * the threshold, the rest of the data is filtered with the new one.
+ */
+template <typename F>
+void gather(const float* data, size_t size, float threshold, std::vector<Token>& tokens, F&& on_append) {
+    const size_t blocks_end = size - size % BLOCK_SIZE;
+    uint32_t mask = 0;
+    for (size_t block = find_block(data, 0, blocks_end, threshold, mask); block < blocks_end;
+         block = find_block(data, block + BLOCK_SIZE, blocks_end, threshold, mask)) {
+        for (; mask != 0; mask &= mask - 1) {
+            size_t index = block;
+            for (uint32_t bits = mask; (bits & 1) == 0; bits >>= 1) {
+                ++index;
+            }
+            if (data[index] >= threshold) {
+                tokens.emplace_back(data[index], index);
+                threshold = on_append(threshold);
+            }
+        }
+    }
+    for (size_t i = blocks_end; i < size; ++i) {
+        if (data[i] >= threshold) {
+            tokens.emplace_back(data[i], i);
+            threshold = on_append(threshold);
+        }
+    }
+}
+
+void gather_all(const float* data, size_t size, std::vector<Token>& tokens) {
+    tokens.clear();
+    tokens.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        tokens.emplace_back(data[i], i);
+    }
+}
+
+// Sorts the tokens and keeps the smallest prefix with the sum exceeding top_p. As the nucleus is usually small,
+// the tokens are sorted incrementally by growing chunks.
+bool cut_nucleus(std::vector<Token>& tokens, float top_p) {
+    float probability_sum = 0.0f;
+    for (size_t sorted = 0, chunk_end = 16; sorted < tokens.size(); chunk_end *= 4) {
+        if (chunk_end * 4 > tokens.size()) {
+            chunk_end = tokens.size();
+            std::sort(tokens.begin() + sorted, tokens.end(), Greater());
+        } else {
+            std::partial_sort(tokens.begin() + sorted, tokens.begin() + chunk_end, tokens.end(), Greater());
+        }
+        for (; sorted < chunk_end; ++sorted) {
+            probability_sum += tokens[sorted].m_log_prob;
+            if (probability_sum > top_p) {
+                tokens.resize(sorted + 1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Below this size the whole buffer is simply sorted
+constexpr size_t MIN_SIZE_FOR_SELECTION = 1024;
+
+/**
+ * Estimates the starting top-k threshold from an evenly strided sample of the data. The sample rank is taken with
+ * a margin, so that at least top_k values are expected to be not less than the estimate.
+ */
+float estimate_top_k_threshold(const float* data, size_t size, size_t top_k) {
+    constexpr size_t NUM_SAMPLES = 1024, MIN_RANK_MARGIN = 8;
+    const size_t stride = size / NUM_SAMPLES;
+    const size_t rank = 2 * top_k * NUM_SAMPLES / size + MIN_RANK_MARGIN;
+    if (stride == 0 || rank >= NUM_SAMPLES)
+        return -std::numeric_limits<float>::infinity();
+
+    float samples[NUM_SAMPLES];
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+        samples[i] = data[i * stride];
+    }
+    std::nth_element(samples, samples + rank, samples + NUM_SAMPLES, std::greater<float>());
+    return samples[rank];
+}
+
+}  // namespace
+
+void softmax(float* data, size_t size, float temperature) {
+    const float max_value = max(data, size);
+    const float norm_sum = exp_and_sum(data, size, max_value, 1.0f / temperature);
+    multiply(data, size, 1.0f / norm_sum);
+}
+
+void select_top_k(const float* data, size_t size, size_t top_k, std::vector<Token>& tokens) {
+    if (top_k == 0) {
+        tokens.clear();
+        return;
+    }
+    if (top_k >= size || size <= MIN_SIZE_FOR_SELECTION) {
+        gather_all(data, size, tokens);
+        top_k = std::min(top_k, size);
+        std::partial_sort(tokens.begin(), tokens.begin() + top_k, tokens.end(), Greater());
+        tokens.resize(top_k);
+        return;
+    }
+
+    // Candidates are collected until the buffer is full, then the buffer is shrunk to top_k best ones and
+    // the threshold is raised to the smallest of them, so most of the data is skipped by a single comparison
+    const size_t capacity = std::max(2 * top_k, MIN_SIZE_FOR_SELECTION);
+    tokens.clear();
+    tokens.reserve(capacity);
+    auto shrink = [&](float threshold) {
+        if (tokens.size() < capacity)
+            return threshold;
+        std::nth_element(tokens.begin(), tokens.begin() + (top_k - 1), tokens.end(), Greater());
+        tokens.resize(top_k);
+        return tokens[top_k - 1].m_log_prob;
+    };
+    gather(data, size, estimate_top_k_threshold(data, size, top_k), tokens, shrink);
+    if (tokens.size() < top_k) {
+        // the estimate was too optimistic
+        tokens.clear();
+        gather(data, size, -std::numeric_limits<float>::infinity(), tokens, shrink);
+    }
+
+    if (tokens.size() > top_k) {
+        std::nth_element(tokens.begin(), tokens.begin() + (top_k - 1), tokens.end(), Greater());
+        tokens.resize(top_k);
+    }
+    std::sort(tokens.begin(), tokens.end(), Greater());
+}
+
+void select_top_p(const float* data, size_t size, float top_p, std::vector<Token>& tokens) {
+    const float max_value = size > MIN_SIZE_FOR_SELECTION ? max(data, size) : 0.0f;
+    if (max_value > 0.0f) {
+        // the mass above a few cutoffs is computed in a single pass, then only the tokens above the highest
+        // cutoff with enough mass are gathered and sorted
+        float thresholds[NUM_MASS_THRESHOLDS];
+        double masses[NUM_MASS_THRESHOLDS];
+        thresholds[0] = max_value;
+        for (size_t t = 1; t < NUM_MASS_THRESHOLDS; ++t) {
+            thresholds[t] = thresholds[t - 1] * MASS_THRESHOLD_STEP;
+        }
+        masses_above(data, size, thresholds, masses);
+
+        for (size_t t = 0; t < NUM_MASS_THRESHOLDS; ++t) {
+            if (masses[t] > top_p) {
+                tokens.clear();
+                gather(data, size, thresholds[t], tokens, [](float threshold) { return threshold; });
+                // the cutoff mass is summed in a different order than the nucleus, so in a rare case of rounding
+                // mismatch the nucleus is searched among all tokens
+                if (cut_nucleus(tokens, top_p))
+                    return;
+                break;
+            }
+        }
+    }
+    gather_all(data, size, tokens);
+    cut_nucleus(tokens, top_p);
+}
+
+}  // namespace LogitKernels
@@ -0,0 +1,41 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Token;
+
+/**
+ * @brief Kernels operating on the whole vocabulary for the logit transformers.
+ * Passes over the data use AVX-512 or AVX2 when the CPU supports them, with a scalar fallback otherwise. Top-k and
+ * top-p selections copy and sort only the tokens above a threshold instead of the full vocabulary: top-k raises the
+ * threshold while scanning, top-p takes it from a histogram of probability mass over a few cutoffs.
+ */
+namespace LogitKernels {
+
+/**
+ * Replaces the logits with softmax(logits / temperature).
+ * @param data Logits buffer of the size `size`.
+ * @param temperature Temperature, must be positive.
+ */
+void softmax(float* data, size_t size, float temperature);
+
+/**
+ * Selects `top_k` largest values.
+ * @param tokens Output: the selected values with their indices in the descending order of values.
+ */
+void select_top_k(const float* data, size_t size, size_t top_k, std::vector<Token>& tokens);
+
+/**
+ * Selects the smallest set of largest probabilities, which sum exceeds `top_p`. If the whole buffer sum does not
+ * exceed `top_p`, all values are selected.
+ * @param data Probabilities buffer of the size `size`.
+ * @param tokens Output: the selected probabilities with their indices in the descending order of probabilities.
+ */
+void select_top_p(const float* data, size_t size, float top_p, std::vector<Token>& tokens);
+
+}  // namespace LogitKernels
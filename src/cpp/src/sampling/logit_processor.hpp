@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "openvino/genai/generation_config.hpp"
+#include "sampling/logit_kernels.hpp"
 
 struct Token {
     float m_log_prob = 0.;
@@ -58,46 +59,11 @@ class TopPFilter : public ILogitTransformer {
 public:
     TopPFilter(double top_p) : m_top_p(top_p) {}
 
-    bool partial_sort_and_resize(Logits& logits) {
-        // Since most of the time huge part of logits vector contains minimal values 
-        // expensive sorting of entire vector might be unnecessary, especially for low values of top_p. 
-        // This method partially sorts vector finding M top elements and stops when top_p condition is met.
-        // It iterates a few times starting with M = 16 and multiplying it by 2 each iteration until M = 1024.
-        // If top_p is found in considered scope it resizes logits vector and returns true. Otherwise it returns false.
-        // Note that it can we less performant than standard approach if logits value are more evenly distributed across the vector.
-        for (size_t step = 16; step <= 1024; step *= 2) {
-            if (logits.m_vector.size() <= step)
-                break;
-            std::partial_sort(logits.m_vector.begin(), logits.m_vector.begin() + step, logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
-            float sum = 0.0;
-            for (int i = 0; i < step; i++) {
-                sum += logits.m_vector[i].m_log_prob;
-                if (sum > m_top_p) {
-                    logits.resize(i+1);
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-
-    void full_sort_and_resize(Logits& logits) {
-        std::sort(logits.m_vector.begin(), logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
-        float probability_sum = 0.0f;
-        size_t nucleus_size = 0;
-        for (const auto& logit : logits.m_vector) {
-            probability_sum += logit.m_log_prob;
-            nucleus_size += 1;
-            if (probability_sum > m_top_p) break;
-        }
-        logits.resize(nucleus_size);
-    }
-
     void apply(Logits& logits) override {
-        // Initialize and sort vector. Try partial sorting first and if it's not enough, sort entire vector.
-        logits.initialize_vector();
-        if(!partial_sort_and_resize(logits))
-            full_sort_and_resize(logits);
+        // Only the tokens above the histogram-based probability cutoff are copied and sorted, see LogitKernels
+        OPENVINO_ASSERT(!logits.is_vector_initialized(), "Logits vector already initialized");
+        LogitKernels::select_top_p(logits.m_data, logits.m_size, m_top_p, logits.m_vector);
+        logits.m_size = logits.m_vector.size();
     }
 
 protected:
@@ -116,9 +82,8 @@ public:
         
         // If top_p is also used vector is already initialized and sorted
         if (!logits.is_vector_initialized()) {
-            // Initialize and partially sort vector
-            logits.initialize_vector();
-            std::partial_sort(logits.m_vector.begin(), logits.m_vector.begin() + m_top_k, logits.m_vector.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
+            // Select top_k tokens without copying the entire vocabulary
+            LogitKernels::select_top_k(logits.m_data, logits.m_size, m_top_k, logits.m_vector);
         }
         logits.resize(m_top_k);
     }
@@ -132,22 +97,7 @@ public:
     TemperatureLogitTransform(double temperature) : m_temperature(temperature) {};
 
     void apply(Logits& logits) override {
-        float max_logit = -std::numeric_limits<float>::infinity();
-        for (size_t i = 0; i < logits.m_size; i++) {
-            if (logits.m_data[i] > max_logit) {
-                max_logit = logits.m_data[i];
-            }
-        }
-
-        float norm_sum = 0.0;
-        for (size_t i = 0; i < logits.m_size; i++) {
-            logits.m_data[i] = expf((logits.m_data[i] - max_logit) / this->m_temperature);
-            norm_sum += logits.m_data[i];
-        }
-
-        for (size_t i = 0; i < logits.m_size; i++) {
-            logits.m_data[i] /= norm_sum;
-        }
+        LogitKernels::softmax(logits.m_data, logits.m_size, m_temperature);
     }
 
 protected:
@@ -305,14 +255,159 @@ public:
 };
 
 
+/**
+ * @brief Occurrences of tokens in the prompt and in the generated text, shared by the penalty transform and
+ * the LogitProcessor which updates it after each step. Entries are stored contiguously and located through an open
+ * addressing hash index, so registering a token is O(1) and penalties are applied by a linear pass over the entries.
+ */
+class TokenOccurrences {
+public:
+    struct Entry {
+        int64_t token_id;
+        size_t generated_count = 0;
+        bool in_prompt = false;
+        // stays set when the count drops to zero after a rollback, as the token was generated before
+        bool generated = false;
+    };
+
+    void add_prompt_token(int64_t token_id) {
+        get_or_insert(token_id).in_prompt = true;
+    }
+
+    void add_generated_token(int64_t token_id) {
+        Entry& entry = get_or_insert(token_id);
+        entry.generated = true;
+        ++entry.generated_count;
+    }
+
+    void remove_generated_token(int64_t token_id) {
+        const size_t entry_idx = find(token_id);
+        OPENVINO_ASSERT(entry_idx < m_entries.size() && m_entries[entry_idx].generated);
+        --m_entries[entry_idx].generated_count;
+    }
+
+    const std::vector<Entry>& get_entries() const {
+        return m_entries;
+    }
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Entry> m_entries;
+    // indices of m_entries, capacity is a power of two and at least twice the number of entries
+    std::vector<uint32_t> m_slots;
+
+    size_t get_slot(int64_t token_id) const {
+        // Fibonacci hashing spreads consecutive token ids over the table
+        return static_cast<size_t>((static_cast<uint64_t>(token_id) * 0x9E3779B97F4A7C15ull) >> 32) & (m_slots.size() - 1);
+    }
+
+    size_t find(int64_t token_id) const {
+        if (m_slots.empty())
+            return m_entries.size();
+        for (size_t slot = get_slot(token_id); m_slots[slot] != EMPTY_SLOT; slot = (slot + 1) & (m_slots.size() - 1)) {
+            if (m_entries[m_slots[slot]].token_id == token_id)
+                return m_slots[slot];
+        }
+        return m_entries.size();
+    }
+
+    void rehash(size_t capacity) {
+        m_slots.assign(capacity, EMPTY_SLOT);
+        for (size_t entry_idx = 0; entry_idx < m_entries.size(); ++entry_idx) {
+            size_t slot = get_slot(m_entries[entry_idx].token_id);
+            while (m_slots[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & (m_slots.size() - 1);
+            }
+            m_slots[slot] = static_cast<uint32_t>(entry_idx);
+        }
+    }
+
+    Entry& get_or_insert(int64_t token_id) {
+        const size_t entry_idx = find(token_id);
+        if (entry_idx < m_entries.size())
+            return m_entries[entry_idx];
+
+        m_entries.push_back(Entry{token_id});
+        if (m_entries.size() * 2 > m_slots.size()) {
+            rehash(std::max<size_t>(64, m_slots.size() * 2));
+        } else {
+            size_t slot = get_slot(token_id);
+            while (m_slots[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & (m_slots.size() - 1);
+            }
+            m_slots[slot] = static_cast<uint32_t>(m_entries.size() - 1);
+        }
+        return m_entries.back();
+    }
+};
+
+/**
+ * @brief Applies repetition, presence and frequency penalties in a single pass over the occurred tokens.
+ * The result is the same as applying RepetitionPenaltyTransform, PresencePenaltyTransform and FrequencyPenaltyTransform
+ * one after another.
+ */
+class PenaltyTransform : public ILogitTransformer {
+public:
+    PenaltyTransform(double repetition_penalty, double presence_penalty, double frequency_penalty,
+                     const std::shared_ptr<TokenOccurrences>& token_occurrences) :
+        m_repetition_penalty(repetition_penalty),
+        m_presence_penalty(presence_penalty),
+        m_frequency_penalty(frequency_penalty),
+        m_token_occurrences(token_occurrences) {}
+
+    void apply(Logits& logits) override {
+        const bool apply_repetition_penalty = m_repetition_penalty != 1.0f;
+        const bool apply_presence_penalty = m_presence_penalty != 0.0f;
+        const bool apply_frequency_penalty = m_frequency_penalty != 0.0f;
+
+        for (const auto& entry : m_token_occurrences->get_entries()) {
+            const bool apply_repetition = apply_repetition_penalty && (entry.in_prompt || entry.generated);
+            if (!apply_repetition && !entry.generated)
+                continue;
+            OPENVINO_ASSERT((entry.token_id >= 0) && (entry.token_id < logits.m_size), "input_ids token out of bounds");
+
+            float& logit = logits.m_data[entry.token_id];
+            if (apply_repetition) {
+                if (logit >= 0) {
+                    logit /= m_repetition_penalty;
+                } else {
+                    logit *= m_repetition_penalty;
+                }
+            }
+            if (apply_presence_penalty && entry.generated) {
+                if (logit >= 0) {
+                    logit -= m_presence_penalty;
+                } else {
+                    logit += m_presence_penalty;
+                }
+            }
+            if (apply_frequency_penalty && entry.generated) {
+                if (logit >= 0) {
+                    logit -= m_frequency_penalty * entry.generated_count;
+                } else {
+                    logit += m_frequency_penalty * entry.generated_count;
+                }
+            }
+        }
+    }
+
+protected:
+    double m_repetition_penalty;
+    double m_presence_penalty;
+    double m_frequency_penalty;
+    std::shared_ptr<TokenOccurrences> m_token_occurrences;
+};
+
+
 } // namespace LogitTransformers
 
 class LogitProcessor {
 protected:
     std::vector<std::shared_ptr<LogitTransformers::ILogitTransformer>> m_logit_transformers;
     
-    std::shared_ptr<std::map<int64_t, size_t>> m_unique_generated_token_ids = std::shared_ptr<std::map<int64_t, size_t>>(new std::map<int64_t, size_t>);
-    std::shared_ptr<std::set<int64_t>> m_unique_prompt_token_ids = std::shared_ptr<std::set<int64_t>>(new std::set<int64_t>);
+    // shared between copies of the processor, which are used to sample in parallel
+    std::shared_ptr<LogitTransformers::TokenOccurrences> m_token_occurrences = std::make_shared<LogitTransformers::TokenOccurrences>();
     size_t m_generated_tokens = 0;
 
     // speculative decoding parameters
@@ -322,8 +417,11 @@ protected:
 public:
     LogitProcessor(const ov::genai::GenerationConfig& sampling_params,
                    const LogitTransformers::TokenIds& input_ids) {
-        for (const auto& input_id : input_ids) {
-            m_unique_prompt_token_ids->insert(input_id);
+        // prompt tokens are only penalized by the repetition penalty
+        if (sampling_params.repetition_penalty != 1.0f) {
+            for (const auto& input_id : input_ids) {
+                m_token_occurrences->add_prompt_token(input_id);
+            }
         }
 
         if (sampling_params.min_new_tokens > 0) {
@@ -333,25 +431,9 @@ public:
         }
 
         if (sampling_params.is_multinomial() || sampling_params.is_greedy_decoding()) {
-            if (sampling_params.repetition_penalty != 1.0f) {
-                std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform>(new LogitTransformers::RepetitionPenaltyTransform(sampling_params.repetition_penalty));
-                transformer->set_unique_prompt_token_ids(m_unique_prompt_token_ids);
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-            }
-            if (sampling_params.presence_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::PresencePenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::PresencePenaltyTransform>(new LogitTransformers::PresencePenaltyTransform(sampling_params.presence_penalty)); 
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-                
-            }
-            if (sampling_params.frequency_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform>(new LogitTransformers::FrequencyPenaltyTransform(sampling_params.frequency_penalty));
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
+            if (sampling_params.repetition_penalty != 1.0f || sampling_params.presence_penalty != 0.0f || sampling_params.frequency_penalty != 0.0f) {
+                m_logit_transformers.emplace_back(new LogitTransformers::PenaltyTransform(
+                    sampling_params.repetition_penalty, sampling_params.presence_penalty, sampling_params.frequency_penalty, m_token_occurrences));
             }
 
             if (sampling_params.is_multinomial()) {
@@ -390,17 +472,11 @@ public:
     }
 
     void register_new_generated_token(int64_t new_token_id) {
-        auto it = m_unique_generated_token_ids->find(new_token_id);
-        if (it == m_unique_generated_token_ids->end()) {
-            m_unique_generated_token_ids->insert({new_token_id, 1});
-        } else {
-            it->second++;
-        }
+        m_token_occurrences->add_generated_token(new_token_id);
     }
 
     void decrease_generated_token_occurance(int64_t token_id) {
-        OPENVINO_ASSERT(m_unique_generated_token_ids->count(token_id) > 0);
-        m_unique_generated_token_ids->at(token_id)--;
+        m_token_occurrences->remove_generated_token(token_id);
     }
 
 };
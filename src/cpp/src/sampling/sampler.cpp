@@ -1,9 +1,8 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
-#include <future>
-
 #include "sampling/sampler.hpp"
+#include "tokenizer/token_bytes.hpp"
 
 namespace ov::genai {
 // Modified Knuth–Morris–Pratt algorithm which returns tokens following after every needle occurrence in haystack
@@ -97,13 +96,6 @@ std::vector<int64_t> encode_and_process_string(const std::string& stop_string, o
     return encoded_stop_string;
 }
 
-struct MatchStopStringResult {
-    size_t to_remove = 0;
-    // int64_t last_token_id = 0;
-    // bool is_to_update_last_token = false;
-    bool is_matched = false;
-};
-
 // Return number of last tokens that match one of the stop_strings. If there's no match 0 is returned.
 MatchStopStringResult match_stop_string(Tokenizer& tokenizer,
                       const TokenIds& generated_tokens,
@@ -572,10 +564,14 @@ std::vector<int64_t> Sampler::_try_finish_generation(SequenceGroup::Ptr & sequen
             continue;
         }
 
-        if (!sampling_params.stop_strings.empty()) {
-            auto& stop_strings = m_stop_strings.at(sequence_group->get_request_id());
-            auto match_result = match_stop_string(m_tokenizer, running_sequence->get_generated_ids(), stop_strings,
-                                                  sampling_params.include_stop_str_in_output, sequence_group->get_num_tokens_to_validate());
+        if (!sampling_params.stop_strings.empty() && !m_is_postprocessing_deferred) {
+            const auto request_id = sequence_group->get_request_id();
+            const auto& stop_string_matcher = m_stop_string_matchers.at(request_id);
+            auto match_result = stop_string_matcher ?
+                stop_string_matcher->match(running_sequence->get_generated_ids(), sampling_params.include_stop_str_in_output,
+                                           sequence_group->get_num_tokens_to_validate()) :
+                match_stop_string(m_tokenizer, running_sequence->get_generated_ids(), m_stop_strings.at(request_id),
+                                  sampling_params.include_stop_str_in_output, sequence_group->get_num_tokens_to_validate());
             if (match_result.is_matched) {
                 running_sequence->remove_last_tokens(match_result.to_remove);
 
@@ -741,18 +737,33 @@ float get_p_prime(Sequence::Ptr& running_sequence,
 }
 
 std::pair<size_t, std::set<std::string>>
-process_stop_strings(const std::set<std::string>& stop_strings, Tokenizer& tokenizer) {
+process_stop_strings(const std::set<std::string>& stop_strings, Tokenizer& tokenizer,
+                     const StopStringMatcher::TokenTexts& token_texts, StopStringMatcher::Ptr& stop_string_matcher) {
     std::pair<size_t, std::set<std::string>> result;
+    // the matcher replaces the detokenizer only if the vocabulary reproduces every stop string exactly
+    bool is_matcher_applicable = token_texts != nullptr;
     for (const auto& stop_string : stop_strings) {
         auto encoded_stop_string = encode_and_process_string(stop_string, tokenizer);
         if (result.first < encoded_stop_string.size()) {
             result.first = encoded_stop_string.size();
         }
         result.second.insert(stop_string);
+        is_matcher_applicable = is_matcher_applicable && !stop_string.empty() &&
+            StopStringMatcher::is_applicable(*token_texts, stop_string, encoded_stop_string);
+    }
+    stop_string_matcher = nullptr;
+    if (is_matcher_applicable && !result.second.empty()) {
+        stop_string_matcher = std::make_shared<StopStringMatcher>(token_texts, result.second, result.first);
     }
     return result;
 }
 
+StopStringMatcher::TokenTexts Sampler::get_token_texts() {
+    // texts of the skipped special tokens are empty, nullptr if the vocabulary doesn't reproduce decoded text,
+    // e.g. because of SentencePiece meta symbols or detokenizer post-processing
+    return get_token_bytes(m_tokenizer);
+}
+
 SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr sequence_group, ov::Tensor sequence_group_logits, 
                                                               LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings, 
                                                               bool is_validation_mode_enabled) {
@@ -773,12 +784,19 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
     if (sampling_params.is_greedy_decoding() || sampling_params.is_multinomial()) {
         std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
         size_t num_running_sequences = sequence_group->num_running_seqs();
+        // several greedy sequences are candidate branches proposed by prompt lookup, each of them is validated
+        // independently and only the one with the most accepted tokens is kept
+        const bool is_branch_validation = is_validation_mode_enabled && sampling_params.is_greedy_decoding() && num_running_sequences > 1;
         if (sampling_params.is_greedy_decoding()) {
-            OPENVINO_ASSERT(num_running_sequences == 1);
+            OPENVINO_ASSERT(num_running_sequences == 1 || is_branch_validation);
         }
+        // tokens registered in the logit processor and number of removed candidates per branch
+        std::vector<std::vector<int64_t>> branch_registered_tokens(is_branch_validation ? num_running_sequences : 0);
+        std::vector<size_t> branch_removed_tokens(is_branch_validation ? num_running_sequences : 0, 0);
         for (size_t running_sequence_id = 0; running_sequence_id < num_running_sequences; ++running_sequence_id) {
             auto& running_sequence = running_sequences[running_sequence_id];
             bool is_validation_passed = true;
+            size_t& max_removed_tokens = is_branch_validation ? branch_removed_tokens[running_sequence_id] : assisting_pipeline_info.max_removed_tokens_per_request;
             // make `num_tokens_to_process` iteration to validate a candidate generated by `draft_model` + 1 iteration to generate one more token by `main_model`
             for (size_t i = 0; i <= num_tokens_to_process; ++i) {
                 if (running_sequence->has_finished())
@@ -792,7 +810,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                 OPENVINO_ASSERT(sequence_group->get_max_new_tokens() >= generated_and_verified_len);
                 size_t max_num_sampled_token = sequence_group->get_max_new_tokens() - generated_and_verified_len;
                 if (max_num_sampled_token == 0) {
-                    stop_sample_tokens(running_sequence, token_offset, max_num_sampled_token, assisting_pipeline_info.max_removed_tokens_per_request);
+                    stop_sample_tokens(running_sequence, token_offset, max_num_sampled_token, max_removed_tokens);
                     break;
                 }
                 
@@ -826,7 +844,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                     // make `_speculative_sampling` in case of previous token was not accepted in speculative decoding
                     if (!is_validation_passed) {
                         float p_prime = get_p_prime(running_sequence, sampled_token, token_offset + 1);
-                        assisting_pipeline_info.max_removed_tokens_per_request = std::max(assisting_pipeline_info.max_removed_tokens_per_request, token_offset);
+                        max_removed_tokens = std::max(max_removed_tokens, token_offset);
                         // update prob only in case candidate prob > sampled token prob
                         if (p_prime > 0.f) {
                             auto prob = std::exp(sampled_token.m_log_prob);
@@ -839,7 +857,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                 bool is_extend_sequence = token_offset == 0 || is_generate_n_tokens || !is_validation_passed;
                 if (is_validation_mode_enabled && !is_extend_sequence) {
                     is_validation_passed = validate_candidate(running_sequences[running_sequence_id], token_offset, sampled_token,
-                                                                is_extend_sequence, assisting_pipeline_info.max_removed_tokens_per_request, sampling_params.do_sample);
+                                                                is_extend_sequence, max_removed_tokens, sampling_params.do_sample);
                     // doing resample in case of non accepted tokens in specualtive sampling
                     if (!is_validation_passed && sampling_params.do_sample) {
                         continue;
@@ -851,6 +869,9 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                     }
                 }
                 register_new_token(sampled_token, running_sequences[running_sequence_id], logit_processor, is_extend_sequence, is_validation_mode_enabled);
+                if (is_branch_validation) {
+                    branch_registered_tokens[running_sequence_id].push_back(sampled_token.m_index);
+                }
                 // to exit from sampling in case of failed token validation
                 if (!is_validation_passed) {
                     break;
@@ -863,7 +884,37 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                     }
                 }
             }
-            assisting_pipeline_info.min_generated_len = std::min(assisting_pipeline_info.min_generated_len, running_sequence->get_generated_len());
+            if (is_branch_validation) {
+                // penalties for the next branch must not see tokens of this one, tokens of the kept branch are registered again
+                for (int64_t token_id : branch_registered_tokens[running_sequence_id]) {
+                    logit_processor.decrease_generated_token_occurance(token_id);
+                }
+            } else {
+                assisting_pipeline_info.min_generated_len = std::min(assisting_pipeline_info.min_generated_len, running_sequence->get_generated_len());
+            }
+        }
+        if (is_branch_validation) {
+            size_t best_branch_id = 0;
+            for (size_t branch_id = 1; branch_id < num_running_sequences; ++branch_id) {
+                if (branch_registered_tokens[branch_id].size() > branch_registered_tokens[best_branch_id].size()) {
+                    best_branch_id = branch_id;
+                }
+            }
+            for (int64_t token_id : branch_registered_tokens[best_branch_id]) {
+                logit_processor.register_new_generated_token(token_id);
+            }
+            for (size_t branch_id = 0; branch_id < num_running_sequences; ++branch_id) {
+                const auto& branch = running_sequences[branch_id];
+                if (branch_id == best_branch_id)
+                    continue;
+                // finished branches have already been dropped
+                if (!branch->has_finished()) {
+                    sg_sampling_info.sampler_output.m_dropped_sequences.push_back(branch->get_id());
+                }
+                sequence_group->remove_sequence(branch->get_id());
+            }
+            assisting_pipeline_info.max_removed_tokens_per_request = std::max(assisting_pipeline_info.max_removed_tokens_per_request, branch_removed_tokens[best_branch_id]);
+            assisting_pipeline_info.min_generated_len = running_sequences[best_branch_id]->get_generated_len();
         }
         align_all_sequence_len(sequence_group, assisting_pipeline_info.min_generated_len, logit_processor);
         for (const auto& dropped_seq_id : _try_finish_generation(sequence_group)) {
@@ -896,7 +947,9 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
     // Notify handle after sampling is done. 
     // For non-streaming this is effective only when the generation is finished.
     OPENVINO_ASSERT(num_tokens_to_process >= assisting_pipeline_info.max_removed_tokens_per_request);
-    sequence_group->notify_handle();
+    if (!m_is_postprocessing_deferred) {
+        sequence_group->notify_handle();
+    }
     return sg_sampling_info;
 }
 
@@ -909,7 +962,15 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
     size_t vocab_size = logits_shape[2];
 
     SamplerOutput sampler_output;
-    std::unordered_map<uint64_t, std::future<SequenceGroupSamplingInfo>> sg_sampling_future_map;
+    struct SamplingTask {
+        SequenceGroup::Ptr sequence_group;
+        ov::Tensor logits;
+        // sampling works on a copy of the logit processor, token statistics are shared between the copies
+        LogitProcessor logit_processor;
+        const std::pair<size_t, std::set<std::string>>* stop_strings;
+    };
+    std::vector<SamplingTask> sampling_tasks;
+    sampling_tasks.reserve(sequence_groups.size());
     for (size_t sequence_group_id = 0, currently_processed_tokens = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
         SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
         if (!sequence_group->is_scheduled())
@@ -924,8 +985,11 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
             m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids())});
         }
         if (!m_stop_strings.count(request_id)) {
-            auto processed_stop_string = process_stop_strings(sampling_params.stop_strings, m_tokenizer);
+            StopStringMatcher::Ptr stop_string_matcher;
+            auto processed_stop_string = process_stop_strings(sampling_params.stop_strings, m_tokenizer,
+                sampling_params.stop_strings.empty() ? nullptr : get_token_texts(), stop_string_matcher);
             m_stop_strings.insert({request_id, processed_stop_string});
+            m_stop_string_matchers.insert({request_id, stop_string_matcher});
             sequence_group->set_stream_window_size(processed_stop_string.first);
         }
         const auto& stop_strings = m_stop_strings.at(request_id);
@@ -933,9 +997,7 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
         const void * sequence_group_logits_data = logits_data + vocab_size * currently_processed_tokens;
         ov::Tensor sequence_group_logits(ov::element::f32, ov::Shape{num_running_sequences, output_seq_len, vocab_size}, (void *)sequence_group_logits_data);
         if (sequence_group->requires_sampling()) {
-            // Call sample_from_sequence_group asynchronously
-            sg_sampling_future_map[request_id] = m_thread_pool.submit(&Sampler::sample_from_sequence_group, this, sequence_group, sequence_group_logits,
-                                                                      logit_processor, stop_strings, is_validation_mode_enabled);
+            sampling_tasks.push_back({sequence_group, sequence_group_logits, logit_processor, &stop_strings});
         } else {
             // we are in prompt processing phase when prompt is split into chunks and processed step by step
         }
@@ -943,15 +1005,23 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
         currently_processed_tokens += output_seq_len * num_running_sequences;
     }
 
+    // Sample all sequence groups of the step as a single job
+    std::vector<SequenceGroupSamplingInfo> sg_sampling_infos(sampling_tasks.size());
+    m_thread_pool.parallel_for(sampling_tasks.size(), [&](size_t task_idx) {
+        SamplingTask& task = sampling_tasks[task_idx];
+        sg_sampling_infos[task_idx] = sample_from_sequence_group(task.sequence_group, task.logits, task.logit_processor,
+                                                                 *task.stop_strings, is_validation_mode_enabled);
+    });
+
     // Update sequence groups internal states after sampling is done
-    for (auto& sequence_group : sequence_groups) {
+    // sampling tasks follow the order of sequence groups, so their results are taken one by one
+    for (size_t sequence_group_id = 0, task_idx = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
+        const SequenceGroup::Ptr& sequence_group = sequence_groups[sequence_group_id];
         if (!sequence_group->is_scheduled())
             continue;
         SequenceGroupSamplingInfo sg_sampling_info;
-        const auto request_id = sequence_group->get_request_id();
-        if (sg_sampling_future_map.find(request_id) != sg_sampling_future_map.end()) {
-            // If there is a future assigned to a sequence group we read it's result (blocking if results not available yet)
-            sg_sampling_info = sg_sampling_future_map[request_id].get();
+        if (task_idx < sampling_tasks.size() && sampling_tasks[task_idx].sequence_group == sequence_group) {
+            sg_sampling_info = std::move(sg_sampling_infos[task_idx++]);
             sampler_output.num_generated_tokens += sg_sampling_info.sampler_output.num_generated_tokens;
 
             // Merge sampler output from sequence group to the main one
@@ -997,10 +1067,71 @@ void Sampler::create_logit_processor(uint64_t request_id, const GenerationConfig
     m_logit_processors.insert({request_id, LogitProcessor(sampling_params, prompt)});
 }
 
+std::vector<StopStringMatch> Sampler::match_stop_strings(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
+    struct MatchTask {
+        SequenceGroup::Ptr sequence_group;
+        const std::pair<size_t, std::set<std::string>>* stop_strings;
+        StopStringMatcher::Ptr stop_string_matcher;
+    };
+    std::vector<MatchTask> match_tasks;
+    for (const auto& sequence_group : sequence_groups) {
+        const ov::genai::GenerationConfig& sampling_params = sequence_group->get_sampling_parameters();
+        // beam search matches stop strings within GroupBeamSearcher
+        if (sampling_params.stop_strings.empty() || sampling_params.is_beam_search())
+            continue;
+        auto stop_strings_it = m_stop_strings.find(sequence_group->get_request_id());
+        if (stop_strings_it == m_stop_strings.end())
+            continue;
+        match_tasks.push_back({sequence_group, &stop_strings_it->second, m_stop_string_matchers.at(sequence_group->get_request_id())});
+    }
+
+    std::vector<std::vector<StopStringMatch>> group_matches(match_tasks.size());
+    m_thread_pool.parallel_for(match_tasks.size(), [&](size_t task_idx) {
+        const auto& [sequence_group, stop_strings, stop_string_matcher] = match_tasks[task_idx];
+        const bool include_stop_str_in_output = sequence_group->get_sampling_parameters().include_stop_str_in_output;
+        for (const auto& running_sequence : sequence_group->get_running_sequences()) {
+            auto match_result = stop_string_matcher ?
+                stop_string_matcher->match(running_sequence->get_generated_ids(), include_stop_str_in_output) :
+                match_stop_string(m_tokenizer, running_sequence->get_generated_ids(), *stop_strings, include_stop_str_in_output);
+            if (match_result.is_matched) {
+                group_matches[task_idx].push_back({running_sequence, match_result.to_remove, running_sequence->get_generated_len()});
+            }
+        }
+    });
+
+    std::vector<StopStringMatch> matches;
+    for (const auto& task_matches : group_matches) {
+        matches.insert(matches.end(), task_matches.begin(), task_matches.end());
+    }
+    return matches;
+}
+
+std::vector<uint64_t> Sampler::apply_stop_string_matches(const std::vector<StopStringMatch>& matches) {
+    std::vector<uint64_t> finished_seq_ids;
+    for (const auto& match : matches) {
+        const Sequence::Ptr& sequence = match.m_sequence;
+        if (sequence->out_of_memory())
+            continue;
+
+        const size_t generated_len = sequence->get_generated_len();
+        OPENVINO_ASSERT(generated_len >= match.m_generated_len, "Internal error: sequence has been shortened after stop string matching");
+        // tokens generated after the stop string have to be dropped as well
+        sequence->remove_last_tokens(match.m_num_tokens_to_remove + generated_len - match.m_generated_len);
+
+        if (sequence->is_running()) {
+            finished_seq_ids.push_back(sequence->get_id());
+        }
+        sequence->set_status(SequenceStatus::FINISHED);
+        sequence->set_finish_reason(GenerationFinishReason::STOP);
+    }
+    return finished_seq_ids;
+}
+
 void Sampler::clear_request_info(uint64_t request_id) { 
     m_beam_search_info.erase(request_id);
     m_logit_processors.erase(request_id);
     m_stop_strings.erase(request_id);
+    m_stop_string_matchers.erase(request_id);
 }
 
 int64_t Sampler::GroupBeamSearcher::Group::finish(Beam beam, const ov::genai::GenerationConfig& sampling_params) {
@@ -17,6 +17,7 @@
 #include "openvino/runtime/tensor.hpp"
 
 #include "sampling/logit_processor.hpp"
+#include "sampling/stop_string_matcher.hpp"
 #include "continuous_batching/scheduler.hpp"
 #include "sequence_group.hpp"
 #include "threadpool.hpp"
@@ -53,6 +54,15 @@ struct SamplerOutput {
     size_t num_generated_tokens = 0;
 };
 
+// Stop string found in a sequence by deferred stop strings matching
+struct StopStringMatch {
+    Sequence::Ptr m_sequence;
+    // number of last tokens to be removed from the sequence at the time of matching
+    size_t m_num_tokens_to_remove = 0;
+    // sequence generated length at the time of matching
+    size_t m_generated_len = 0;
+};
+
 struct AssistingPipelineInfo {
     size_t max_removed_tokens_per_request = 0; 
     size_t min_generated_len = std::numeric_limits<size_t>::max();
@@ -83,6 +93,8 @@ class Sampler {
                                                         LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings,
                                                         bool is_validation_mode_enabled);
 
+    StopStringMatcher::TokenTexts get_token_texts();
+
     // request ID => beam search tracking information
     std::map<uint64_t, GroupBeamSearcher> m_beam_search_info;
     std::mutex m_beam_search_info_mutex;
@@ -93,11 +105,17 @@ class Sampler {
     std::map<uint64_t, LogitProcessor> m_logit_processors;
     // { request_id, { max_encoded_len, { stop_strings }}}
     std::map<int64_t, std::pair<size_t, std::set<std::string>>> m_stop_strings;
+    // { request_id, matcher }, nullptr if stop strings have to be matched by decoding
+    std::map<int64_t, StopStringMatcher::Ptr> m_stop_string_matchers;
 
     Tokenizer m_tokenizer;
 
     ThreadPool m_thread_pool;
 
+    // if enabled, stop strings matching and handle notification are not performed within `sample`,
+    // but are expected to be done by a caller via `match_stop_strings` / `apply_stop_string_matches`
+    bool m_is_postprocessing_deferred = false;
+
 public:
     Sampler(const Sampler& rhs) = delete;
     Sampler(Sampler&& rhs) = delete;
@@ -117,6 +135,26 @@ public:
 
     void clear_request_info(uint64_t request_id);
 
+    void set_postprocessing_deferred(bool is_postprocessing_deferred) {
+        m_is_postprocessing_deferred = is_postprocessing_deferred;
+    }
+
+    /**
+     * Matches stop strings of greedy / multinomial sequence groups against the tokens generated so far, using the sampler
+     * thread pool. Sequences are not modified, so this method can be called while a next forward pass is in flight.
+     * @param sequence_groups Sequence groups to be checked
+     * @return Stop strings found in running sequences of the groups
+     */
+    std::vector<StopStringMatch> match_stop_strings(const std::vector<SequenceGroup::Ptr>& sequence_groups);
+
+    /**
+     * Finishes sequences with previously matched stop strings, removing the stop string (if it should not be included into output)
+     * together with all tokens generated after the match was found.
+     * @param matches Result of a previous `match_stop_strings` call
+     * @return IDs of sequences which were running and have been finished by this call
+     */
+    std::vector<uint64_t> apply_stop_string_matches(const std::vector<StopStringMatch>& matches);
+
     LogitProcessor& get_logit_processor(uint64_t request_id);
     void create_logit_processor(uint64_t request_id, const GenerationConfig& sampling_parameters, const TokenIds& prompt);
 
@@ -0,0 +1,223 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+struct MatchStopStringResult {
+    size_t to_remove = 0;
+    bool is_matched = false;
+};
+
+/**
+ * @brief Matches stop strings against generated tokens without detokenizer inference.
+ * Stop strings of a request are compiled into an Aho-Corasick automaton over bytes, and generated tokens are expanded
+ * to bytes via the vocabulary, so a window of tokens is scanned in a single pass over its text. The matcher is
+ * stateless with respect to sequences: every call rescans the window, which is only a few tokens long, so forked
+ * sequences and sequences rolled back by speculative decoding need no special handling.
+ *
+ * The matcher is exact only if the vocabulary entries are the bytes the detokenizer produces for the tokens, which is
+ * verified for tokens of the stop strings by `is_applicable`.
+ */
+class StopStringMatcher {
+public:
+    using Ptr = std::shared_ptr<const StopStringMatcher>;
+    using TokenTexts = std::shared_ptr<const std::vector<std::string>>;
+
+    /**
+     * @param token_texts Bytes of the tokens indexed by token id, special tokens are expected to be empty.
+     * @param stop_strings Non-empty stop strings, the first one in the set order wins if several of them are found.
+     * @param window_size Number of last tokens searched for stop strings, i.e. max encoded length of the stop strings.
+     */
+    StopStringMatcher(TokenTexts token_texts, const std::set<std::string>& stop_strings, size_t window_size)
+        : m_token_texts(std::move(token_texts)),
+          m_window_size(window_size) {
+        OPENVINO_ASSERT(m_token_texts, "Token texts are required for the stop string matcher");
+        m_nodes.emplace_back();
+        for (const auto& stop_string : stop_strings) {
+            add_pattern(stop_string);
+        }
+        build_links();
+    }
+
+    /**
+     * Checks if the token texts reproduce the text of encoded stop strings, i.e. if the vocabulary can be used instead
+     * of the detokenizer for the stop strings.
+     * @param token_texts Bytes of the tokens indexed by token id.
+     * @param stop_string Stop string.
+     * @param encoded_stop_string Token ids of the stop string.
+     */
+    static bool is_applicable(const std::vector<std::string>& token_texts, const std::string& stop_string,
+                              const std::vector<int64_t>& encoded_stop_string) {
+        std::string text;
+        for (int64_t token_id : encoded_stop_string) {
+            if (token_id < 0 || static_cast<size_t>(token_id) >= token_texts.size())
+                return false;
+            text += token_texts[token_id];
+        }
+        return text == stop_string;
+    }
+
+    /**
+     * Finds stop strings in the last tokens of a sequence. Equivalent to decoding the last `window_size` +
+     * `draft_generated_tokens` tokens and searching the text for the stop strings.
+     * @param generated_tokens Generated tokens of the sequence.
+     * @param is_include_to_output Whether the stop string is kept in the output.
+     * @param draft_generated_tokens Number of tokens added to the sequence at the current step on top of one.
+     * @return Number of last tokens to be removed from the sequence if a stop string is found.
+     */
+    MatchStopStringResult match(const std::vector<int64_t>& generated_tokens, bool is_include_to_output,
+                                size_t draft_generated_tokens = 0) const {
+        MatchStopStringResult result;
+        if (m_stop_string_lengths.empty() || generated_tokens.size() < m_window_size + draft_generated_tokens)
+            return result;
+
+        const size_t window_begin = generated_tokens.size() - m_window_size - draft_generated_tokens;
+        const size_t window_size = generated_tokens.size() - window_begin;
+        const auto& token_texts = *m_token_texts;
+
+        // position right after the first occurrence of each stop string
+        std::vector<size_t> match_ends(m_stop_string_lengths.size(), 0);
+        size_t best_pattern = m_stop_string_lengths.size();
+        // number of window bytes up to and including each token
+        std::vector<size_t> token_ends(window_size);
+        size_t node = 0, num_bytes = 0;
+        for (size_t i = 0; i < window_size; ++i) {
+            const int64_t token_id = generated_tokens[window_begin + i];
+            OPENVINO_ASSERT(token_id >= 0 && static_cast<size_t>(token_id) < token_texts.size(), "Token id ", token_id, " is out of vocabulary");
+            for (unsigned char byte : token_texts[token_id]) {
+                node = next(node, byte);
+                ++num_bytes;
+                for (size_t output = m_nodes[node].pattern != NO_PATTERN ? node : m_nodes[node].dictionary_link;
+                     output != 0;
+                     output = m_nodes[output].dictionary_link) {
+                    const size_t pattern = m_nodes[output].pattern;
+                    if (pattern < best_pattern) {
+                        best_pattern = pattern;
+                        match_ends[pattern] = num_bytes;
+                    }
+                }
+            }
+            token_ends[i] = num_bytes;
+            // the first stop string cannot be outranked by later occurrences
+            if (best_pattern == 0)
+                break;
+        }
+        if (best_pattern == m_stop_string_lengths.size())
+            return result;
+
+        result.is_matched = true;
+        const size_t stop_string_length = m_stop_string_lengths[best_pattern];
+        size_t text_length = match_ends[best_pattern] - (is_include_to_output ? 0 : stop_string_length);
+
+        // to remove word splitting symbols from tail
+        auto byte_at = [&](size_t position) {
+            size_t i = 0;
+            while (token_ends[i] <= position)
+                ++i;
+            const std::string& text = token_texts[generated_tokens[window_begin + i]];
+            return text[text.size() - (token_ends[i] - position)];
+        };
+        while (text_length > 0 && (byte_at(text_length - 1) == ' ' || byte_at(text_length - 1) == '\n')) {
+            --text_length;
+        }
+        if (text_length == 0) {
+            result.to_remove = window_size;
+            return result;
+        }
+
+        // the shortest prefix of tokens covering the text is kept
+        for (size_t i = 0; i < window_size; ++i) {
+            if (token_ends[i] >= text_length) {
+                result.to_remove = window_size - i - 1;
+                break;
+            }
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t NO_PATTERN = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        // sorted by byte, stop strings are short so that children lists are too
+        std::vector<std::pair<unsigned char, size_t>> children;
+        size_t fail_link = 0;
+        // closest node on the fail link chain which ends a pattern, 0 if there is none
+        size_t dictionary_link = 0;
+        size_t pattern = NO_PATTERN;
+    };
+
+    size_t child(size_t node, unsigned char byte) const {
+        const auto& children = m_nodes[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), byte, [](const auto& child, unsigned char value) {
+            return child.first < value;
+        });
+        return it != children.end() && it->first == byte ? it->second : 0;
+    }
+
+    size_t next(size_t node, unsigned char byte) const {
+        while (true) {
+            size_t next_node = child(node, byte);
+            if (next_node != 0 || node == 0)
+                return next_node;
+            node = m_nodes[node].fail_link;
+        }
+    }
+
+    void add_pattern(const std::string& pattern) {
+        OPENVINO_ASSERT(!pattern.empty(), "Stop string matcher does not support empty stop strings");
+        size_t node = 0;
+        for (unsigned char byte : pattern) {
+            size_t next_node = child(node, byte);
+            if (next_node == 0) {
+                next_node = m_nodes.size();
+                auto& children = m_nodes[node].children;
+                auto it = std::lower_bound(children.begin(), children.end(), byte, [](const auto& child, unsigned char value) {
+                    return child.first < value;
+                });
+                children.insert(it, {byte, next_node});
+                m_nodes.emplace_back();
+            }
+            node = next_node;
+        }
+        m_nodes[node].pattern = m_stop_string_lengths.size();
+        m_stop_string_lengths.push_back(pattern.size());
+    }
+
+    void build_links() {
+        // breadth-first order guarantees fail links point to already processed nodes
+        std::vector<size_t> queue;
+        queue.reserve(m_nodes.size());
+        for (const auto& [byte, node] : m_nodes[0].children) {
+            queue.push_back(node);
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const size_t node = queue[head];
+            for (const auto& [byte, child_node] : m_nodes[node].children) {
+                size_t fail_link = next(m_nodes[node].fail_link, byte);
+                m_nodes[child_node].fail_link = fail_link;
+                m_nodes[child_node].dictionary_link = m_nodes[fail_link].pattern != NO_PATTERN ? fail_link : m_nodes[fail_link].dictionary_link;
+                queue.push_back(child_node);
+            }
+        }
+    }
+
+    TokenTexts m_token_texts;
+    size_t m_window_size;
+    std::vector<Node> m_nodes;
+    std::vector<size_t> m_stop_string_lengths;
+};
+
+}  // namespace ov::genai
@@ -1,73 +1,218 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
 #include <condition_variable>
-#include <functional>
-#include <future>
-#include <iostream>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
-#include <utility>
-#include <atomic>
+#include <vector>
+
+#include "openvino/core/except.hpp"
 
+/**
+ * @brief Fixed-size pool of worker threads executing bulk `parallel_for` jobs.
+ * The index space of a job is split into contiguous ranges, one per worker and one for the calling thread. Each thread
+ * takes indices from the front of its own range and, once it is exhausted, steals indices from the back of the others.
+ * A range is a pair of bounds packed into a single atomic, so taking and stealing are lock-free, and no memory is
+ * allocated per job or per index. The mutex is only used to put idle workers to sleep and to wake them up.
+ */
 class ThreadPool {
+    struct alignas(64) WorkRange {
+        // begin in the higher 32 bits, end in the lower ones
+        std::atomic<uint64_t> m_bounds{0};
+    };
+
+    // type-erased non-owning reference to the body of the current job
+    struct JobBody {
+        void (*m_invoke)(const void*, size_t) = nullptr;
+        const void* m_callable = nullptr;
+    };
 
-private:
-    std::vector<std::thread> threads;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queue_mutex;
-    std::condition_variable cv;
-    bool stop{false};
+    static constexpr size_t NUM_SPINS_BEFORE_SLEEP = 1024;
+
+    std::vector<std::thread> m_threads;
+    // m_threads.size() ranges of the workers followed by the range of the calling thread
+    std::unique_ptr<WorkRange[]> m_ranges;
+    size_t m_num_ranges;
+
+    JobBody m_job_body;
+    std::atomic<size_t> m_num_pending_indices{0};
+    std::exception_ptr m_exception;
+    std::mutex m_exception_mutex;
+
+    std::atomic<uint64_t> m_job_id{0};
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // parallel_for calls from different threads are executed one at a time
+    std::mutex m_job_mutex;
+
+    static uint64_t _pack(uint64_t begin, uint64_t end) {
+        return (begin << 32) | end;
+    }
+
+    static bool _take_front(WorkRange& range, size_t& index) {
+        uint64_t bounds = range.m_bounds.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t begin = bounds >> 32, end = bounds & 0xFFFFFFFF;
+            if (begin >= end) {
+                return false;
+            }
+            if (range.m_bounds.compare_exchange_weak(bounds, _pack(begin + 1, end), std::memory_order_acq_rel)) {
+                index = begin;
+                return true;
+            }
+        }
+    }
+
+    static bool _steal_back(WorkRange& range, size_t& index) {
+        uint64_t bounds = range.m_bounds.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t begin = bounds >> 32, end = bounds & 0xFFFFFFFF;
+            if (begin >= end) {
+                return false;
+            }
+            if (range.m_bounds.compare_exchange_weak(bounds, _pack(begin, end - 1), std::memory_order_acq_rel)) {
+                index = end - 1;
+                return true;
+            }
+        }
+    }
+
+    void _execute(size_t index) {
+        try {
+            m_job_body.m_invoke(m_job_body.m_callable, index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_exception_mutex);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+        }
+        m_num_pending_indices.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void _run(size_t own_range_idx) {
+        size_t index;
+        while (_take_front(m_ranges[own_range_idx], index)) {
+            _execute(index);
+        }
+        for (size_t offset = 1; offset < m_num_ranges; ++offset) {
+            WorkRange& victim = m_ranges[(own_range_idx + offset) % m_num_ranges];
+            while (_steal_back(victim, index)) {
+                _execute(index);
+            }
+        }
+    }
+
+    void _worker(size_t worker_idx) {
+        uint64_t last_job_id = 0;
+        while (true) {
+            // jobs are submitted once per generation step, so spin shortly before going to sleep
+            for (size_t i = 0; i < NUM_SPINS_BEFORE_SLEEP && m_job_id.load(std::memory_order_acquire) == last_job_id; ++i) {
+                std::this_thread::yield();
+            }
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&] {
+                    return m_stop || m_job_id.load(std::memory_order_acquire) != last_job_id;
+                });
+                if (m_stop) {
+                    return;
+                }
+                last_job_id = m_job_id.load(std::memory_order_acquire);
+            }
+            _run(worker_idx);
+        }
+    }
 
 public:
     ThreadPool(const ThreadPool& rhs) = delete;
     ThreadPool(ThreadPool&& rhs) = delete;
-    ThreadPool(size_t num_threads = std::thread::hardware_concurrency())
-    {
-        for (size_t i = 0; i < num_threads; ++i) {
-            threads.emplace_back([this] {
-                while (true) {
-                    std::function<void()> task;
-                    {
-                        std::unique_lock<std::mutex> lock(queue_mutex);
-                        cv.wait(lock, [this] {
-                            return !tasks.empty() || stop;
-                        });
-                        if (stop && tasks.empty()) {
-                            return;
-                        }
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                    }
-                    task();
-                }
-            });
+
+    /**
+     * @param num_threads The number of threads executing the jobs, including the thread calling `parallel_for`.
+     */
+    ThreadPool(size_t num_threads = std::thread::hardware_concurrency()) {
+        const size_t num_workers = num_threads > 1 ? num_threads - 1 : 0;
+        m_num_ranges = num_workers + 1;
+        m_ranges = std::make_unique<WorkRange[]>(m_num_ranges);
+        m_threads.reserve(num_workers);
+        for (size_t worker_idx = 0; worker_idx < num_workers; ++worker_idx) {
+            m_threads.emplace_back(&ThreadPool::_worker, this, worker_idx);
         }
     }
 
-    ~ThreadPool()
-    {
+    ~ThreadPool() {
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            stop = true;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
         }
-        cv.notify_all();
-        for (auto& thread : threads) {
+        m_cv.notify_all();
+        for (auto& thread : m_threads) {
             thread.join();
         }
     }
 
-    template <typename F, typename... Args>
-    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
-    {
-        using return_type = std::invoke_result_t<F, Args...>;
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        std::future<return_type> result = task->get_future();
+    /**
+     * @return The number of threads executing the jobs, including the calling one.
+     */
+    size_t get_num_threads() const {
+        return m_num_ranges;
+    }
+
+    /**
+     * Calls `body(index)` for each index in [0, num_indices) using the pool threads and the calling thread, and waits
+     * until all calls are finished. If some calls throw, the first exception is rethrown after all calls are finished.
+     * @param num_indices The number of indices.
+     * @param body The callable to be invoked with each index. Must be safe to call concurrently for different indices.
+     */
+    template <typename F>
+    void parallel_for(size_t num_indices, const F& body) {
+        if (num_indices == 0) {
+            return;
+        }
+        if (m_threads.empty() || num_indices == 1) {
+            for (size_t index = 0; index < num_indices; ++index) {
+                body(index);
+            }
+            return;
+        }
+        OPENVINO_ASSERT(num_indices <= std::numeric_limits<uint32_t>::max(), "Too many indices for parallel_for: ", num_indices);
+
+        std::lock_guard<std::mutex> job_lock(m_job_mutex);
+        m_job_body.m_invoke = [](const void* callable, size_t index) {
+            (*static_cast<const F*>(callable))(index);
+        };
+        m_job_body.m_callable = &body;
+        m_exception = nullptr;
+        m_num_pending_indices.store(num_indices, std::memory_order_release);
+
+        // the body must be published before the ranges, as a worker may still be stealing after the previous job
+        const size_t chunk_size = num_indices / m_num_ranges, remainder = num_indices % m_num_ranges;
+        for (size_t range_idx = 0, begin = 0; range_idx < m_num_ranges; ++range_idx) {
+            const size_t end = begin + chunk_size + (range_idx < remainder ? 1 : 0);
+            m_ranges[range_idx].m_bounds.store(_pack(begin, end), std::memory_order_release);
+            begin = end;
+        }
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            tasks.emplace([task]() { (*task)(); });
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job_id.fetch_add(1, std::memory_order_acq_rel);
+        }
+        m_cv.notify_all();
+
+        _run(m_num_ranges - 1);
+        while (m_num_pending_indices.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
         }
-        cv.notify_one();
-        return result;
     }
 };
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <cassert>
+#include <chrono>
 #include <set>
 #include <cstdlib>
 #include <string_view>
@@ -65,6 +66,7 @@ class Sequence {
 
     Sequence(const Sequence& seq, const uint64_t id) :
         m_generated_ids(seq.m_generated_ids),
+        m_generated_log_probs(seq.m_generated_log_probs),
         m_grouped_id(id),
         m_status(seq.m_status),
         m_cumulative_log_prob(seq.m_cumulative_log_prob),
@@ -264,6 +266,9 @@ class SequenceGroup  : public std::enable_shared_from_this<SequenceGroup> {
 
     size_t m_num_streamed_tokens = 0, m_stream_window_size = 0;
 
+    // time when the request was added to the pipeline, used by the scheduler to age and prioritize requests
+    std::chrono::steady_clock::time_point m_arrival_time = std::chrono::steady_clock::now();
+
     SequenceGroup(uint64_t request_id, const ov::genai::GenerationConfig& sampling_params, std::size_t block_size)
         : m_request_id(request_id),
           m_sampling_params(sampling_params),
@@ -641,6 +646,10 @@ public:
         return m_sampling_params;
     }
 
+    std::chrono::steady_clock::time_point get_arrival_time() const {
+        return m_arrival_time;
+    }
+
     void set_out_of_memory() {
         for (size_t seq_id = 0; seq_id < m_sequences.size(); ++seq_id) {
             if (m_sequences[seq_id]->is_running()) {
@@ -704,6 +713,18 @@ public:
     }
 
     void push_partial_outputs(size_t token_cnt = 1) {
+        const bool has_echo = m_sampling_params.echo && !m_has_echoed;
+        if (m_sequences.size() == 1 && !has_echo && token_cnt > 0 && m_sequences[0]->get_generated_len() > m_stream_window_size) {
+            // streaming of a single sequence pushes the tokens without building GenerationOutputs
+            const Sequence::Ptr& sequence = m_sequences[0];
+            OPENVINO_ASSERT(sequence->get_generated_len() >= token_cnt + m_stream_window_size);
+            const size_t offset = sequence->get_generated_len() - token_cnt - m_stream_window_size;
+            m_generation_stream->push(sequence->get_grouped_id(), sequence->get_generated_ids().data() + offset,
+                                      sequence->get_generated_log_probs().data() + offset, token_cnt,
+                                      sequence->get_cumulative_log_prob(), sequence->get_finish_reason());
+            m_has_echoed = true;
+            return;
+        }
         GenerationOutputs outputs;
         for (auto& sequence : m_sequences) {
             // todo: check seq.is_finished() to generate without several </s>
@@ -15,7 +15,12 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::Contin
     m_tokenizer = tokenizer;
     m_generation_config = generation_config;
     m_is_validation_mode_enabled = is_validation_mode_enabled;
+    // only the main pipeline writes the step trace requested by the environment variable
+    m_is_step_tracing_from_env_enabled = is_validation_mode_enabled;
     initialize_pipeline(model, scheduler_config, device, plugin_config);
+    // draft model candidates are exchanged with the main model between steps, so post-processing cannot be deferred
+    m_is_async_step_enabled = false;
+    m_sampler->set_postprocessing_deferred(false);
 }
 
 void
@@ -26,6 +31,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::finish
         }
     }
     m_sampler->clear_request_info(request->get_request_id());
+    m_num_assistant_tokens.erase(request->get_request_id());
     request->set_generation_status(GenerationStatus::STOP);
 }
 
@@ -290,6 +296,34 @@ std::vector<SequenceGroup::Ptr> ContinuousBatchingPipeline::ContinuousBatchingFo
     return m_awaiting_requests;
 }
 
+std::vector<uint64_t> ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::get_request_ids() {
+    std::vector<uint64_t> request_ids;
+    request_ids.reserve(m_requests.size());
+    for (const auto& request : m_requests) {
+        request_ids.push_back(request->get_request_id());
+    }
+    return request_ids;
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pause_requests(const std::set<uint64_t>& request_ids,
+                                                                                               bool is_resume_others) {
+    for (auto& request : m_requests) {
+        if (request_ids.count(request->get_request_id())) {
+            request->pause_generation(true);
+        } else if (is_resume_others) {
+            request->pause_generation(false);
+        }
+    }
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::set_num_assistant_tokens(uint64_t request_id,
+                                                                                                       size_t num_assistant_tokens) {
+    m_num_assistant_tokens[request_id] = num_assistant_tokens;
+    if (num_assistant_tokens == 0) {
+        pause_requests({request_id});
+    }
+}
+
 size_t ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::get_processed_tokens_per_iteration() {
     return m_batch_size;
 }
@@ -306,7 +340,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pull_a
     m_awaiting_requests.clear();
 }
 
-void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep() {
+size_t ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep() {
     bool to_generate = true;
     size_t generated_tokens_cnt = 0;
     // cycle to generate several tokens per one iteration for speculative decoding case
@@ -318,6 +352,9 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
         to_generate = false;
         for (auto& request : m_requests) {
             const auto& sampling_params = request->get_sampling_parameters();
+            auto num_assistant_tokens_it = m_num_assistant_tokens.find(request->get_request_id());
+            const size_t num_assistant_tokens = num_assistant_tokens_it != m_num_assistant_tokens.end() ?
+                num_assistant_tokens_it->second : sampling_params.num_assistant_tokens;
             if (!sampling_params.is_assisting_generation()) {
                 // generate only one token in case of non speculative decoding
                 request->pause_generation(true);
@@ -326,7 +363,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
                 request->pause_generation(true);
             } else if (request->get_num_processed_tokens() == 0 && sampling_params.num_return_sequences > 1) {
                 request->pause_generation(true);
-            } else if (sampling_params.num_assistant_tokens <= generated_tokens_cnt && sampling_params.assistant_confidence_threshold == 0.f) {
+            } else if (num_assistant_tokens <= generated_tokens_cnt && sampling_params.assistant_confidence_threshold == 0.f) {
                 request->pause_generation(true);
             } else if (request->get_max_new_tokens() == 0) {
                 request->pause_generation(true);
@@ -338,5 +375,6 @@ void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::m
             to_generate |= request->can_generate_tokens();
         }
     }
+    return generated_tokens_cnt;
 }
 }
\ No newline at end of file
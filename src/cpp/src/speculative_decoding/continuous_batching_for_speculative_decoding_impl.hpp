@@ -21,7 +21,8 @@ public:
                                                  const ov::AnyMap& plugin_config,
                                                  bool is_validation_mode_enabled);
 
-    void multistep();
+    // returns the number of performed steps, i.e. the max number of candidates generated for a request
+    size_t multistep();
 
     void finish_request(int64_t request_id = -1);
     void pull_awaiting_requests(bool is_pause_request = false);
@@ -29,6 +30,11 @@ public:
     UpdateRequestResult update_request(uint64_t request_id, const GeneratedSequences& candidates, bool is_update_logit_processor);
     bool is_requests_empty();
     std::vector<SequenceGroup::Ptr> get_awaiting_requests();
+    std::vector<uint64_t> get_request_ids();
+    // pauses generation of the given requests, the other requests are resumed if `is_resume_others` is true
+    void pause_requests(const std::set<uint64_t>& request_ids, bool is_resume_others = false);
+    // overrides `num_assistant_tokens` of the request for the next multistep, 0 pauses the request
+    void set_num_assistant_tokens(uint64_t request_id, size_t num_assistant_tokens);
 
     size_t get_processed_tokens_per_iteration();
 
@@ -37,5 +43,8 @@ public:
 protected:
     void finish_request(SequenceGroup::Ptr request);
     void _pull_awaiting_requests() override {};
+
+    // { request_id, number of candidates to generate } for requests with adaptive number of candidates
+    std::map<uint64_t, size_t> m_num_assistant_tokens;
 };
 }
\ No newline at end of file
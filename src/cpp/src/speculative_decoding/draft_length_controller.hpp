@@ -0,0 +1,174 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Chooses the number of candidates to draft per request and per step for assisted generation.
+ * Every candidate is assumed to be accepted independently with probability `alpha`, so drafting `k` candidates yields
+ * `1 + alpha + ... + alpha^k` tokens per step, including the token generated by the main model. A step with `k`
+ * candidates costs `1 + k * c` main model steps, where `c` is the cost of one draft token and of its validation. The
+ * controller picks `k` maximizing generated tokens per cost.
+ *
+ * `alpha` is estimated per request from exponentially decayed counts of accepted and rejected candidates with a
+ * uniform prior, so it follows recent text. Once drafting does not pay off, nothing is drafted and the estimate is not
+ * updated, so a single candidate is drafted as a probe after some idle steps. The interval between probes doubles while
+ * they do not change the decision, which keeps probing cheap for text the draft cannot predict.
+ */
+class DraftLengthController {
+public:
+    /**
+     * Registers a request with adaptive candidates number.
+     * @param request_id Request id.
+     * @param max_num_draft_tokens Upper bound of the number of candidates, `num_assistant_tokens` of the request.
+     */
+    void add_request(uint64_t request_id, size_t max_num_draft_tokens) {
+        OPENVINO_ASSERT(max_num_draft_tokens > 0, "Max number of draft tokens should be positive");
+        m_requests[request_id] = RequestState{max_num_draft_tokens};
+    }
+
+    bool has_request(uint64_t request_id) const {
+        return m_requests.count(request_id) > 0;
+    }
+
+    void remove_request(uint64_t request_id) {
+        m_requests.erase(request_id);
+    }
+
+    void clear() {
+        m_requests.clear();
+    }
+
+    /**
+     * Updates the relative cost of a draft token. Measurements which don't give a finite non-negative cost are ignored,
+     * so that a single bad step can't poison the decayed estimate.
+     * @param draft_token_duration Duration of generation of one candidate for the whole batch.
+     * @param main_step_duration Duration of the main model step validating the candidates.
+     */
+    void update_costs(float draft_token_duration, float main_step_duration) {
+        if (!std::isfinite(draft_token_duration) || !std::isfinite(main_step_duration) ||
+            draft_token_duration < 0.f || main_step_duration <= 0.f)
+            return;
+        const float draft_token_cost = draft_token_duration / main_step_duration;
+        if (!std::isfinite(draft_token_cost))
+            return;
+        m_draft_token_cost = m_is_draft_token_cost_measured ?
+            COST_DECAY * m_draft_token_cost + (1.f - COST_DECAY) * draft_token_cost : draft_token_cost;
+        m_is_draft_token_cost_measured = true;
+    }
+
+    /**
+     * Records validation results of a step. Requests which are not registered are ignored.
+     * @param request_id Request id.
+     * @param num_draft_tokens Number of candidates validated by the main model at the step.
+     * @param num_rejected_tokens Number of candidates removed after validation.
+     */
+    void update_acceptance(uint64_t request_id, size_t num_draft_tokens, size_t num_rejected_tokens) {
+        auto it = m_requests.find(request_id);
+        if (it == m_requests.end())
+            return;
+        RequestState& state = it->second;
+        if (num_draft_tokens == 0) {
+            ++state.num_idle_steps;
+            return;
+        }
+        const size_t num_accepted_tokens = num_draft_tokens - std::min(num_rejected_tokens, num_draft_tokens);
+        state.num_accepted = ACCEPTANCE_DECAY * state.num_accepted + num_accepted_tokens;
+        state.num_rejected = ACCEPTANCE_DECAY * state.num_rejected + (num_accepted_tokens < num_draft_tokens ? 1.f : 0.f);
+        state.num_idle_steps = 0;
+        state.probe_interval = choose_num_draft_tokens(state) == 0 ?
+            std::min(2 * state.probe_interval, MAX_PROBE_INTERVAL) : MIN_PROBE_INTERVAL;
+    }
+
+    /**
+     * @return Estimated probability of a candidate of the request to be accepted.
+     */
+    float get_acceptance_rate(uint64_t request_id) const {
+        return get_acceptance_rate(get_state(request_id));
+    }
+
+    /**
+     * @return Number of candidates to draft for the request at the next step, 0 means drafting is not worth it.
+     */
+    size_t get_num_draft_tokens(uint64_t request_id) const {
+        const RequestState& state = get_state(request_id);
+        const size_t num_draft_tokens = choose_num_draft_tokens(state);
+        return num_draft_tokens == 0 && state.num_idle_steps >= state.probe_interval ? 1 : num_draft_tokens;
+    }
+
+    /**
+     * @return { request id, number of candidates to draft at the next step } for all registered requests.
+     */
+    std::map<uint64_t, size_t> get_num_draft_tokens() const {
+        std::map<uint64_t, size_t> num_draft_tokens;
+        for (const auto& [request_id, state] : m_requests) {
+            num_draft_tokens.emplace(request_id, get_num_draft_tokens(request_id));
+        }
+        return num_draft_tokens;
+    }
+
+private:
+    // decay of acceptance statistics per step, i.e. they cover about the last ten steps
+    static constexpr float ACCEPTANCE_DECAY = 0.9f;
+    static constexpr float COST_DECAY = 0.9f;
+    // pseudo counts of accepted and rejected candidates, the prior acceptance rate is 0.5
+    static constexpr float PRIOR_COUNT = 1.f;
+    // validation of a candidate by the main model is not free even if the candidate costs nothing to draft
+    static constexpr float VALIDATION_TOKEN_COST = 0.02f;
+    // number of steps without candidates before drafting is probed again
+    static constexpr size_t MIN_PROBE_INTERVAL = 4;
+    static constexpr size_t MAX_PROBE_INTERVAL = 64;
+
+    struct RequestState {
+        size_t max_num_draft_tokens = 0;
+        float num_accepted = 0.f;
+        float num_rejected = 0.f;
+        size_t num_idle_steps = 0;
+        size_t probe_interval = MIN_PROBE_INTERVAL;
+    };
+
+    static float get_acceptance_rate(const RequestState& state) {
+        return (state.num_accepted + PRIOR_COUNT) / (state.num_accepted + state.num_rejected + 2 * PRIOR_COUNT);
+    }
+
+    size_t choose_num_draft_tokens(const RequestState& state) const {
+        const float alpha = get_acceptance_rate(state);
+        const float token_cost = m_draft_token_cost + VALIDATION_TOKEN_COST;
+
+        size_t best_num_draft_tokens = 0;
+        float best_throughput = 1.f;
+        // expected number of tokens generated by a step and probability of all candidates to be accepted
+        float expected_tokens = 1.f, acceptance_probability = 1.f;
+        for (size_t num_draft_tokens = 1; num_draft_tokens <= state.max_num_draft_tokens; ++num_draft_tokens) {
+            acceptance_probability *= alpha;
+            expected_tokens += acceptance_probability;
+            const float throughput = expected_tokens / (1.f + num_draft_tokens * token_cost);
+            if (throughput > best_throughput) {
+                best_throughput = throughput;
+                best_num_draft_tokens = num_draft_tokens;
+            }
+        }
+        return best_num_draft_tokens;
+    }
+
+    const RequestState& get_state(uint64_t request_id) const {
+        auto it = m_requests.find(request_id);
+        OPENVINO_ASSERT(it != m_requests.end(), "Request ", request_id, " is not registered in draft length controller");
+        return it->second;
+    }
+
+    std::map<uint64_t, RequestState> m_requests;
+    float m_draft_token_cost = 0.f;
+    bool m_is_draft_token_cost_measured = false;
+};
+
+}  // namespace ov::genai
@@ -1,6 +1,8 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <array>
 #include <thread>
 
 #include "openvino/genai/text_streamer.hpp"
@@ -26,7 +28,13 @@ bool are_tokenizers_equal(Tokenizer& lhs, Tokenizer& rhs) {
 }
 
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(const ov::genai::ModelDesc& main_model_desc, 
-                                                                             const ov::genai::ModelDesc& draft_model_desc) {
+                                                                             const ov::genai::ModelDesc& draft_model_desc,
+                                                                             bool is_pipelined) :
+    m_is_pipelined(is_pipelined) {
+    if (m_is_pipelined) {
+        // the pool thread takes the draft model inference, while the main model one runs on the stepping thread
+        m_pipelined_step_thread_pool = std::make_unique<ThreadPool>(2);
+    }
     auto main_model = main_model_desc.model;
     auto draft_model = draft_model_desc.model;
 
@@ -105,12 +113,15 @@ GenerationHandle
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::add_request(uint64_t request_id,
                                                                  const ov::Tensor& input_ids,
                                                                  ov::genai::GenerationConfig sampling_params) {
+    OPENVINO_ASSERT(sampling_params.num_assistant_branches == 1,
+                    "'num_assistant_branches' > 1 is supported only by prompt lookup decoding, the draft model proposes a single candidate sequence");
     m_sd_metrics.set_generated_len(request_id, sampling_params.get_max_new_tokens(input_ids.get_size()));
     std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
     auto draft_sampling_params = sampling_params;
     draft_sampling_params.ignore_eos = true;
     draft_sampling_params.stop_strings = {};
     m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, input_ids, draft_sampling_params)});
+    add_draft_length_control(request_id, sampling_params);
     return m_main_pipeline->add_request(request_id, input_ids, sampling_params);
 };
 
@@ -118,19 +129,41 @@ GenerationHandle
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::add_request(uint64_t request_id,
                                                                  const std::string& prompt,
                                                                  ov::genai::GenerationConfig sampling_params) {
+    OPENVINO_ASSERT(sampling_params.num_assistant_branches == 1,
+                    "'num_assistant_branches' > 1 is supported only by prompt lookup decoding, the draft model proposes a single candidate sequence");
     m_sd_metrics.set_generated_len(request_id, sampling_params.get_max_new_tokens(prompt.length()));
     std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
     auto draft_sampling_params = sampling_params;
     draft_sampling_params.ignore_eos = true;
     draft_sampling_params.stop_strings = {};
     m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, prompt, draft_sampling_params)});
+    add_draft_length_control(request_id, sampling_params);
     return m_main_pipeline->add_request(request_id, prompt, sampling_params);
 }
 
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::add_draft_length_control(uint64_t request_id,
+                                                                                   const GenerationConfig& sampling_params) {
+    if (sampling_params.adaptive_num_assistant_tokens) {
+        m_draft_length_controller.add_request(request_id, sampling_params.num_assistant_tokens);
+    }
+}
+
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::apply_draft_lengths() {
+    for (const auto& [request_id, num_draft_tokens] : m_draft_length_controller.get_num_draft_tokens()) {
+        m_draft_pipeline->set_num_assistant_tokens(request_id, num_draft_tokens);
+    }
+}
+
 bool ContinuousBatchingPipeline::SpeculativeDecodingImpl::has_non_finished_requests() {
     return m_main_pipeline->has_non_finished_requests();
 }
 
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::enable_stream_detokenization() {
+    // handles are created by the main pipeline
+    m_main_pipeline->enable_stream_detokenization();
+    m_is_stream_detokenization_enabled = true;
+}
+
 void print_generated_request(const ov::genai::GeneratedRequests& requests) {
     for (const auto& request : requests) {
         for (const auto& sequence : request.second) {
@@ -148,6 +181,11 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     // this blocks adding new requests during step as it may break coherence between main and draft models
     std::lock_guard<std::mutex> lock{m_draft_generations_mutex};
 
+    if (m_is_pipelined) {
+        pipelined_step();
+        return;
+    }
+
     auto& raw_perf_counters = m_perf_metrics.raw_metrics;
 
     ManualTimer step_timer("speculative_decoding: step()");
@@ -157,9 +195,10 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     m_main_pipeline->pull_awaiting_requests();
 
     // generate candidates by draft model
+    apply_draft_lengths();
     ManualTimer draft_timer("speculative_decoding: draft_model: multistep()");
     draft_timer.start();
-    m_draft_pipeline->multistep();
+    const size_t num_draft_steps = m_draft_pipeline->multistep();
     draft_timer.end();
     m_sd_metrics.draft_duration += draft_timer.get_duration();
     m_pipeline_metrics = m_main_pipeline->get_metrics();
@@ -179,6 +218,13 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     main_timer.end();
     m_sd_metrics.main_duration += main_timer.get_duration();
     m_pipeline_metrics = m_main_pipeline->get_metrics();
+    // steps without candidates do not tell the cost of drafting
+    const bool has_candidates = std::any_of(update_sequence_info.begin(), update_sequence_info.end(), [](const auto& info) {
+        return info.second.inserted_tokens_cnt > 0;
+    });
+    if (num_draft_steps > 0 && has_candidates) {
+        m_draft_length_controller.update_costs(draft_timer.get_duration() / num_draft_steps, main_timer.get_duration());
+    }
 
     auto main_generated_requests = m_main_pipeline->get_generated_requests();
     for (const auto& checked_sequence : main_generated_requests) {
@@ -193,8 +239,10 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
             m_draft_pipeline->finish_request(request_id);
             // remove draft_generation_handle from queue
             m_draft_generations.erase(request_id);
+            m_draft_length_controller.remove_request(request_id);
         }
         auto updated_seq_info = update_sequence_info[request_id];
+        m_draft_length_controller.update_acceptance(request_id, updated_seq_info.inserted_tokens_cnt, updated_seq_info.removed_tokens_cnt);
         // several prompt phase
         if (updated_seq_info.inserted_tokens_cnt == 0) {
             continue;
@@ -224,6 +272,122 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     step_timer.end();
 }
 
+void ContinuousBatchingPipeline::SpeculativeDecodingImpl::pipelined_step() {
+    auto& raw_perf_counters = m_perf_metrics.raw_metrics;
+
+    ManualTimer step_timer("speculative_decoding: pipelined_step()");
+    step_timer.start();
+
+    m_draft_pipeline->pull_awaiting_requests(true);
+    m_main_pipeline->pull_awaiting_requests();
+
+    const size_t validating_group = 1 - m_drafting_group;
+    std::array<size_t, 2> group_sizes = {0, 0};
+    for (const auto& [request_id, group] : m_request_groups) {
+        ++group_sizes[group];
+    }
+    // new requests join the smaller group to balance batches of both models,
+    // the validating group is preferred as the main model processes the prompt first
+    for (uint64_t request_id : m_main_pipeline->get_request_ids()) {
+        if (m_request_groups.count(request_id)) {
+            continue;
+        }
+        const size_t group = group_sizes[validating_group] <= group_sizes[m_drafting_group] ? validating_group : m_drafting_group;
+        m_request_groups.emplace(request_id, group);
+        ++group_sizes[group];
+    }
+
+    std::set<uint64_t> drafting_requests, validating_requests;
+    for (const auto& [request_id, group] : m_request_groups) {
+        (group == m_drafting_group ? drafting_requests : validating_requests).insert(request_id);
+    }
+    // draft requests are resumed by validation results, so only the validating group has to be paused explicitly
+    m_draft_pipeline->pause_requests(validating_requests);
+    m_main_pipeline->pause_requests(drafting_requests, true);
+
+    // generate candidates for the drafting group in parallel with validation of the validating group
+    apply_draft_lengths();
+    ManualTimer draft_timer("speculative_decoding: draft_model: multistep()");
+    size_t num_draft_steps = 0;
+    ManualTimer main_timer("speculative_decoding: main_model: step()");
+    // both inferences are completed before an exception of either is rethrown, so that requests can be dropped
+    m_pipelined_step_thread_pool->parallel_for(2, [&](size_t model_idx) {
+        if (model_idx == 0 && !drafting_requests.empty()) {
+            draft_timer.start();
+            num_draft_steps = m_draft_pipeline->multistep();
+            draft_timer.end();
+        } else if (model_idx == 1 && !validating_requests.empty()) {
+            main_timer.start();
+            m_main_pipeline->step();
+            main_timer.end();
+        }
+    });
+    m_sd_metrics.draft_duration += draft_timer.get_duration();
+    m_sd_metrics.main_duration += main_timer.get_duration();
+    m_pipeline_metrics = m_main_pipeline->get_metrics();
+    if (num_draft_steps > 0 && !validating_requests.empty()) {
+        m_draft_length_controller.update_costs(draft_timer.get_duration() / num_draft_steps, main_timer.get_duration());
+    }
+
+    // apply validation results of the validating group to the draft model
+    auto main_generated_requests = m_main_pipeline->get_generated_requests();
+    for (const auto& [request_id, checked_sequences] : main_generated_requests) {
+        if (!validating_requests.count(request_id)) {
+            continue;
+        }
+        auto update_result = m_draft_pipeline->update_request(request_id, checked_sequences, true);
+        auto pending_it = m_pending_validations.find(request_id);
+        if (pending_it == m_pending_validations.end()) {
+            continue;
+        }
+        const size_t inserted_tokens_cnt = pending_it->second.inserted_tokens_cnt;
+        m_pending_validations.erase(pending_it);
+        m_draft_length_controller.update_acceptance(request_id, inserted_tokens_cnt, update_result.removed_tokens_cnt);
+        // several prompt phase
+        if (inserted_tokens_cnt == 0) {
+            continue;
+        }
+        float acceptance_rate = 1 - static_cast<float>(update_result.removed_tokens_cnt) / inserted_tokens_cnt;
+        m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
+        m_sd_metrics.update_draft_accepted_tokens(request_id, (inserted_tokens_cnt - update_result.removed_tokens_cnt));
+    }
+
+    // put candidates of the drafting group to model KV cache to be validated at the next step
+    for (const auto& [request_id, candidates] : m_draft_pipeline->get_generated_requests()) {
+        if (!main_generated_requests.count(request_id)) {
+            // finish draft request if the generation was completed
+            m_draft_pipeline->finish_request(request_id);
+            m_draft_generations.erase(request_id);
+            m_draft_length_controller.remove_request(request_id);
+            m_request_groups.erase(request_id);
+            m_pending_validations.erase(request_id);
+        } else if (drafting_requests.count(request_id)) {
+            m_pending_validations[request_id] = m_main_pipeline->update_request(request_id, candidates, false);
+        }
+    }
+
+    m_drafting_group = validating_group;
+
+    step_timer.end();
+
+    // update perf metrics
+    const auto num_generated_tokens = m_main_pipeline->get_processed_tokens_per_iteration();
+    if (!validating_requests.empty() && num_generated_tokens > 0) {
+        auto infer_duration = step_timer.get_duration_microsec();
+
+        raw_perf_counters.m_token_infer_durations.emplace_back(infer_duration);
+        raw_perf_counters.m_inference_durations[0] += MicroSeconds(infer_duration);
+        raw_perf_counters.m_new_token_times.emplace_back(main_timer.get_end_time());
+
+        raw_perf_counters.m_batch_sizes.emplace_back(num_generated_tokens);
+    }
+
+    if (main_generated_requests.empty() && utils::env_setup_for_print_debug_info()) {
+        m_sd_metrics.print(true);
+        m_sd_metrics.clean_up();
+    }
+}
+
 std::vector<EncodedGenerationResult>
 ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<ov::Tensor>& input_ids,
                                                               const std::vector<GenerationConfig>& sampling_params,
@@ -245,7 +409,7 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<
     m_main_pipeline->set_adapters(sampling_params[0].adapters);
     m_draft_pipeline->set_adapters(sampling_params[0].adapters);
 
-    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer);
+    const auto streamer_ptr = std::make_shared<ThreadedStreamerWrapper>(streamer, m_tokenizer, m_is_stream_detokenization_enabled);
 
     OPENVINO_ASSERT(!streamer_ptr->has_callback() || input_ids.size() == 1 && (sampling_params[0].is_greedy_decoding() || sampling_params[0].is_multinomial()),
         "Currently streaming is possible only with batch size=1 and only for greedy or multinomial decoding");
@@ -254,6 +418,8 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<
     for (size_t request_id = 0; request_id < input_ids.size(); ++request_id) {
         m_sd_metrics.set_generated_len(request_id, sampling_params[request_id].get_max_new_tokens(input_ids[request_id].get_size()));
         OPENVINO_ASSERT(1 == input_ids[request_id].get_shape().at(0), "Use multiple tensors to pass a batch.");
+        OPENVINO_ASSERT(sampling_params[request_id].num_assistant_branches == 1,
+                        "'num_assistant_branches' > 1 is supported only by prompt lookup decoding, the draft model proposes a single candidate sequence");
         main_generations.push_back(m_main_pipeline->add_request(request_id, input_ids[request_id], sampling_params[request_id]));
 
         auto draft_sampling_params = sampling_params[request_id];
@@ -262,6 +428,7 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::generate(const std::vector<
         draft_sampling_params.stop_strings = {};
         std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
         m_draft_generations.insert({request_id, m_draft_pipeline->add_request(request_id, input_ids[request_id], draft_sampling_params)});
+        add_draft_length_control(request_id, sampling_params[request_id]);
     }
     auto all_requests = get_awaiting_requests();
 
@@ -339,6 +506,9 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::get_speculative_decoding_me
 void ContinuousBatchingPipeline::SpeculativeDecodingImpl::drop_requests() {
     m_draft_pipeline->finish_request();
     m_main_pipeline->finish_request();
+    m_request_groups.clear();
+    m_pending_validations.clear();
+    m_draft_length_controller.clear();
 }
 
 
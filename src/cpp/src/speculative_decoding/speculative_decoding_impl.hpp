@@ -7,6 +7,8 @@
 #include "continuous_batching/pipeline_impl.hpp"
 #include "speculative_decoding/continuous_batching_for_speculative_decoding_impl.hpp"
 #include "speculative_decoding/speculative_decoding_metrics.hpp"
+#include "speculative_decoding/draft_length_controller.hpp"
+#include "sampling/threadpool.hpp"
 
 namespace ov::genai {
 
@@ -45,12 +47,30 @@ protected:
     std::mutex m_draft_generations_mutex;
     std::map<uint64_t, GenerationHandle> m_draft_generations;
 
+    // chooses number of candidates for requests with `adaptive_num_assistant_tokens`
+    DraftLengthController m_draft_length_controller;
+
+    // In pipelined mode requests are split into two groups which swap roles every step: the draft model generates
+    // candidates for the drafting group while the main model validates candidates of the other group in parallel
+    bool m_is_pipelined = false;
+    // persistent thread overlapping the draft model inference with the main model one
+    std::unique_ptr<ThreadPool> m_pipelined_step_thread_pool;
+    std::map<uint64_t, size_t> m_request_groups;
+    size_t m_drafting_group = 0;
+    // candidates put to the main model KV cache at the previous step, they are validated at the current step
+    std::map<uint64_t, UpdateRequestResult> m_pending_validations;
+
+    void pipelined_step();
+    void add_draft_length_control(uint64_t request_id, const GenerationConfig& sampling_params);
+    void apply_draft_lengths();
     void drop_requests();
     bool is_requests_empty();
     std::vector<SequenceGroup::Ptr> get_awaiting_requests();
     
 public:
-    SpeculativeDecodingImpl(const ov::genai::ModelDesc& main_model_desc, const ov::genai::ModelDesc& draft_model_desc);
+    SpeculativeDecodingImpl(const ov::genai::ModelDesc& main_model_desc,
+                            const ov::genai::ModelDesc& draft_model_desc,
+                            bool is_pipelined = false);
 
     GenerationHandle add_request(uint64_t request_id,
                                  const ov::Tensor& input_ids,
@@ -61,6 +81,8 @@ public:
 
     bool has_non_finished_requests() override;
 
+    void enable_stream_detokenization() override;
+
     void step() override;
 
     std::vector<EncodedGenerationResult>
@@ -0,0 +1,133 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Unbounded queue with a single producer thread and a single consumer thread.
+ * Items are stored in a linked list of fixed-size blocks, the block drained by the consumer is handed back to the
+ * producer, so a queue which is read regularly doesn't allocate. Pushed items become visible to the consumer together,
+ * on `commit`. Neither side takes a lock, except for the consumer waiting for an empty queue and the producer waking
+ * it up.
+ */
+template <typename T, size_t BLOCK_SIZE = 64>
+class SPSCQueue {
+    struct Block {
+        std::array<T, BLOCK_SIZE> items;
+        // written by the producer before items of the next block are committed
+        Block* next = nullptr;
+    };
+
+    // consumer side
+    Block* m_head_block;
+    size_t m_head_idx = 0;
+    std::atomic<size_t> m_num_consumed{0};
+
+    // producer side
+    Block* m_tail_block;
+    size_t m_tail_idx = 0;
+    size_t m_num_written = 0;
+
+    std::atomic<size_t> m_num_committed{0};
+    // a block drained by the consumer which the producer takes before allocating a new one
+    std::atomic<Block*> m_spare_block{nullptr};
+
+    std::atomic<size_t> m_num_waiters{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+public:
+    SPSCQueue() : m_head_block(new Block), m_tail_block(m_head_block) {}
+
+    ~SPSCQueue() {
+        while (m_head_block) {
+            delete std::exchange(m_head_block, m_head_block->next);
+        }
+        delete m_spare_block.load();
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * Producer: appends the item, it's not visible to the consumer until `commit`.
+     */
+    void push(T item) {
+        if (m_tail_idx == BLOCK_SIZE) {
+            Block* block = m_spare_block.exchange(nullptr, std::memory_order_acq_rel);
+            if (block) {
+                block->next = nullptr;
+            } else {
+                block = new Block;
+            }
+            m_tail_block->next = block;
+            m_tail_block = block;
+            m_tail_idx = 0;
+        }
+        m_tail_block->items[m_tail_idx++] = std::move(item);
+        ++m_num_written;
+    }
+
+    /**
+     * Producer: makes pushed items visible to the consumer and wakes it up if it waits.
+     */
+    void commit() {
+        // sequentially consistent with the consumer registering as a waiter, so that either the consumer sees the items
+        // or the producer sees the waiter
+        m_num_committed.store(m_num_written, std::memory_order_seq_cst);
+        if (m_num_waiters.load(std::memory_order_seq_cst) > 0) {
+            { std::lock_guard<std::mutex> lock(m_mutex); }
+            m_cv.notify_all();
+        }
+    }
+
+    /**
+     * Consumer: @return The oldest committed item or nullptr if there are none.
+     */
+    T* front() {
+        if (m_num_consumed.load(std::memory_order_relaxed) == m_num_committed.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        if (m_head_idx == BLOCK_SIZE) {
+            Block* drained = std::exchange(m_head_block, m_head_block->next);
+            m_head_idx = 0;
+            delete m_spare_block.exchange(drained, std::memory_order_acq_rel);
+        }
+        return &m_head_block->items[m_head_idx];
+    }
+
+    /**
+     * Consumer: removes the item returned by `front`.
+     */
+    void pop() {
+        ++m_head_idx;
+        m_num_consumed.store(m_num_consumed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Consumer: blocks until there is a committed item.
+     */
+    void wait() {
+        if (!empty()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_num_waiters.fetch_add(1, std::memory_order_seq_cst);
+        m_cv.wait(lock, [this] { return !empty(); });
+        m_num_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Can be called from any thread.
+     */
+    bool empty() const {
+        return m_num_consumed.load(std::memory_order_acquire) == m_num_committed.load(std::memory_order_seq_cst);
+    }
+};
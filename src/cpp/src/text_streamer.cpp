@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "openvino/genai/text_streamer.hpp"
+#include "tokenizer/incremental_detokenizer.hpp"
+#include "tokenizer/token_bytes.hpp"
 
 namespace {
 bool is_incomplete(std::string& text) {
@@ -18,9 +20,16 @@ TextStreamer::TextStreamer(const Tokenizer& tokenizer,
                            std::function<ov::genai::CallbackTypeVariant(std::string)> callback) {
     m_tokenizer = tokenizer;
     m_subword_callback = callback;
+    if (auto token_bytes = get_token_bytes(m_tokenizer)) {
+        m_incremental_detokenizer = std::make_shared<IncrementalDetokenizer>(token_bytes);
+    }
 }
 
 StreamingStatus TextStreamer::write(int64_t token) {
+    if (m_incremental_detokenizer) {
+        return run_callback_if_needed(m_incremental_detokenizer->write(token));
+    }
+
     std::stringstream res;
     m_tokens_cache.push_back(token);
     std::string text = m_tokenizer.decode(m_tokens_cache);
@@ -83,6 +92,14 @@ StreamingStatus TextStreamer::write(const std::vector<int64_t>& tokens) {
         return StreamingStatus::RUNNING;
     }
 
+    if (m_incremental_detokenizer) {
+        std::string text;
+        for (int64_t token : tokens) {
+            text += m_incremental_detokenizer->write(token);
+        }
+        return run_callback_if_needed(text);
+    }
+
     if (tokens.size() > 1) {
         m_tokens_cache.insert(m_tokens_cache.end(), tokens.begin(), tokens.end() - 1);
         // -2 means no decode was done for this token position
@@ -108,6 +125,13 @@ StreamingStatus TextStreamer::run_callback_if_needed(const std::string& text) {
 }
 
 void TextStreamer::end() {
+    if (m_incremental_detokenizer) {
+        std::string text = m_incremental_detokenizer->end();
+        if (!text.empty())
+            m_subword_callback(text);
+        return;
+    }
+
     std::stringstream res;
     std::string text = m_tokenizer.decode(m_tokens_cache);
     if (text.size() <= m_printed_len)
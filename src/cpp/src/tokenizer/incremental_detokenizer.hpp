@@ -0,0 +1,122 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Streaming detokenizer for vocabularies where decoding is concatenation of token bytes.
+ * Bytes of every new token are appended to the pending ones and the longest prefix made of complete UTF-8 characters is
+ * returned, so the work per token is proportional to the token length. Invalid bytes are replaced with U+FFFD, an
+ * incomplete character at the end is kept until the next token or `end`.
+ */
+class IncrementalDetokenizer {
+public:
+    using TokenBytes = std::shared_ptr<const std::vector<std::string>>;
+
+    explicit IncrementalDetokenizer(TokenBytes token_bytes) : m_token_bytes(std::move(token_bytes)) {
+        OPENVINO_ASSERT(m_token_bytes, "Token bytes table is required for incremental detokenization");
+    }
+
+    /**
+     * Decodes the next token.
+     * @return Text which became complete after the token, can be empty.
+     */
+    std::string write(int64_t token) {
+        OPENVINO_ASSERT(token >= 0 && static_cast<size_t>(token) < m_token_bytes->size(),
+                        "Token id ", token, " is out of the vocabulary range");
+        m_pending.append((*m_token_bytes)[token]);
+        return take_complete_text(false);
+    }
+
+    /**
+     * Flushes pending bytes, an incomplete character is replaced with U+FFFD.
+     */
+    std::string end() {
+        return take_complete_text(true);
+    }
+
+    /**
+     * @return Length of a valid UTF-8 character at the beginning of the text, 0 if the bytes are not a valid character,
+     * `std::string::npos` if the character is not complete.
+     */
+    static size_t get_char_length(const char* text, size_t size) {
+        const auto lead = static_cast<unsigned char>(text[0]);
+        size_t length = 0;
+        // bounds of the second byte exclude overlong encodings, surrogates and code points above U+10FFFF
+        unsigned char second_min = 0x80, second_max = 0xBF;
+        if (lead < 0x80) {
+            return 1;
+        } else if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            second_min = lead == 0xE0 ? 0xA0 : 0x80;
+            second_max = lead == 0xED ? 0x9F : 0xBF;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            second_min = lead == 0xF0 ? 0x90 : 0x80;
+            second_max = lead == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return 0;
+        }
+        for (size_t i = 1; i < length; ++i) {
+            if (i == size)
+                return std::string::npos;
+            const auto byte = static_cast<unsigned char>(text[i]);
+            if (byte < (i == 1 ? second_min : 0x80) || byte > (i == 1 ? second_max : 0xBF))
+                return 0;
+        }
+        return length;
+    }
+
+    static bool is_valid_utf8(const std::string& text) {
+        for (size_t position = 0; position < text.size(); ) {
+            const size_t length = get_char_length(text.data() + position, text.size() - position);
+            if (length == 0 || length == std::string::npos)
+                return false;
+            position += length;
+        }
+        return true;
+    }
+
+private:
+    std::string take_complete_text(bool is_end) {
+        // MSVC with /utf-8 fails to compile � directly with newline in string literal error.
+        constexpr char replacement[] = "\xef\xbf\xbd";
+        std::string text;
+        size_t position = 0;
+        while (position < m_pending.size()) {
+            const size_t length = get_char_length(m_pending.data() + position, m_pending.size() - position);
+            if (length == std::string::npos) {
+                if (!is_end)
+                    break;
+                // the rest is a truncated character
+                text += replacement;
+                position = m_pending.size();
+            } else if (length == 0) {
+                text += replacement;
+                ++position;
+            } else {
+                text.append(m_pending, position, length);
+                position += length;
+            }
+        }
+        m_pending.erase(0, position);
+        return text;
+    }
+
+    TokenBytes m_token_bytes;
+    // bytes of an incomplete character at the end of the decoded text
+    std::string m_pending;
+};
+
+}  // namespace ov::genai
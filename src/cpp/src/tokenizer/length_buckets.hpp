@@ -0,0 +1,40 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+/**
+ * Groups prompts of similar length, so that little padding is added when the prompts of a group are encoded together.
+ * The length of a prompt in bytes is used as an estimate of the number of its tokens.
+ * @param prompts Prompts to group.
+ * @param bucket_size Maximum number of prompts in a group.
+ * @return Indices of the prompts of every group, from the longest prompts to the shortest ones.
+ */
+inline std::vector<std::vector<size_t>> split_into_length_buckets(const std::vector<std::string>& prompts, size_t bucket_size) {
+    OPENVINO_ASSERT(bucket_size > 0, "bucket_size must be positive");
+    std::vector<size_t> order(prompts.size());
+    std::iota(order.begin(), order.end(), 0);
+    // the longest buckets go first, so that they don't delay the end of parallel encoding
+    std::stable_sort(order.begin(), order.end(), [&prompts](size_t lhs, size_t rhs) {
+        return prompts[lhs].size() > prompts[rhs].size();
+    });
+
+    std::vector<std::vector<size_t>> buckets;
+    buckets.reserve((order.size() + bucket_size - 1) / bucket_size);
+    for (size_t begin = 0; begin < order.size(); begin += bucket_size) {
+        const size_t end = std::min(begin + bucket_size, order.size());
+        buckets.emplace_back(order.begin() + begin, order.begin() + end);
+    }
+    return buckets;
+}
+
+}  // namespace ov::genai
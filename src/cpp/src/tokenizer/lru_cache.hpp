@@ -0,0 +1,72 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace ov::genai {
+
+/**
+ * @brief Thread safe cache which keeps up to `capacity` most recently used entries.
+ */
+template <typename Key, typename Value>
+class LRUCache {
+public:
+    explicit LRUCache(size_t capacity) : m_capacity(capacity) {}
+
+    /**
+     * @return Value of the key, the entry becomes the most recently used one.
+     */
+    std::optional<Value> get(const Key& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+            return std::nullopt;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->second;
+    }
+
+    /**
+     * Inserts or updates the entry, the least recently used entry is evicted if the cache is full.
+     */
+    void put(const Key& key, Value value) {
+        if (m_capacity == 0)
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->second = std::move(value);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+        if (m_entries.size() == m_capacity) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        m_entries.emplace_front(key, std::move(value));
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+private:
+    size_t m_capacity;
+    std::mutex m_mutex;
+    // most recently used entries come first
+    std::list<std::pair<Key, Value>> m_entries;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> m_index;
+};
+
+}  // namespace ov::genai
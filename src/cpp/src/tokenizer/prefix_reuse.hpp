@@ -0,0 +1,55 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ov::genai {
+
+/**
+ * Finds the part of an encoded prefix which can be kept when a text sharing some characters with the prefix is encoded.
+ * Text is split by special tokens before it is tokenized, so tokens up to a special token do not depend on the text after
+ * it. The prefix is cut after the last special token which ends within the common part of the texts.
+ * @param prefix Previously encoded text.
+ * @param prefix_ids Tokens of the prefix.
+ * @param num_common_chars Number of leading characters the new text shares with the prefix.
+ * @param special_token_texts { special token id, its text }.
+ * @return { number of tokens to keep, number of characters they cover }, zeros if nothing can be kept.
+ */
+inline std::pair<size_t, size_t> find_reusable_prefix(const std::string& prefix,
+                                                      const std::vector<int64_t>& prefix_ids,
+                                                      size_t num_common_chars,
+                                                      const std::unordered_map<int64_t, std::string>& special_token_texts) {
+    std::pair<size_t, size_t> reusable = {0, 0};
+    size_t position = 0;
+    for (size_t i = 0; i < prefix_ids.size(); ++i) {
+        auto it = special_token_texts.find(prefix_ids[i]);
+        if (it == special_token_texts.end())
+            continue;
+        position = prefix.find(it->second, position);
+        // tokens do not match the text
+        if (position == std::string::npos)
+            return {0, 0};
+        position += it->second.size();
+        if (position > num_common_chars)
+            break;
+        reusable = {i + 1, position};
+    }
+    return reusable;
+}
+
+/**
+ * @return Number of leading characters two texts have in common.
+ */
+inline size_t get_common_prefix_length(const std::string& lhs, const std::string& rhs) {
+    const size_t length = std::min(lhs.size(), rhs.size());
+    return std::mismatch(lhs.begin(), lhs.begin() + length, rhs.begin()).first - lhs.begin();
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,20 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "openvino/genai/tokenizer.hpp"
+
+namespace ov::genai {
+
+/**
+ * @return Texts of tokens indexed by token id with skipped special tokens being empty, if decoding with default
+ * parameters is concatenation of the texts, nullptr otherwise. Computed once per tokenizer and shared by its copies.
+ */
+std::shared_ptr<const std::vector<std::string>> get_token_bytes(const Tokenizer& tokenizer);
+
+}  // namespace ov::genai
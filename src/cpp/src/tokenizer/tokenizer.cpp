@@ -4,19 +4,27 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <jinja2cpp/template.h>
 #include <jinja2cpp/template_env.h>
 #include <jinja2cpp/user_callable.h>
 #include <jinja2cpp/generic_list.h>
 #include <jinja2cpp/generic_list_iterator.h>
 
+#include "openvino/op/slice.hpp"
 #include "openvino/pass/manager.hpp"
 #include "openvino/runtime/core.hpp"
 #include "openvino/genai/tokenizer.hpp"
 
 #include "tokenizer/chat_template_fallback_map.hpp"
+#include "tokenizer/incremental_detokenizer.hpp"
+#include "tokenizer/length_buckets.hpp"
+#include "tokenizer/lru_cache.hpp"
 #include "tokenizer/make_tokenizer_stateful.hpp"
+#include "tokenizer/prefix_reuse.hpp"
+#include "tokenizer/token_bytes.hpp"
 #include "tokenizer/tokenizers_path.hpp"
+#include "sampling/threadpool.hpp"
 #include "circular_buffer_queue.hpp"
 #include "json_utils.hpp"
 #include "utils.hpp"
@@ -103,13 +111,18 @@ std::string remap_and_patch(const std::string& chat_template) {
     );
 }
 
-std::vector<std::string> read_vocab_from_detokenizer_model(const std::shared_ptr<ov::Model>& model) {
+std::shared_ptr<ov::Node> find_vocab_decoder_node(const std::shared_ptr<ov::Model>& model) {
     std::shared_ptr<ov::Node> vocab_decoder_node;
     for (auto node: model->get_ordered_ops()) {
         if (node->get_friendly_name().find("VocabDecoder") != std::string::npos) {
             vocab_decoder_node = node;
         }
     }
+    return vocab_decoder_node;
+}
+
+std::vector<std::string> read_vocab_from_detokenizer_model(const std::shared_ptr<ov::Model>& model) {
+    auto vocab_decoder_node = find_vocab_decoder_node(model);
     if (!vocab_decoder_node) {
         return {};
     }
@@ -135,6 +148,36 @@ std::vector<std::string> read_vocab_from_detokenizer_model(const std::shared_ptr
     return vocab_vector;
 }
 
+// special tokens which are skipped by decoding with default parameters
+std::vector<int64_t> read_skip_tokens_from_detokenizer_model(const std::shared_ptr<ov::Model>& model) {
+    auto vocab_decoder_node = find_vocab_decoder_node(model);
+    if (!vocab_decoder_node || vocab_decoder_node->get_input_size() < 5) {
+        return {};
+    }
+    // MakeVocabDecoderSatateful puts a slice controlled by skip_special_tokens over the constant
+    auto skip_tokens_node = vocab_decoder_node->get_input_node_shared_ptr(4);
+    if (ov::is_type<ov::op::v8::Slice>(skip_tokens_node)) {
+        skip_tokens_node = skip_tokens_node->get_input_node_shared_ptr(0);
+    }
+    auto skip_tokens_const = ov::as_type_ptr<ov::op::v0::Constant>(skip_tokens_node);
+    if (!skip_tokens_const || !skip_tokens_const->get_element_type().is_integral_number()) {
+        return {};
+    }
+    return skip_tokens_const->cast_vector<int64_t>();
+}
+
+// decoding of such detokenizers is not concatenation of the vocabulary texts
+bool has_text_postprocessing(const std::shared_ptr<ov::Model>& model) {
+    for (const auto& node : model->get_ordered_ops()) {
+        const std::string type_name = node->get_type_info().name;
+        if (type_name == "RegexNormalization" || type_name == "CharsToBytes" ||
+            type_name == "CaseFold" || type_name == "NormalizeUnicode") {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace
 
 namespace ov {
@@ -148,6 +191,13 @@ public:
     // To change the adding special tokens mode we use a statefull subgraph,
     // this flag holds the current state value of the CompiledModel.
     std::unordered_map<ov::InferRequest*, ov::AnyMap> m_request_to_state_flags;
+    // infer requests are used from several threads, the map itself is guarded
+    std::mutex m_request_to_state_flags_mutex;
+
+    size_t m_num_tokenizer_requests = 1;
+    // encodes buckets of bulk requests, created on the first one
+    std::unique_ptr<ThreadPool> m_encode_thread_pool;
+    std::once_flag m_encode_thread_pool_flag;
 
     bool m_older_than_24_5 = false;
 
@@ -163,6 +213,19 @@ public:
 
     std::vector<std::string> m_vocab = {};
 
+    // token texts for incremental detokenization, computed on the first request
+    std::shared_ptr<const std::vector<std::string>> m_token_bytes;
+    std::once_flag m_token_bytes_flag;
+    std::vector<int64_t> m_skip_tokens;
+    bool m_has_text_postprocessing = true;
+    // SentencePiece vocabularies keep word boundaries and bytes as meta symbols
+    bool m_has_meta_symbols = true;
+
+    // results of encoding of single prompts, nullptr if the cache is disabled
+    std::unique_ptr<LRUCache<std::string, TokenizedInputs>> m_encode_cache;
+    // texts of special tokens the text is split by before tokenization, empty if tokens of a prefix can't be reused
+    std::unordered_map<int64_t, std::string> m_special_token_texts;
+
     template <typename T>
     void set_state_value(ov::VariableState& state, std::optional<T> value, ov::AnyMap& state_flags) {
         // better to store which value is in the state locally so that get_state is not called every infer request
@@ -207,7 +270,12 @@ public:
         ov::genai::utils::read_anymap_param(params, pad_to_max_length.name(), pad_to_max_length_val);
         ov::genai::utils::read_anymap_param(params, max_length.name(), max_length_val);
 
-        ov::AnyMap& state_flags = m_request_to_state_flags[&infer_request_guard.get()];
+        ov::AnyMap* state_flags_ptr;
+        {
+            std::lock_guard<std::mutex> lock(m_request_to_state_flags_mutex);
+            state_flags_ptr = &m_request_to_state_flags[&infer_request_guard.get()];
+        }
+        ov::AnyMap& state_flags = *state_flags_ptr;
         
         for (auto& state: infer_request_guard.get().query_state()) {
             auto name = state.get_name();
@@ -232,8 +300,10 @@ public:
         setup_tokenizer(models, properties);
     }
 
-    void setup_tokenizer(const std::filesystem::path& models_path, const ov::AnyMap& properties) {
+    void setup_tokenizer(const std::filesystem::path& models_path, const ov::AnyMap& tokenizer_properties) {
         ScopedVar env_manager(tokenizers_relative_to_genai());
+        ov::AnyMap properties = tokenizer_properties;
+        properties.erase(tokenization_cache_size.name());
         auto core = get_core_singleton();
 
         OPENVINO_ASSERT(models_path.extension() != ".xml", "'models_path' parameter should be a path to a dir not a xml file");
@@ -256,12 +326,20 @@ public:
         parse_if_exists(models_path / "tokenizer_config.json", m_chat_template);
         parse_if_exists(models_path / "processor_config.json", m_chat_template);
         parse_if_exists(models_path / "chat_template.json", m_chat_template);
-        setup_tokenizer(std::make_pair(ov_tokenizer, ov_detokenizer), properties);
+        setup_tokenizer(std::make_pair(ov_tokenizer, ov_detokenizer), tokenizer_properties);
     }
 
-    void setup_tokenizer(const std::pair<std::shared_ptr<ov::Model>, std::shared_ptr<ov::Model>>& models, const ov::AnyMap& properties) {
+    void setup_tokenizer(const std::pair<std::shared_ptr<ov::Model>, std::shared_ptr<ov::Model>>& models, const ov::AnyMap& tokenizer_properties) {
         auto [ov_tokenizer, ov_detokenizer] = models;
 
+        ov::AnyMap properties = tokenizer_properties;
+        size_t cache_size = 0;
+        ov::genai::utils::read_anymap_param(properties, tokenization_cache_size.name(), cache_size);
+        properties.erase(tokenization_cache_size.name());
+        if (cache_size > 0) {
+            m_encode_cache = std::make_unique<LRUCache<std::string, TokenizedInputs>>(cache_size);
+        }
+
         // temporary allow absense both tokenizer and detokenizer for GGUF support
         // TODO: remove this code once Tokenizers can be created from GGUF file
         if (!ov_tokenizer && !ov_detokenizer) {
@@ -284,8 +362,9 @@ public:
             ov::CompiledModel tokenizer = core.compile_model(ov_tokenizer, device, properties);
             ov::genai::utils::print_compiled_model_properties(tokenizer, "OV Tokenizer");
 
+            m_num_tokenizer_requests = tokenizer.get_property(ov::optimal_number_of_infer_requests);
             m_ireq_queue_tokenizer = std::make_unique<CircularBufferQueue<ov::InferRequest>>(
-                tokenizer.get_property(ov::optimal_number_of_infer_requests),
+                m_num_tokenizer_requests,
                 [&tokenizer]() -> ov::InferRequest {
                     return tokenizer.create_infer_request();
                 });
@@ -332,6 +411,23 @@ public:
             decode({1, 33, 199, 42, 42});
 
             m_vocab = read_vocab_from_detokenizer_model(ov_detokenizer);
+            m_skip_tokens = read_skip_tokens_from_detokenizer_model(ov_detokenizer);
+            m_has_text_postprocessing = has_text_postprocessing(ov_detokenizer);
+            m_has_meta_symbols = std::any_of(m_vocab.begin(), m_vocab.end(), [](const std::string& text) {
+                return text.find("\xe2\x96\x81") != std::string::npos || (text.size() == 6 && text.rfind("<0x", 0) == 0 && text.back() == '>');
+            });
+
+            // SentencePiece adds a word boundary to the beginning of every part of the text split by special tokens,
+            // so tokens of a part depend on where it begins
+            if (!m_has_meta_symbols) {
+                std::vector<int64_t> special_tokens = m_skip_tokens;
+                special_tokens.insert(special_tokens.end(), {m_bos_token_id, m_eos_token_id, m_pad_token_id});
+                for (int64_t token : special_tokens) {
+                    if (token >= 0 && static_cast<size_t>(token) < m_vocab.size() && !m_vocab[token].empty()) {
+                        m_special_token_texts.emplace(token, m_vocab[token]);
+                    }
+                }
+            }
         }
     }
 
@@ -459,16 +555,77 @@ public:
         OPENVINO_ASSERT(m_ireq_queue_tokenizer, "Either openvino_tokenizer.xml was not provided or it was not loaded correctly. "
                                                 "Tokenizer::encode is not available");
 
+        std::string cache_key;
+        if (m_encode_cache) {
+            cache_key = get_encode_cache_key(prompt, tokenization_params);
+            if (auto cached = m_encode_cache->get(cache_key)) {
+                // callers own the returned tensors and may modify them
+                return get_copied_results(cached->input_ids, cached->attention_mask);
+            }
+        }
+
         CircularBufferQueueElementGuard<ov::InferRequest> infer_request_guard(m_ireq_queue_tokenizer.get());
         set_state_if_necessary(infer_request_guard, tokenization_params);
         size_t batch_size = 1;
         infer_request_guard.get().set_input_tensor(ov::Tensor{ov::element::string, {batch_size}, &prompt});
         infer_request_guard.get().infer();
 
-        return get_copied_results(
+        TokenizedInputs result = get_copied_results(
             infer_request_guard.get().get_tensor("input_ids"),
             infer_request_guard.get().get_tensor("attention_mask")
         );
+        if (m_encode_cache) {
+            m_encode_cache->put(cache_key, get_copied_results(result.input_ids, result.attention_mask));
+        }
+        return result;
+    }
+
+    std::string get_encode_cache_key(const std::string& prompt, const ov::AnyMap& tokenization_params) const {
+        // defaults are the same as in set_state_if_necessary
+        bool add_special_tokens_flag = true;
+        std::optional<int32_t> max_length_val;
+        bool pad_to_max_length_flag = false;
+        ov::genai::utils::read_anymap_param(tokenization_params, add_special_tokens.name(), add_special_tokens_flag);
+        ov::genai::utils::read_anymap_param(tokenization_params, max_length.name(), max_length_val);
+        ov::genai::utils::read_anymap_param(tokenization_params, pad_to_max_length.name(), pad_to_max_length_flag);
+
+        std::string key = std::to_string(add_special_tokens_flag) + std::to_string(pad_to_max_length_flag);
+        key += max_length_val.has_value() ? std::to_string(*max_length_val) : "-";
+        return key + '\n' + prompt;
+    }
+
+    TokenizedInputs encode_with_prefix(const std::string& prompt,
+                                       const std::string& prefix,
+                                       const std::vector<int64_t>& prefix_ids,
+                                       const ov::AnyMap& tokenization_params) {
+        bool add_special_tokens_flag = true;
+        std::optional<int32_t> max_length_val;
+        bool pad_to_max_length_flag = false;
+        ov::genai::utils::read_anymap_param(tokenization_params, add_special_tokens.name(), add_special_tokens_flag);
+        ov::genai::utils::read_anymap_param(tokenization_params, max_length.name(), max_length_val);
+        ov::genai::utils::read_anymap_param(tokenization_params, pad_to_max_length.name(), pad_to_max_length_flag);
+
+        // added special tokens, truncation and padding depend on the whole text, tokenizers older than 24.5 always
+        // add special tokens
+        if (add_special_tokens_flag || max_length_val.has_value() || pad_to_max_length_flag || m_older_than_24_5 || m_special_token_texts.empty())
+            return encode(prompt, tokenization_params);
+
+        auto [num_reused_tokens, num_reused_chars] = find_reusable_prefix(prefix, prefix_ids, get_common_prefix_length(prefix, prompt), m_special_token_texts);
+        if (num_reused_tokens == 0)
+            return encode(prompt, tokenization_params);
+
+        ov::Tensor suffix_ids{ov::element::i64, {1, 0}};
+        if (num_reused_chars < prompt.size()) {
+            suffix_ids = encode(prompt.substr(num_reused_chars), tokenization_params).input_ids;
+        }
+        const size_t suffix_len = suffix_ids.get_shape().at(1);
+
+        ov::Tensor input_ids{ov::element::i64, {1, num_reused_tokens + suffix_len}};
+        std::copy_n(prefix_ids.begin(), num_reused_tokens, input_ids.data<int64_t>());
+        std::copy_n(suffix_ids.data<int64_t>(), suffix_len, input_ids.data<int64_t>() + num_reused_tokens);
+        ov::Tensor attention_mask{ov::element::i64, input_ids.get_shape()};
+        std::fill_n(attention_mask.data<int64_t>(), attention_mask.get_size(), 1);
+        return {input_ids, attention_mask};
     }
 
     TokenizedInputs encode(std::vector<std::string>& prompts, const ov::AnyMap& tokenization_params = {}) {
@@ -492,6 +649,57 @@ public:
         return {unpadded.input_ids, unpadded.attention_mask};
     }
 
+    std::vector<TokenizedBucket> encode_bucketed(const std::vector<std::string>& prompts,
+                                                 size_t bucket_size,
+                                                 const ov::AnyMap& tokenization_params) {
+        OPENVINO_ASSERT(m_ireq_queue_tokenizer, "Either openvino_tokenizer.xml was not provided or it was not loaded correctly. "
+                                                "Tokenizer::encode is not available");
+        std::call_once(m_encode_thread_pool_flag, [this] {
+            // more threads than infer requests would wait for idle ones
+            m_encode_thread_pool = std::make_unique<ThreadPool>(std::max<size_t>(1, m_num_tokenizer_requests));
+        });
+
+        std::vector<TokenizedBucket> buckets;
+        for (auto& prompt_indices : split_into_length_buckets(prompts, bucket_size)) {
+            buckets.push_back(TokenizedBucket{std::move(prompt_indices), {}});
+        }
+        m_encode_thread_pool->parallel_for(buckets.size(), [&](size_t bucket_idx) {
+            TokenizedBucket& bucket = buckets[bucket_idx];
+            std::vector<std::string> bucket_prompts;
+            bucket_prompts.reserve(bucket.prompt_indices.size());
+            for (size_t prompt_idx : bucket.prompt_indices) {
+                bucket_prompts.push_back(prompts[prompt_idx]);
+            }
+            bucket.inputs = encode(bucket_prompts, tokenization_params);
+        });
+        return buckets;
+    }
+
+    std::vector<std::vector<int64_t>> encode_ragged(const std::vector<std::string>& prompts,
+                                                    size_t bucket_size,
+                                                    const ov::AnyMap& tokenization_params) {
+        std::vector<std::vector<int64_t>> tokens(prompts.size());
+        for (const TokenizedBucket& bucket : encode_bucketed(prompts, bucket_size, tokenization_params)) {
+            const ov::Tensor& input_ids = bucket.inputs.input_ids;
+            const ov::Tensor& attention_mask = bucket.inputs.attention_mask;
+            const size_t seq_len = input_ids.get_shape().at(1);
+            OPENVINO_ASSERT(input_ids.get_shape().at(0) == bucket.prompt_indices.size(),
+                            "Tokenizer returned ", input_ids.get_shape().at(0), " sequences for ", bucket.prompt_indices.size(), " prompts");
+            // padding can be on either side, the mask tells which tokens belong to the prompt
+            for (size_t row = 0; row < bucket.prompt_indices.size(); ++row) {
+                const int64_t* ids = input_ids.data<const int64_t>() + row * seq_len;
+                const int64_t* mask = attention_mask.data<const int64_t>() + row * seq_len;
+                std::vector<int64_t>& prompt_tokens = tokens[bucket.prompt_indices[row]];
+                for (size_t position = 0; position < seq_len; ++position) {
+                    if (mask[position] != 0) {
+                        prompt_tokens.push_back(ids[position]);
+                    }
+                }
+            }
+        }
+        return tokens;
+    }
+
     TokenizedInputs get_copied_results(ov::Tensor input_ids, ov::Tensor attention_mask) {
         ov::Tensor input_ids_ = ov::Tensor(input_ids.get_element_type(), input_ids.get_shape());
         ov::Tensor attention_mask_ = ov::Tensor(attention_mask.get_element_type(), attention_mask.get_shape());
@@ -554,6 +762,45 @@ public:
         return std::vector<std::string>(res_data, res_data + res.get_shape()[0]);
     }
 
+    std::shared_ptr<const std::vector<std::string>> get_token_bytes() {
+        std::call_once(m_token_bytes_flag, [this] {
+            // meta symbols of SentencePiece vocabularies differ from decoded text
+            if (m_has_text_postprocessing || m_has_meta_symbols || m_vocab.empty() || !m_ireq_queue_detokenizer)
+                return;
+
+            auto token_bytes = std::make_shared<std::vector<std::string>>(m_vocab);
+            std::vector<int64_t> special_tokens = m_skip_tokens;
+            special_tokens.insert(special_tokens.end(), {m_bos_token_id, m_eos_token_id, m_pad_token_id});
+            for (int64_t token : special_tokens) {
+                if (token >= 0 && static_cast<size_t>(token) < token_bytes->size()) {
+                    (*token_bytes)[token].clear();
+                }
+            }
+
+            // the graph check does not cover every detokenizer, so decoding of evenly spaced tokens is compared with
+            // concatenation of their texts
+            constexpr size_t num_probe_tokens = 64;
+            const size_t stride = std::max<size_t>(1, token_bytes->size() / num_probe_tokens);
+            std::vector<int64_t> probe_tokens;
+            std::string expected_text;
+            for (size_t token = 0; token < token_bytes->size(); token += stride) {
+                const std::string& text = (*token_bytes)[token];
+                if (!text.empty() && IncrementalDetokenizer::is_valid_utf8(text)) {
+                    probe_tokens.push_back(token);
+                    expected_text += text;
+                }
+            }
+            try {
+                if (probe_tokens.empty() || decode(probe_tokens) != expected_text)
+                    return;
+            } catch (const ov::Exception&) {
+                return;
+            }
+            m_token_bytes = token_bytes;
+        });
+        return m_token_bytes;
+    }
+
     std::string apply_chat_template(ChatHistory history,
                                     bool add_generation_prompt,
                                     const std::string& chat_template) const {
@@ -666,6 +913,28 @@ TokenizedInputs Tokenizer::encode(const std::string prompt, const ov::AnyMap& to
     return m_pimpl->encode(std::move(prompt), tokenization_params);
 }
 
+std::vector<std::vector<int64_t>> Tokenizer::encode_ragged(const std::vector<std::string>& prompts,
+                                                          size_t bucket_size,
+                                                          const ov::AnyMap& tokenization_params) {
+    check_arguments(tokenization_params, {ov::genai::add_special_tokens.name(), ov::genai::max_length.name(), ov::genai::pad_to_max_length.name()});
+    return m_pimpl->encode_ragged(prompts, bucket_size, tokenization_params);
+}
+
+std::vector<TokenizedBucket> Tokenizer::encode_bucketed(const std::vector<std::string>& prompts,
+                                                        size_t bucket_size,
+                                                        const ov::AnyMap& tokenization_params) {
+    check_arguments(tokenization_params, {ov::genai::add_special_tokens.name(), ov::genai::max_length.name(), ov::genai::pad_to_max_length.name()});
+    return m_pimpl->encode_bucketed(prompts, bucket_size, tokenization_params);
+}
+
+TokenizedInputs Tokenizer::encode_with_prefix(const std::string& prompt,
+                                              const std::string& prefix,
+                                              const std::vector<int64_t>& prefix_ids,
+                                              const ov::AnyMap& tokenization_params) {
+    check_arguments(tokenization_params, {ov::genai::add_special_tokens.name(), ov::genai::max_length.name(), ov::genai::pad_to_max_length.name()});
+    return m_pimpl->encode_with_prefix(prompt, prefix, prefix_ids, tokenization_params);
+}
+
 TokenizedInputs Tokenizer::encode(std::vector<std::string>& prompts, const ov::AnyMap& tokenization_params) {
     check_arguments(tokenization_params, {ov::genai::add_special_tokens.name(), ov::genai::max_length.name(), ov::genai::pad_to_max_length.name()});
     return m_pimpl->encode(prompts, tokenization_params);
@@ -746,6 +1015,10 @@ Vocab Tokenizer::get_vocab() const {
     return vocab;
 }
 
+std::shared_ptr<const std::vector<std::string>> get_token_bytes(const Tokenizer& tokenizer) {
+    return tokenizer.m_pimpl ? tokenizer.m_pimpl->get_token_bytes() : nullptr;
+}
+
 Tokenizer::~Tokenizer() = default;
 }  // namespace genai
 }  // namespace ov
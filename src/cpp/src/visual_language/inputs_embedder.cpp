@@ -35,6 +35,8 @@ void InputsEmbedder::IInputsEmbedder::start_chat(const std::string& system_messa
         m_history.clear();
         m_kv_cache_state.reset_state();
     }
+    m_templated_chat_history.clear();
+    m_templated_chat_history_ids.clear();
     if (system_message.empty()) {
         return;
     }
@@ -63,6 +65,8 @@ void InputsEmbedder::IInputsEmbedder::finish_chat() {
     m_image_id = 0;
     m_is_chat_conversation = false;
     m_history.clear();
+    m_templated_chat_history.clear();
+    m_templated_chat_history_ids.clear();
     m_kv_cache_state.reset_state();
 }
 
@@ -111,9 +115,11 @@ ov::Tensor InputsEmbedder::IInputsEmbedder::apply_chat_template_tokenize(const s
         std::string new_templated_chat_history;
         new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
         auto start_tokenizer_time = std::chrono::steady_clock::now();
-        ov::Tensor new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false)).input_ids;
+        ov::Tensor new_chat_tokens = m_tokenizer.encode_with_prefix(new_templated_chat_history, m_templated_chat_history, m_templated_chat_history_ids, ov::genai::add_special_tokens(false)).input_ids;
         auto end_tokenizer_time = std::chrono::steady_clock::now();
         metrics.raw_metrics.tokenization_durations.emplace_back(PerfMetrics::get_microsec(end_tokenizer_time - start_tokenizer_time));
+        m_templated_chat_history = std::move(new_templated_chat_history);
+        m_templated_chat_history_ids.assign(new_chat_tokens.data<int64_t>(), new_chat_tokens.data<int64_t>() + new_chat_tokens.get_size());
         return new_chat_tokens;
     } else {
         ov::Tensor encoded_input_ids;
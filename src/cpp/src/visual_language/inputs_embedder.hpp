@@ -85,6 +85,9 @@ private:
         bool m_is_chat_conversation = false;
         // Chat history
         ChatHistory m_history;
+        // Templated history of the previous turn and its tokens, which are reused when the next turn is tokenized
+        std::string m_templated_chat_history;
+        std::vector<int64_t> m_templated_chat_history_ids;
         // True if chat template should be applied for non-chat scenario
         bool m_apply_chat_template = true;
         // Finish reason of last generation for chat scenario
@@ -48,6 +48,7 @@ from .py_openvino_genai import (
 
 # Tokenizers
 from .py_openvino_genai import (
+    TokenizedBucket,
     TokenizedInputs,
     Tokenizer
 )
@@ -90,7 +91,8 @@ from .py_openvino_genai import (
     GenerationStatus,
     SchedulerConfig,
     CacheEvictionConfig,
-    AggregationMode
+    AggregationMode,
+    SchedulingPolicy
 )
 
 # RAG
@@ -5,7 +5,7 @@ from __future__ import annotations
 import openvino._pyopenvino
 import os
 import typing
-__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'InpaintingPipeline', 'LLMPipeline', 'MeanStdPair', 'PerfMetrics', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'SD3Transformer2DModel', 'Scheduler', 'SchedulerConfig', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'T5EncoderModel', 'Text2ImagePipeline', 'TextEmbeddingPipeline', 'TextStreamer', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
+__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationDelta', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'InpaintingPipeline', 'LLMPipeline', 'MeanStdPair', 'PerfMetrics', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'SD3Transformer2DModel', 'Scheduler', 'SchedulerConfig', 'SchedulingPolicy', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'T5EncoderModel', 'Text2ImagePipeline', 'TextEmbeddingPipeline', 'TextStreamer', 'TokenizedBucket', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
 class Adapter:
     """
     Immutable LoRA Adapter that carries the adaptation matrices and serves as unique adapter identifier.
@@ -295,10 +295,23 @@ class CacheEvictionConfig:
           Set this to false if your model has different RoPE scheme from the one used in the
           original llama model and you experience accuracy issues with cache eviction enabled.
         :type apply_rotation: bool
+    
+        :param evict_during_prefill: Whether to evict blocks after each chunk of the prompt is processed, based on the
+          attention scores of the prompt chunks processed so far. Limits the KV cache usage of long prompts processed with
+          `SchedulerConfig.dynamic_split_fuse` to about `max_cache_size` plus the chunk size. Not compatible with
+          `SchedulerConfig.enable_prefix_caching`.
+        :type evict_during_prefill: bool
+    
+        :param snapkv_window_size: Number of the last prompt tokens used as the observation window (SnapKV). If non-zero,
+          the prompt blocks kept after prefill are selected only by the attention scores of the queries in this window.
+          Requires `SchedulerConfig.dynamic_split_fuse`. Zero disables the window.
+        :type snapkv_window_size: int
     """
     aggregation_mode: AggregationMode
     apply_rotation: bool
-    def __init__(self, start_size: int, recent_size: int, max_cache_size: int, aggregation_mode: AggregationMode, apply_rotation: bool = False) -> None:
+    evict_during_prefill: bool
+    snapkv_window_size: int
+    def __init__(self, start_size: int, recent_size: int, max_cache_size: int, aggregation_mode: AggregationMode, apply_rotation: bool = False, evict_during_prefill: bool = False, snapkv_window_size: int = 0) -> None:
         ...
     def get_evictable_size(self) -> int:
         ...
@@ -329,7 +342,14 @@ class ChunkStreamerBase(StreamerBase):
         """
 class ContinuousBatchingPipeline:
     """
-    This class is used for generation with LLMs with continuous batchig
+    
+        This class is used for generation with LLMs with continuous batchig
+    
+        Besides plugin properties, `properties` accept pipeline options:
+        async_step:             if True, the model inference of a step overlaps with stop strings matching and streaming
+            of the previous step. Outputs are the same, but a request reaching a stop string takes one extra step.
+        stream_detokenization:  if True, outputs read from handles carry the text of generated tokens, decoded in batches
+            after every step.
     """
     @typing.overload
     def __init__(self, models_path: os.PathLike, scheduler_config: SchedulerConfig, device: str, properties: dict[str, typing.Any] = {}, tokenizer_properties: dict[str, typing.Any] = {}, vision_encoder_properties: dict[str, typing.Any] = {}) -> None:
@@ -346,6 +366,10 @@ class ContinuousBatchingPipeline:
     @typing.overload
     def add_request(self, request_id: int, prompt: str, images: list[openvino._pyopenvino.Tensor], generation_config: GenerationConfig) -> GenerationHandle:
         ...
+    def dump_trace(self, path: os.PathLike) -> None:
+        """
+        Writes spans of the recent generation steps as Chrome trace JSON. Tracing must be enabled by OV_GENAI_STEP_TRACE environment variable or step_trace_capacity property.
+        """
     @typing.overload
     def generate(self, input_ids: list[openvino._pyopenvino.Tensor], generation_config: list[GenerationConfig], streamer: typing.Callable[[str], int | None] | StreamerBase | None = None) -> list[EncodedGenerationResult]:
         ...
@@ -552,8 +576,14 @@ class GenerationConfig:
         top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
         do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
         num_return_sequences: the number of sequences to generate from a single prompt.
+    
+        Scheduling parameters (have effect only in ContinuousBatchingPipeline with SchedulingPolicy.PRIORITY):
+        priority:           priority of the request, requests with higher values are admitted first and preempted last.
+        ttft_deadline_ms:   target time to first token in milliseconds counted from the request arrival. Among requests of the same
+                            priority, the ones with the earliest deadline are scheduled first. 0 means no deadline.
     """
     adapters: AdapterConfig | None
+    adaptive_num_assistant_tokens: bool
     apply_chat_template: bool
     assistant_confidence_threshold: float
     diversity_penalty: float
@@ -570,11 +600,14 @@ class GenerationConfig:
     max_ngram_size: int
     min_new_tokens: int
     no_repeat_ngram_size: int
+    num_assistant_branches: int
     num_assistant_tokens: int
     num_beam_groups: int
     num_beams: int
     num_return_sequences: int
     presence_penalty: float
+    priority: int
+    rank_ngram_candidates_by_frequency: bool
     repetition_penalty: float
     rng_seed: int
     stop_criteria: StopCriteria
@@ -583,6 +616,7 @@ class GenerationConfig:
     temperature: float
     top_k: int
     top_p: float
+    ttft_deadline_ms: int
     @typing.overload
     def __init__(self, json_path: os.PathLike) -> None:
         """
@@ -647,6 +681,19 @@ class GenerationFinishReason:
     @property
     def value(self) -> int:
         ...
+class GenerationDelta:
+    @property
+    def finish_reason(self) -> GenerationFinishReason:
+        ...
+    @property
+    def log_prob(self) -> float:
+        ...
+    @property
+    def sequence_id(self) -> int:
+        ...
+    @property
+    def token_id(self) -> int:
+        ...
 class GenerationHandle:
     def can_read(self) -> bool:
         ...
@@ -660,6 +707,8 @@ class GenerationHandle:
         ...
     def read_all(self) -> list[GenerationOutput]:
         ...
+    def read_available(self) -> list[GenerationDelta]:
+        ...
     def stop(self) -> None:
         ...
 class GenerationOutput:
@@ -667,6 +716,7 @@ class GenerationOutput:
     generated_ids: list[int]
     generated_log_probs: list[float]
     score: float
+    text: str
 class GenerationResult:
     """
     
@@ -1137,6 +1187,11 @@ class LLMPipeline:
             top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
             do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
             num_return_sequences: the number of sequences to generate from a single prompt.
+        
+            Scheduling parameters (have effect only in ContinuousBatchingPipeline with SchedulingPolicy.PRIORITY):
+            priority:           priority of the request, requests with higher values are admitted first and preempted last.
+            ttft_deadline_ms:   target time to first token in milliseconds counted from the request arrival. Among requests of the same
+                                priority, the ones with the earliest deadline are scheduled first. 0 means no deadline.
         """
     @typing.overload
     def __init__(self, models_path: os.PathLike, tokenizer: Tokenizer, device: str, config: dict[str, typing.Any] = {}, **kwargs) -> None:
@@ -1234,6 +1289,11 @@ class LLMPipeline:
             top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
             do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
             num_return_sequences: the number of sequences to generate from a single prompt.
+        
+            Scheduling parameters (have effect only in ContinuousBatchingPipeline with SchedulingPolicy.PRIORITY):
+            priority:           priority of the request, requests with higher values are admitted first and preempted last.
+            ttft_deadline_ms:   target time to first token in milliseconds counted from the request arrival. Among requests of the same
+                                priority, the ones with the earliest deadline are scheduled first. 0 means no deadline.
         """
     def get_generation_config(self) -> GenerationConfig:
         ...
@@ -1357,6 +1417,12 @@ class PipelineMetrics:
     
         :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
         :type avg_cache_usage: float
+    
+        :param forecast_cache_usage: Percentage of KV cache reserved by admission control for the admitted requests in the last generation step, i.e. their forecast KV cache usage.
+        :type forecast_cache_usage: float
+    
+        :param deferred_requests: Number of requests whose admission for processing was deferred in the last generation step.
+        :type deferred_requests: int
     """
     def __init__(self) -> None:
         ...
@@ -1367,6 +1433,12 @@ class PipelineMetrics:
     def cache_usage(self) -> float:
         ...
     @property
+    def deferred_requests(self) -> int:
+        ...
+    @property
+    def forecast_cache_usage(self) -> float:
+        ...
+    @property
     def max_cache_usage(self) -> float:
         ...
     @property
@@ -1593,17 +1665,84 @@ class SchedulerConfig:
             This results in more RAM usage, maximum RAM usage is determined by cache_size or num_kv_blocks parameters.
             When turned off only KV-cache required for batch calculation is kept in memory and
             when a sequence has finished generation its cache is released.
-    """
+        persistent_prefix_cache_dir:  directory for the persistent tier of the prefix cache.
+            When set and enable_prefix_caching is turned on, KV-blocks overridden in memory are saved to files in this directory
+            and restored from there when a new prompt shares the prefix, including after the pipeline restart.
+        persistent_prefix_cache_size: total size of the persistent prefix cache in GB, 0 means unlimited.
+        swap_space:                 size of the host memory pool in GB for KV-blocks of preempted sequences.
+            When set, a preempted sequence is either swapped to this pool and back or recomputed, whichever is estimated to be cheaper.
+            0 means that preempted sequences are always recomputed. Has no effect with prefix caching or cache eviction.
+        scheduling_policy:          order in which requests are admitted and preempted, see openvino_genai.SchedulingPolicy.
+        priority_aging_interval_ms: with SchedulingPolicy.PRIORITY, the priority of a request is raised by one for each
+            priority_aging_interval_ms milliseconds it spends in the pipeline, so low priority requests are not starved. 0 disables aging.
+        enable_admission_control:   whether requests are admitted for scheduling only while the sum of their forecast KV-cache demands
+            fits into the KV-cache. Requests that don't fit wait instead of being preempted later. Has no effect if the KV-cache is allocated dynamically.
+        admission_headroom:         fraction of the KV-cache which admission control keeps unreserved, to absorb forecast errors.
+        forecast_average_output_len: whether admission control forecasts the output length of a request as the running average of the output
+            lengths of finished requests (capped by max_new_tokens) instead of max_new_tokens.
+        default_forecast_output_len: output length which admission control forecasts for requests with neither max_new_tokens
+            nor max_length set, until the average output length of finished requests is known.
+    """
+    admission_headroom: float
     cache_eviction_config: CacheEvictionConfig
     cache_size: int
+    default_forecast_output_len: int
     dynamic_split_fuse: bool
+    enable_admission_control: bool
     enable_prefix_caching: bool
+    forecast_average_output_len: bool
     max_num_batched_tokens: int
     max_num_seqs: int
     num_kv_blocks: int
+    persistent_prefix_cache_dir: str
+    persistent_prefix_cache_size: int
+    priority_aging_interval_ms: int
+    scheduling_policy: SchedulingPolicy
+    swap_space: int
     use_cache_eviction: bool
     def __init__(self) -> None:
         ...
+class SchedulingPolicy:
+    """
+    Represents the order in which requests are admitted and preempted by the scheduler
+                                   :param SchedulingPolicy.FCFS: Requests are served in the arrival order, the latest ones are preempted first
+                                   :param SchedulingPolicy.PRIORITY: Requests are served in the order of GenerationConfig.priority raised by aging, with the earliest GenerationConfig.ttft_deadline_ms first among equal ones; the lowest priority ones are preempted first
+    
+    Members:
+    
+      FCFS
+    
+      PRIORITY
+    """
+    FCFS: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.FCFS: 0>
+    PRIORITY: typing.ClassVar[SchedulingPolicy]  # value = <SchedulingPolicy.PRIORITY: 1>
+    __members__: typing.ClassVar[dict[str, SchedulingPolicy]]  # value = {'FCFS': <SchedulingPolicy.FCFS: 0>, 'PRIORITY': <SchedulingPolicy.PRIORITY: 1>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class StopCriteria:
     """
     
@@ -1972,6 +2111,16 @@ class TokenizedInputs:
     input_ids: openvino._pyopenvino.Tensor
     def __init__(self, input_ids: openvino._pyopenvino.Tensor, attention_mask: openvino._pyopenvino.Tensor) -> None:
         ...
+class TokenizedBucket:
+    """
+    Prompts of similar length encoded together by Tokenizer.encode_bucketed.
+    """
+    @property
+    def inputs(self) -> TokenizedInputs:
+        ...
+    @property
+    def prompt_indices(self) -> list[int]:
+        ...
 class Tokenizer:
     """
     
@@ -2026,6 +2175,18 @@ class Tokenizer:
         """
         Encodes a single prompt into tokenized input.
         """
+    def encode_bucketed(self, prompts: list[str], bucket_size: int = 16, add_special_tokens: bool = True, pad_to_max_length: bool = False, max_length: int | None = None) -> list[TokenizedBucket]:
+        """
+        Encodes a list of prompts in parallel, grouping prompts of similar length into padded buckets.
+        """
+    def encode_ragged(self, prompts: list[str], bucket_size: int = 16, add_special_tokens: bool = True, max_length: int | None = None) -> list[list[int]]:
+        """
+        Encodes a list of prompts in parallel into token lists without padding, in order of prompts.
+        """
+    def encode_with_prefix(self, prompt: str, prefix: str, prefix_ids: list[int], add_special_tokens: bool = True) -> TokenizedInputs:
+        """
+        Encodes a prompt which extends a previously encoded prefix, reusing tokens of the prefix where possible.
+        """
     def get_bos_token(self) -> str:
         ...
     def get_bos_token_id(self) -> int:
@@ -23,9 +23,11 @@ using ov::genai::GenerationResult;
 using ov::genai::EncodedGenerationResult;
 using ov::genai::GenerationHandleImpl;
 using ov::genai::GenerationOutput;
+using ov::genai::GenerationDelta;
 using ov::genai::GenerationFinishReason;
 using ov::genai::GenerationStatus;
 using ov::genai::SchedulerConfig;
+using ov::genai::SchedulingPolicy;
 using ov::genai::PipelineMetrics;
 
 namespace {
@@ -48,6 +50,17 @@ auto cache_eviction_config_docstring = R"(
       Set this to false if your model has different RoPE scheme from the one used in the
       original llama model and you experience accuracy issues with cache eviction enabled.
     :type apply_rotation: bool
+
+    :param evict_during_prefill: Whether to evict blocks after each chunk of the prompt is processed, based on the
+      attention scores of the prompt chunks processed so far. Limits the KV cache usage of long prompts processed with
+      `SchedulerConfig.dynamic_split_fuse` to about `max_cache_size` plus the chunk size. Not compatible with
+      `SchedulerConfig.enable_prefix_caching`.
+    :type evict_during_prefill: bool
+
+    :param snapkv_window_size: Number of the last prompt tokens used as the observation window (SnapKV). If non-zero,
+      the prompt blocks kept after prefill are selected only by the attention scores of the queries in this window.
+      Requires `SchedulerConfig.dynamic_split_fuse`. Zero disables the window.
+    :type snapkv_window_size: int
 )";
 
 auto scheduler_config_docstring = R"(
@@ -69,6 +82,23 @@ auto scheduler_config_docstring = R"(
         This results in more RAM usage, maximum RAM usage is determined by cache_size or num_kv_blocks parameters.
         When turned off only KV-cache required for batch calculation is kept in memory and
         when a sequence has finished generation its cache is released.
+    persistent_prefix_cache_dir:  directory for the persistent tier of the prefix cache.
+        When set and enable_prefix_caching is turned on, KV-blocks overridden in memory are saved to files in this directory
+        and restored from there when a new prompt shares the prefix, including after the pipeline restart.
+    persistent_prefix_cache_size: total size of the persistent prefix cache in GB, 0 means unlimited.
+    swap_space:                 size of the host memory pool in GB for KV-blocks of preempted sequences.
+        When set, a preempted sequence is either swapped to this pool and back or recomputed, whichever is estimated to be cheaper.
+        0 means that preempted sequences are always recomputed. Has no effect with prefix caching or cache eviction.
+    scheduling_policy:          order in which requests are admitted and preempted, see openvino_genai.SchedulingPolicy.
+    priority_aging_interval_ms: with SchedulingPolicy.PRIORITY, the priority of a request is raised by one for each
+        priority_aging_interval_ms milliseconds it spends in the pipeline, so low priority requests are not starved. 0 disables aging.
+    enable_admission_control:   whether requests are admitted for scheduling only while the sum of their forecast KV-cache demands
+        fits into the KV-cache. Requests that don't fit wait instead of being preempted later. Has no effect if the KV-cache is allocated dynamically.
+    admission_headroom:         fraction of the KV-cache which admission control keeps unreserved, to absorb forecast errors.
+    forecast_average_output_len: whether admission control forecasts the output length of a request as the running average of the output
+        lengths of finished requests (capped by max_new_tokens) instead of max_new_tokens.
+    default_forecast_output_len: output length which admission control forecasts for requests with neither max_new_tokens
+        nor max_length set, until the average output length of finished requests is known.
 )";
 
 auto generation_result_docstring = R"(
@@ -110,6 +140,22 @@ auto pipeline_metrics_docstring = R"(
 
     :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
     :type avg_cache_usage: float
+
+    :param forecast_cache_usage: Percentage of KV cache reserved by admission control for the admitted requests in the last generation step, i.e. their forecast KV cache usage.
+    :type forecast_cache_usage: float
+
+    :param deferred_requests: Number of requests whose admission for processing was deferred in the last generation step.
+    :type deferred_requests: int
+)";
+
+auto continuous_batching_pipeline_docstring = R"(
+    This class is used for generation with LLMs with continuous batchig
+
+    Besides plugin properties, `properties` accept pipeline options:
+    async_step:             if True, the model inference of a step overlaps with stop strings matching and streaming
+        of the previous step. Outputs are the same, but a request reaching a stop string takes one extra step.
+    stream_detokenization:  if True, outputs read from handles carry the text of generated tokens, decoded in batches
+        after every step.
 )";
 
 std::ostream& operator << (std::ostream& stream, const GenerationResult& generation_result) {
@@ -204,7 +250,14 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def_readwrite("generated_ids", &GenerationOutput::generated_ids)
         .def_readwrite("generated_log_probs", &GenerationOutput::generated_log_probs)
         .def_readwrite("score", &GenerationOutput::score)
-        .def_readwrite("finish_reason", &GenerationOutput::finish_reason);
+        .def_readwrite("finish_reason", &GenerationOutput::finish_reason)
+        .def_readwrite("text", &GenerationOutput::text);
+
+    py::class_<GenerationDelta>(m, "GenerationDelta")
+        .def_readonly("sequence_id", &GenerationDelta::sequence_id)
+        .def_readonly("token_id", &GenerationDelta::token_id)
+        .def_readonly("log_prob", &GenerationDelta::log_prob)
+        .def_readonly("finish_reason", &GenerationDelta::finish_reason);
 
     auto generation_handle = py::class_<GenerationHandleImpl, std::shared_ptr<GenerationHandleImpl>>(m, "GenerationHandle")
         .def("get_status", &GenerationHandleImpl::get_status)
@@ -212,7 +265,12 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def("stop", &GenerationHandleImpl::stop)
         .def("cancel", &GenerationHandleImpl::cancel)
         .def("read", &GenerationHandleImpl::read)
-        .def("read_all", &GenerationHandleImpl::read_all);
+        .def("read_all", &GenerationHandleImpl::read_all)
+        .def("read_available", [](GenerationHandleImpl& handle) {
+            std::vector<GenerationDelta> deltas;
+            handle.read_available(deltas);
+            return deltas;
+        });
     OPENVINO_SUPPRESS_DEPRECATED_START
     generation_handle.def("drop", &GenerationHandleImpl::drop);
     OPENVINO_SUPPRESS_DEPRECATED_END
@@ -225,12 +283,21 @@ void init_continuous_batching_pipeline(py::module_& m) {
             .value("SUM", AggregationMode::SUM)
             .value("NORM_SUM", AggregationMode::NORM_SUM);
 
+    py::enum_<SchedulingPolicy>(m, "SchedulingPolicy",
+                            R"(Represents the order in which requests are admitted and preempted by the scheduler
+                               :param SchedulingPolicy.FCFS: Requests are served in the arrival order, the latest ones are preempted first
+                               :param SchedulingPolicy.PRIORITY: Requests are served in the order of GenerationConfig.priority raised by aging, with the earliest GenerationConfig.ttft_deadline_ms first among equal ones; the lowest priority ones are preempted first)")
+            .value("FCFS", SchedulingPolicy::FCFS)
+            .value("PRIORITY", SchedulingPolicy::PRIORITY);
+
     py::class_<CacheEvictionConfig>(m, "CacheEvictionConfig", cache_eviction_config_docstring)
-            .def(py::init<>([](const size_t start_size, size_t recent_size, size_t max_cache_size, AggregationMode aggregation_mode, bool apply_rotation) {
-                return CacheEvictionConfig{start_size, recent_size, max_cache_size, aggregation_mode, apply_rotation}; }),
-                 py::arg("start_size"), py::arg("recent_size"), py::arg("max_cache_size"), py::arg("aggregation_mode"), py::arg("apply_rotation") = false)
+            .def(py::init<>([](const size_t start_size, size_t recent_size, size_t max_cache_size, AggregationMode aggregation_mode, bool apply_rotation, bool evict_during_prefill, size_t snapkv_window_size) {
+                return CacheEvictionConfig{start_size, recent_size, max_cache_size, aggregation_mode, apply_rotation, evict_during_prefill, snapkv_window_size}; }),
+                 py::arg("start_size"), py::arg("recent_size"), py::arg("max_cache_size"), py::arg("aggregation_mode"), py::arg("apply_rotation") = false, py::arg("evict_during_prefill") = false, py::arg("snapkv_window_size") = 0)
             .def_readwrite("aggregation_mode", &CacheEvictionConfig::aggregation_mode)
             .def_readwrite("apply_rotation", &CacheEvictionConfig::apply_rotation)
+            .def_readwrite("evict_during_prefill", &CacheEvictionConfig::evict_during_prefill)
+            .def_readwrite("snapkv_window_size", &CacheEvictionConfig::snapkv_window_size)
             .def("get_start_size", &CacheEvictionConfig::get_start_size)
             .def("get_recent_size", &CacheEvictionConfig::get_recent_size)
             .def("get_max_cache_size", &CacheEvictionConfig::get_max_cache_size)
@@ -244,6 +311,15 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def_readwrite("dynamic_split_fuse", &SchedulerConfig::dynamic_split_fuse)
         .def_readwrite("max_num_seqs", &SchedulerConfig::max_num_seqs)
         .def_readwrite("enable_prefix_caching", &SchedulerConfig::enable_prefix_caching)
+        .def_readwrite("persistent_prefix_cache_dir", &SchedulerConfig::persistent_prefix_cache_dir)
+        .def_readwrite("persistent_prefix_cache_size", &SchedulerConfig::persistent_prefix_cache_size)
+        .def_readwrite("swap_space", &SchedulerConfig::swap_space)
+        .def_readwrite("enable_admission_control", &SchedulerConfig::enable_admission_control)
+        .def_readwrite("admission_headroom", &SchedulerConfig::admission_headroom)
+        .def_readwrite("forecast_average_output_len", &SchedulerConfig::forecast_average_output_len)
+        .def_readwrite("default_forecast_output_len", &SchedulerConfig::default_forecast_output_len)
+        .def_readwrite("scheduling_policy", &SchedulerConfig::scheduling_policy)
+        .def_readwrite("priority_aging_interval_ms", &SchedulerConfig::priority_aging_interval_ms)
         .def_readwrite("use_cache_eviction", &SchedulerConfig::use_cache_eviction)
         .def_readwrite("cache_eviction_config", &SchedulerConfig::cache_eviction_config);
 
@@ -253,9 +329,11 @@ void init_continuous_batching_pipeline(py::module_& m) {
             .def_readonly("scheduled_requests", &PipelineMetrics::scheduled_requests)
             .def_readonly("cache_usage", &PipelineMetrics::cache_usage)
             .def_readonly("avg_cache_usage", &PipelineMetrics::avg_cache_usage)
-            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage);
+            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage)
+            .def_readonly("forecast_cache_usage", &PipelineMetrics::forecast_cache_usage)
+            .def_readonly("deferred_requests", &PipelineMetrics::deferred_requests);
 
-    py::class_<ContinuousBatchingPipeline>(m, "ContinuousBatchingPipeline", "This class is used for generation with LLMs with continuous batchig")
+    py::class_<ContinuousBatchingPipeline>(m, "ContinuousBatchingPipeline", continuous_batching_pipeline_docstring)
         .def(py::init([](const std::filesystem::path& models_path, const SchedulerConfig& scheduler_config, const std::string& device, const std::map<std::string, py::object>& llm_plugin_config, 
                 const std::map<std::string, py::object>& tokenizer_plugin_config, const std::map<std::string, py::object>& inputs_embedder_plugin_config) {
             ScopedVar env_manager(pyutils::ov_tokenizers_module_path());
@@ -281,6 +359,7 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def("get_tokenizer", &ContinuousBatchingPipeline::get_tokenizer)
         .def("get_config", &ContinuousBatchingPipeline::get_config)
         .def("get_metrics", &ContinuousBatchingPipeline::get_metrics)
+        .def("dump_trace", &ContinuousBatchingPipeline::dump_trace, py::arg("path"), "Writes spans of the recent generation steps as Chrome trace JSON. Tracing must be enabled by OV_GENAI_STEP_TRACE environment variable or step_trace_capacity property.")
         .def("add_request", py::overload_cast<uint64_t, const ov::Tensor&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("input_ids"), py::arg("generation_config"))
         .def("add_request", py::overload_cast<uint64_t, const std::string&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("prompt"), py::arg("generation_config"))
         .def("add_request", py::overload_cast<uint64_t, const std::string&, const std::vector<ov::Tensor>&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("prompt"), py::arg("images"), py::arg("generation_config"))
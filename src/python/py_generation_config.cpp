@@ -74,6 +74,11 @@ char generation_config_docstring[] = R"(
     top_k:              the number of highest probability vocabulary tokens to keep for top-k-filtering.
     do_sample:          whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
     num_return_sequences: the number of sequences to generate from a single prompt.
+
+    Scheduling parameters (have effect only in ContinuousBatchingPipeline with SchedulingPolicy.PRIORITY):
+    priority:           priority of the request, requests with higher values are admitted first and preempted last.
+    ttft_deadline_ms:   target time to first token in milliseconds counted from the request arrival. Among requests of the same
+                        priority, the ones with the earliest deadline are scheduled first. 0 means no deadline.
 )";
 
 void init_generation_config(py::module_& m) {
@@ -113,10 +118,15 @@ void init_generation_config(py::module_& m) {
         .def_readwrite("assistant_confidence_threshold", &GenerationConfig::assistant_confidence_threshold)
         .def_readwrite("num_assistant_tokens", &GenerationConfig::num_assistant_tokens)
         .def_readwrite("max_ngram_size", &GenerationConfig::max_ngram_size)
+        .def_readwrite("rank_ngram_candidates_by_frequency", &GenerationConfig::rank_ngram_candidates_by_frequency)
+        .def_readwrite("num_assistant_branches", &GenerationConfig::num_assistant_branches)
+        .def_readwrite("adaptive_num_assistant_tokens", &GenerationConfig::adaptive_num_assistant_tokens)
         .def_readwrite("include_stop_str_in_output", &GenerationConfig::include_stop_str_in_output)
         .def_readwrite("stop_token_ids", &GenerationConfig::stop_token_ids)
         .def_readwrite("adapters", &GenerationConfig::adapters)
         .def_readwrite("apply_chat_template", &GenerationConfig::apply_chat_template)
+        .def_readwrite("priority", &GenerationConfig::priority)
+        .def_readwrite("ttft_deadline_ms", &GenerationConfig::ttft_deadline_ms)
         .def("set_eos_token_id", &GenerationConfig::set_eos_token_id, py::arg("tokenizer_eos_token_id"))
         .def("is_beam_search", &GenerationConfig::is_beam_search)
         .def("is_greedy_decoding", &GenerationConfig::is_greedy_decoding)
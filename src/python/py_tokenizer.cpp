@@ -38,6 +38,7 @@ namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::ChatHistory;
+using ov::genai::TokenizedBucket;
 using ov::genai::TokenizedInputs;
 using ov::genai::Tokenizer;
 
@@ -47,6 +48,10 @@ void init_tokenizer(py::module_& m) {
         .def_readwrite("input_ids", &TokenizedInputs::input_ids)
         .def_readwrite("attention_mask", &TokenizedInputs::attention_mask);
 
+    py::class_<TokenizedBucket>(m, "TokenizedBucket", "Prompts of similar length encoded together by Tokenizer.encode_bucketed.")
+        .def_readonly("prompt_indices", &TokenizedBucket::prompt_indices)
+        .def_readonly("inputs", &TokenizedBucket::inputs);
+
     py::class_<ov::genai::Tokenizer>(m, "Tokenizer", class_docstring)
 
         .def(py::init([](const std::filesystem::path& tokenizer_path, const std::map<std::string, py::object>& properties, const py::kwargs& kwargs) {
@@ -108,6 +113,59 @@ void init_tokenizer(py::module_& m) {
             py::arg("max_length") = std::nullopt,
             R"(Encodes a single prompt into tokenized input.)")
 
+        .def("encode_ragged", [](Tokenizer& tok, const std::vector<std::string>& prompts,
+                                 size_t bucket_size,
+                                 bool add_special_tokens,
+                                 std::optional<size_t> max_length) {
+                ov::AnyMap tokenization_params;
+                tokenization_params[ov::genai::add_special_tokens.name()] = add_special_tokens;
+                if (max_length.has_value()) {
+                    tokenization_params[ov::genai::max_length.name()] = *max_length;
+                }
+                py::gil_scoped_release rel;
+                return tok.encode_ragged(prompts, bucket_size, tokenization_params);
+            },
+            py::arg("prompts"),
+            py::arg("bucket_size") = 16,
+            py::arg("add_special_tokens") = true,
+            py::arg("max_length") = std::nullopt,
+            R"(Encodes a list of prompts in parallel into token lists without padding, in order of prompts.)")
+
+        .def("encode_bucketed", [](Tokenizer& tok, const std::vector<std::string>& prompts,
+                                   size_t bucket_size,
+                                   bool add_special_tokens,
+                                   bool pad_to_max_length,
+                                   std::optional<size_t> max_length) {
+                ov::AnyMap tokenization_params;
+                tokenization_params[ov::genai::add_special_tokens.name()] = add_special_tokens;
+                tokenization_params[ov::genai::pad_to_max_length.name()] = pad_to_max_length;
+                if (max_length.has_value()) {
+                    tokenization_params[ov::genai::max_length.name()] = *max_length;
+                }
+                py::gil_scoped_release rel;
+                return tok.encode_bucketed(prompts, bucket_size, tokenization_params);
+            },
+            py::arg("prompts"),
+            py::arg("bucket_size") = 16,
+            py::arg("add_special_tokens") = true,
+            py::arg("pad_to_max_length") = false,
+            py::arg("max_length") = std::nullopt,
+            R"(Encodes a list of prompts in parallel, grouping prompts of similar length into padded buckets.)")
+
+        .def("encode_with_prefix", [](Tokenizer& tok, const std::string& prompt,
+                                      const std::string& prefix,
+                                      const std::vector<int64_t>& prefix_ids,
+                                      bool add_special_tokens) {
+                ov::AnyMap tokenization_params;
+                tokenization_params[ov::genai::add_special_tokens.name()] = add_special_tokens;
+                return tok.encode_with_prefix(prompt, prefix, prefix_ids, tokenization_params);
+            },
+            py::arg("prompt"),
+            py::arg("prefix"),
+            py::arg("prefix_ids"),
+            py::arg("add_special_tokens") = true,
+            R"(Encodes a prompt which extends a previously encoded prefix, reusing tokens of the prefix where possible.)")
+
         .def(
             "decode",
             [](Tokenizer& tok, std::vector<int64_t>& tokens, bool skip_special_tokens) -> py::str {
@@ -7,6 +7,8 @@
 #include "continuous_batching/scheduler.hpp"
 #include <chrono>
 #include <thread>
+#include <filesystem>
+#include <fstream>
 
 TEST(TestBlockHashStore, general_test) {
     ov::genai::OverwritableBlocksHashStore block_hash_store(1);
@@ -52,3 +54,81 @@ TEST(TestBlockHashStore, general_test) {
     EXPECT_TRUE(block_hash_store.get_lru_block_to_overwrite().empty());
     EXPECT_EQ(block_hash_store.num_blocks(), 0);
 }
+
+TEST(TestPersistentPrefixCacheStore, general_test) {
+    const size_t BLOCK_CONTENTS_SIZE = 8;
+    auto cache_dir = std::filesystem::temp_directory_path() / "ov_genai_test_persistent_prefix_cache_store";
+    std::filesystem::remove_all(cache_dir);
+    {
+        ov::genai::PersistentPrefixCacheStore store(cache_dir, BLOCK_CONTENTS_SIZE, 2 * BLOCK_CONTENTS_SIZE);
+        store.store(77, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 1));
+        store.store(56, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 2));
+        store.flush();
+        EXPECT_EQ(store.num_blocks(), 2);
+
+        std::vector<uint8_t> contents;
+        EXPECT_TRUE(store.load(77, contents));
+        EXPECT_EQ(contents, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 1));
+        EXPECT_FALSE(store.load(44, contents));
+
+        // 56 is the least recently used block and is removed to fit the size limit
+        store.store(23, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 3));
+        store.flush();
+        EXPECT_EQ(store.num_blocks(), 2);
+        EXPECT_EQ(store.get_used_size_in_bytes(), 2 * BLOCK_CONTENTS_SIZE);
+        EXPECT_TRUE(store.contains(77));
+        EXPECT_FALSE(store.contains(56));
+        EXPECT_TRUE(store.contains(23));
+    }
+
+    // stored blocks are kept between instances
+    ov::genai::PersistentPrefixCacheStore reopened_store(cache_dir, BLOCK_CONTENTS_SIZE);
+    EXPECT_EQ(reopened_store.num_blocks(), 2);
+    std::vector<uint8_t> contents;
+    EXPECT_TRUE(reopened_store.load(23, contents));
+    EXPECT_EQ(contents, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 3));
+
+    // blocks of another size are discarded
+    ov::genai::PersistentPrefixCacheStore other_size_store(cache_dir, 2 * BLOCK_CONTENTS_SIZE);
+    EXPECT_EQ(other_size_store.num_blocks(), 0);
+    std::filesystem::remove_all(cache_dir);
+}
+
+TEST(TestPersistentPrefixCacheStore, rejects_stale_and_corrupted_blocks) {
+    const size_t BLOCK_CONTENTS_SIZE = 8;
+    const uint64_t LAYOUT_ID = 42;
+    auto cache_dir = std::filesystem::temp_directory_path() / "ov_genai_test_persistent_prefix_cache_store_validation";
+    std::filesystem::remove_all(cache_dir);
+    {
+        ov::genai::PersistentPrefixCacheStore store(cache_dir, BLOCK_CONTENTS_SIZE, 0, LAYOUT_ID);
+        store.store(1, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 1));
+        store.store(2, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 2));
+        // blocks waiting to be written are loaded from memory
+        std::vector<uint8_t> contents;
+        EXPECT_TRUE(store.load(2, contents));
+        EXPECT_EQ(contents, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 2));
+    }
+
+    // corrupt the payload of one of the blocks
+    for (const auto& dir_entry : std::filesystem::directory_iterator(cache_dir)) {
+        if (dir_entry.path().filename() == "1.kvblock") {
+            std::fstream file(dir_entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-1, std::ios::end);
+            file.put(7);
+        }
+    }
+    {
+        ov::genai::PersistentPrefixCacheStore store(cache_dir, BLOCK_CONTENTS_SIZE, 0, LAYOUT_ID);
+        EXPECT_EQ(store.num_blocks(), 2);
+        std::vector<uint8_t> contents;
+        EXPECT_FALSE(store.load(1, contents));
+        EXPECT_FALSE(store.contains(1));
+        EXPECT_TRUE(store.load(2, contents));
+        EXPECT_EQ(contents, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, 2));
+    }
+
+    // blocks of the same size, but another layout are discarded
+    ov::genai::PersistentPrefixCacheStore other_layout_store(cache_dir, BLOCK_CONTENTS_SIZE, 0, LAYOUT_ID + 1);
+    EXPECT_EQ(other_layout_store.num_blocks(), 0);
+    std::filesystem::remove_all(cache_dir);
+}
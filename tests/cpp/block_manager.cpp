@@ -7,6 +7,7 @@
 #include "openvino/genai/generation_config.hpp"
 #include "sequence_group.hpp"
 #include "continuous_batching/scheduler.hpp"
+#include <filesystem>
 
 TEST(TestBlockManager, general_test) {
     ov::genai::BlockManager bm = ov::genai::BlockManager(6, false, 4);
@@ -112,4 +113,65 @@ TEST(TestBlockManager, CanFreeBlocksFromSequence) {
     for (auto& sequence : sequence_group->get_sequences()) {
         bm.free_sequence(sequence->get_id());
     }
-}
\ No newline at end of file
+}
+
+TEST(TestBlockManager, CanRestoreBlocksFromPersistentPrefixCache) {
+    const size_t BLOCK_SIZE = 4;
+    const size_t BLOCK_CONTENTS_SIZE = 16;
+    auto cache_dir = std::filesystem::temp_directory_path() / "ov_genai_test_persistent_prefix_cache";
+    std::filesystem::remove_all(cache_dir);
+    {
+        ov::genai::BlockManager bm = ov::genai::BlockManager(2, true, BLOCK_SIZE);
+        bm.set_persistent_prefix_cache(std::make_shared<ov::genai::PersistentPrefixCacheStore>(cache_dir, BLOCK_CONTENTS_SIZE));
+
+        auto make_group = [&](uint64_t request_id, std::vector<uint64_t>& tokens) {
+            return std::make_shared<ov::genai::SequenceGroup>(
+                request_id,
+                ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                ov::genai::greedy(),
+                BLOCK_SIZE);
+        };
+
+        std::vector<uint64_t> shared_prompt = {0, 1, 2, 3, 4, 5, 6, 7};
+        std::vector<uint64_t> other_prompt = {8, 9, 10, 11, 12, 13, 14, 15};
+
+        auto group_0 = make_group(0, shared_prompt);
+        group_0->schedule_tokens(shared_prompt.size());
+        bm.append_slots(group_0);
+        bm.free_sequence(group_0->get_sequences()[0]->get_id());
+        EXPECT_TRUE(bm.pop_prefix_cache_transfers().m_blocks_to_spill.empty());
+
+        // blocks of the shared prompt are overwritten and have to be spilled
+        auto group_1 = make_group(1, other_prompt);
+        group_1->schedule_tokens(other_prompt.size());
+        bm.append_slots(group_1);
+        auto transfers = bm.pop_prefix_cache_transfers();
+        ASSERT_EQ(transfers.m_blocks_to_spill.size(), 2);
+        EXPECT_TRUE(transfers.m_blocks_to_load.empty());
+        for (const auto& [hash, block_idx] : transfers.m_blocks_to_spill) {
+            bm.store_spilled_block(hash, std::vector<uint8_t>(BLOCK_CONTENTS_SIZE, static_cast<uint8_t>(block_idx)));
+        }
+        bm.free_sequence(group_1->get_sequences()[0]->get_id());
+
+        // shared prompt is restored from the persistent tier
+        auto group_2 = make_group(2, shared_prompt);
+        bm.restore_cached_blocks(group_2);
+        auto seq_id = group_2->get_sequences()[0]->get_id();
+        EXPECT_EQ(bm.get_block_table(seq_id, 0).size(), 2);
+        EXPECT_EQ(group_2->get_num_processed_tokens(), shared_prompt.size() - 1);
+
+        transfers = bm.pop_prefix_cache_transfers();
+        EXPECT_EQ(transfers.m_blocks_to_spill.size(), 2);
+        ASSERT_EQ(transfers.m_blocks_to_load.size(), 2);
+        for (const auto& block : bm.get_block_table(seq_id, 0)) {
+            ASSERT_EQ(transfers.m_blocks_to_load.count(block->get_index()), 1);
+            EXPECT_EQ(transfers.m_blocks_to_load.at(block->get_index()).size(), BLOCK_CONTENTS_SIZE);
+        }
+        bm.free_sequence(seq_id);
+    }
+
+    // blocks stored by the previous instance are found after restart
+    ov::genai::PersistentPrefixCacheStore store(cache_dir, BLOCK_CONTENTS_SIZE);
+    EXPECT_EQ(store.num_blocks(), 2);
+    std::filesystem::remove_all(cache_dir);
+}
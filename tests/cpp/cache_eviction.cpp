@@ -380,6 +380,70 @@ TEST_P(CacheEvictionConfigModeCommonBehaviour, ScoresAreAccumulated) {
 INSTANTIATE_TEST_SUITE_P(VariousAggregationModes, CacheEvictionConfigModeCommonBehaviour,
                          ::testing::ValuesIn(SCORE_ACCUMULATION_TEST_CASES));
 
+TEST_P(CacheEvictionConfigModeCommonBehaviour, PerLayerCallsMatchAllLayerCalls) {
+    auto config = DEFAULT_CACHE_EVICTION_CONFIG;
+    config.aggregation_mode = GetParam();
+    const size_t NUM_DECODER_LAYERS = 3;
+    auto reference_algo = ov::genai::CacheEvictionAlgorithm(config, DEFAULT_BLOCK_SIZE, NUM_DECODER_LAYERS);
+    auto per_layer_algo = ov::genai::CacheEvictionAlgorithm(config, DEFAULT_BLOCK_SIZE, NUM_DECODER_LAYERS);
+
+    size_t num_tokens = reference_algo.get_max_cache_size_after_eviction() + BLOCKS_TO_EVICT * DEFAULT_BLOCK_SIZE;
+    for (size_t step = 0; step < 3; step++) {
+        auto scores = get_mock_scores(NUM_DECODER_LAYERS, num_tokens);
+        for (size_t layer_idx = 0; layer_idx < NUM_DECODER_LAYERS; layer_idx++) {
+            for (size_t token_idx = 0; token_idx < num_tokens; token_idx++) {
+                scores[layer_idx].data<float>()[token_idx] = static_cast<float>((token_idx * 7 + layer_idx * 3 + step) % 11);
+            }
+        }
+
+        reference_algo.register_new_token_scores(scores);
+        auto reference_blocks_to_evict = reference_algo.evict_logical_blocks();
+        for (size_t layer_idx = 0; layer_idx < NUM_DECODER_LAYERS; layer_idx++) {
+            per_layer_algo.register_new_token_scores(scores[layer_idx], layer_idx);
+            EXPECT_EQ(per_layer_algo.evict_logical_blocks(layer_idx), reference_blocks_to_evict[layer_idx]);
+        }
+        // the cache gets new tokens after eviction
+        num_tokens -= reference_blocks_to_evict[0].size() * DEFAULT_BLOCK_SIZE;
+        num_tokens += DEFAULT_BLOCK_SIZE + 1;
+    }
+}
+
+TEST_P(CacheEvictionConfigModeCommonBehaviour, ObservationWindowScoresReplaceResetScores) {
+    auto config = DEFAULT_CACHE_EVICTION_CONFIG;
+    config.aggregation_mode = GetParam();
+    const size_t NUM_DECODER_LAYERS = 1;
+    auto window_algo = ov::genai::CacheEvictionAlgorithm(config, DEFAULT_BLOCK_SIZE, NUM_DECODER_LAYERS);
+    auto reference_algo = ov::genai::CacheEvictionAlgorithm(config, DEFAULT_BLOCK_SIZE, NUM_DECODER_LAYERS);
+
+    // the first part of the prompt doesn't fill the cache and attends least to blocks 10-12
+    const std::set<size_t> zeroed_blocks_in_prefix{10, 11, 12};
+    auto prefix_scores = get_mock_scores(NUM_DECODER_LAYERS, 128);
+    fill_scores(prefix_scores[0], 0, prefix_scores[0].get_size(), 1000.0);
+    for (size_t target_block_idx : zeroed_blocks_in_prefix) {
+        fill_scores(prefix_scores[0], DEFAULT_BLOCK_SIZE * target_block_idx, DEFAULT_BLOCK_SIZE * (target_block_idx + 1), 0.0);
+    }
+
+    // the observation window at its end attends least to blocks 14, 17 and 21
+    const std::set<size_t> zeroed_blocks_in_window{14, 17, 21};
+    auto window_scores = get_mock_scores(NUM_DECODER_LAYERS, window_algo.get_max_cache_size_after_eviction() + BLOCKS_TO_EVICT * DEFAULT_BLOCK_SIZE);
+    fill_scores(window_scores[0], 0, window_scores[0].get_size(), 1.0);
+    for (size_t target_block_idx : zeroed_blocks_in_window) {
+        fill_scores(window_scores[0], DEFAULT_BLOCK_SIZE * target_block_idx, DEFAULT_BLOCK_SIZE * (target_block_idx + 1), 0.0);
+    }
+
+    window_algo.register_new_token_scores(prefix_scores);
+    EXPECT_TRUE(window_algo.evict_logical_blocks(0).empty());
+    window_algo.reset_scores(0);
+    window_algo.register_new_token_scores(window_scores);
+    EXPECT_EQ(window_algo.evict_logical_blocks(0), zeroed_blocks_in_window);
+
+    // without the reset the scores of the first part of the prompt prevail
+    reference_algo.register_new_token_scores(prefix_scores);
+    EXPECT_TRUE(reference_algo.evict_logical_blocks(0).empty());
+    reference_algo.register_new_token_scores(window_scores);
+    EXPECT_EQ(reference_algo.evict_logical_blocks(0), zeroed_blocks_in_prefix);
+}
+
 struct CacheEvictionConfigInitParamsForTest {
     size_t start_size;
     size_t recent_size;
@@ -106,3 +106,76 @@ TEST(TestCacheManager, test_dynamic_cache_increase) {
     cache_manager->allocate_cache_if_needed(block_manager.get_total_number_of_kv_blocks());
     ASSERT_EQ(get_total_allocated_bytes(cache_manager), 200 * block_size_in_bytes);
 }
+
+
+TEST(TestCacheManager, test_copy_blocks) {
+    ov::Core core;
+    const size_t num_decoder_layers = 2;
+    const size_t num_kv_blocks = 8;
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request);
+    cache_manager->allocate_cache_if_needed(num_kv_blocks);
+
+    auto get_block_ptr = [](ov::Tensor cache, size_t block_id) {
+        size_t block_stride = cache.get_byte_size() / cache.get_shape()[0];
+        return static_cast<uint8_t*>(cache.data()) + block_id * block_stride;
+    };
+
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        for (auto cache : {cache_manager->get_key_cache(i), cache_manager->get_value_cache(i)}) {
+            size_t block_stride = cache.get_byte_size() / num_kv_blocks;
+            for (size_t block_id = 0; block_id < num_kv_blocks; block_id++) {
+                std::memset(get_block_ptr(cache, block_id), static_cast<int>(block_id + 1), block_stride);
+            }
+        }
+    }
+
+    // 0 -> {4, 5}, 1 -> {6} are coalesced into the 0..1 -> 5..6 run
+    cache_manager->copy_blocks({{0, {4, 5}}, {1, {6}}});
+
+    const std::vector<uint8_t> expected_block_values = {1, 2, 3, 4, 1, 1, 2, 8};
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        for (auto cache : {cache_manager->get_key_cache(i), cache_manager->get_value_cache(i)}) {
+            size_t block_stride = cache.get_byte_size() / num_kv_blocks;
+            for (size_t block_id = 0; block_id < num_kv_blocks; block_id++) {
+                const uint8_t* block_ptr = get_block_ptr(cache, block_id);
+                EXPECT_TRUE(std::all_of(block_ptr, block_ptr + block_stride, [&](uint8_t value) { return value == expected_block_values[block_id]; }));
+            }
+        }
+    }
+}
+
+
+TEST(TestCacheManager, test_dynamic_cache_increase_keeps_data_in_place) {
+    ov::Core core;
+    const size_t num_decoder_layers = 2;
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request);
+    cache_manager->allocate_cache_if_needed(100);
+
+    std::vector<void*> key_cache_data, value_cache_data;
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        auto key_cache = cache_manager->get_key_cache(i);
+        auto value_cache = cache_manager->get_value_cache(i);
+        std::memset(key_cache.data(), 1, key_cache.get_byte_size());
+        std::memset(value_cache.data(), 2, value_cache.get_byte_size());
+        key_cache_data.push_back(key_cache.data());
+        value_cache_data.push_back(value_cache.data());
+    }
+
+    cache_manager->allocate_cache_if_needed(200);
+    for (size_t i = 0; i < num_decoder_layers; i++) {
+        auto key_cache = cache_manager->get_key_cache(i);
+        auto value_cache = cache_manager->get_value_cache(i);
+        ASSERT_EQ(key_cache.get_shape()[0], 200);
+        // grown in place, previous blocks are kept
+        EXPECT_EQ(key_cache.data(), key_cache_data[i]);
+        EXPECT_EQ(value_cache.data(), value_cache_data[i]);
+        const uint8_t* key_data = static_cast<const uint8_t*>(key_cache.data());
+        const uint8_t* value_data = static_cast<const uint8_t*>(value_cache.data());
+        EXPECT_TRUE(std::all_of(key_data, key_data + key_cache.get_byte_size() / 2, [](uint8_t value) { return value == 1; }));
+        EXPECT_TRUE(std::all_of(value_data, value_data + value_cache.get_byte_size() / 2, [](uint8_t value) { return value == 2; }));
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <limits>
+
+#include "speculative_decoding/draft_length_controller.hpp"
+
+using namespace ov::genai;
+
+TEST(DraftLengthControllerTest, GrowsForAcceptedCandidates) {
+    DraftLengthController controller;
+    controller.add_request(0, 10);
+    const size_t initial_num_draft_tokens = controller.get_num_draft_tokens(0);
+    EXPECT_GT(initial_num_draft_tokens, 0);
+    EXPECT_LT(initial_num_draft_tokens, 10);
+
+    for (size_t step = 0; step < 20; ++step) {
+        const size_t num_draft_tokens = controller.get_num_draft_tokens(0);
+        controller.update_acceptance(0, num_draft_tokens, 0);
+    }
+    EXPECT_EQ(controller.get_num_draft_tokens(0), 10);
+}
+
+TEST(DraftLengthControllerTest, StopsDraftingAndProbesAgain) {
+    DraftLengthController controller;
+    controller.update_costs(0.2f, 1.f);
+    controller.add_request(0, 5);
+
+    for (size_t step = 0; step < 50 && controller.get_num_draft_tokens(0) > 0; ++step) {
+        controller.update_acceptance(0, controller.get_num_draft_tokens(0), 5);
+    }
+    ASSERT_EQ(controller.get_num_draft_tokens(0), 0);
+
+    auto count_idle_steps = [&controller] {
+        size_t num_idle_steps = 0;
+        for (; num_idle_steps < 100 && controller.get_num_draft_tokens(0) == 0; ++num_idle_steps) {
+            controller.update_acceptance(0, 0, 0);
+        }
+        return num_idle_steps;
+    };
+    // a single candidate is probed after idle steps, rejected probes make the interval longer
+    const size_t first_interval = count_idle_steps();
+    EXPECT_GT(first_interval, 1);
+    ASSERT_EQ(controller.get_num_draft_tokens(0), 1);
+    controller.update_acceptance(0, 1, 1);
+    const size_t second_interval = count_idle_steps();
+    EXPECT_GT(second_interval, first_interval);
+
+    // accepted probes bring drafting back
+    for (size_t step = 0; step < 10; ++step) {
+        count_idle_steps();
+        controller.update_acceptance(0, controller.get_num_draft_tokens(0), 0);
+    }
+    EXPECT_GT(controller.get_num_draft_tokens(0), 1);
+}
+
+TEST(DraftLengthControllerTest, ExpensiveDraftIsNotUsed) {
+    DraftLengthController controller;
+    controller.add_request(0, 5);
+    controller.add_request(1, 5);
+    const size_t cheap_num_draft_tokens = controller.get_num_draft_tokens(0);
+
+    controller.update_costs(0.6f, 1.f);
+    EXPECT_LT(controller.get_num_draft_tokens(0), cheap_num_draft_tokens);
+    EXPECT_EQ(controller.get_num_draft_tokens(0), 0);
+
+    // high acceptance still pays off for the same costs
+    for (size_t step = 0; step < 20; ++step) {
+        controller.update_acceptance(1, 5, 0);
+    }
+    EXPECT_GT(controller.get_num_draft_tokens(1), 0);
+    EXPECT_EQ(controller.get_num_draft_tokens(), (std::map<uint64_t, size_t>{{0, 0}, {1, controller.get_num_draft_tokens(1)}}));
+}
+
+TEST(DraftLengthControllerTest, InvalidCostsAreIgnored) {
+    DraftLengthController controller;
+    controller.add_request(0, 5);
+    controller.update_costs(0.6f, 1.f);
+    ASSERT_EQ(controller.get_num_draft_tokens(0), 0);
+
+    const float infinity = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    // e.g. a duration divided by zero draft steps, or a main step too short to be measured
+    controller.update_costs(infinity, 1.f);
+    controller.update_costs(nan, 1.f);
+    controller.update_costs(0.f, nan);
+    controller.update_costs(1.f, std::numeric_limits<float>::denorm_min());
+    controller.update_costs(-1.f, 1.f);
+    controller.update_costs(0.f, 0.f);
+    EXPECT_EQ(controller.get_num_draft_tokens(0), 0);
+
+    // the estimate is still usable
+    for (size_t step = 0; step < 50; ++step) {
+        controller.update_costs(0.f, 1.f);
+    }
+    EXPECT_GT(controller.get_num_draft_tokens(0), 0);
+}
+
+TEST(DraftLengthControllerTest, UnknownRequestsAreIgnored) {
+    DraftLengthController controller;
+    controller.update_acceptance(7, 3, 1);
+    EXPECT_FALSE(controller.has_request(7));
+    EXPECT_THROW(controller.get_num_draft_tokens(7), ov::Exception);
+
+    controller.add_request(7, 3);
+    controller.remove_request(7);
+    EXPECT_TRUE(controller.get_num_draft_tokens().empty());
+}
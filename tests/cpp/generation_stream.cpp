@@ -0,0 +1,159 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include "generation_stream.hpp"
+#include "spsc_queue.hpp"
+
+using namespace ov::genai;
+
+TEST(SPSCQueueTest, ItemsArriveInOrderAcrossBlocks) {
+    SPSCQueue<size_t, 4> queue;
+    constexpr size_t num_items = 100000;
+    std::thread producer([&queue] {
+        for (size_t item = 0; item < num_items; ++item) {
+            queue.push(item);
+            if (item % 3 == 0)
+                queue.commit();
+        }
+        queue.commit();
+    });
+    for (size_t expected = 0; expected < num_items; ++expected) {
+        queue.wait();
+        size_t* item = queue.front();
+        ASSERT_NE(item, nullptr);
+        ASSERT_EQ(*item, expected);
+        queue.pop();
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(SPSCQueueTest, PushedItemsAreInvisibleUntilCommit) {
+    SPSCQueue<int> queue;
+    queue.push(1);
+    EXPECT_TRUE(queue.empty());
+    queue.commit();
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(*queue.front(), 1);
+}
+
+TEST(GenerationStreamTest, ReadRestoresPushedOutputs) {
+    auto stream = GenerationStream::create();
+    GenerationOutput output;
+    output.generated_ids = {1, 2};
+    output.generated_log_probs = {-0.5f, -1.0f};
+    output.score = -1.5f;
+    output.finish_reason = GenerationFinishReason::NONE;
+    stream->push({{0, output}, {1, output}});
+    stream->push({});
+
+    auto outputs = stream->read();
+    ASSERT_EQ(outputs.size(), 2);
+    EXPECT_EQ(outputs.at(1).generated_ids, output.generated_ids);
+    EXPECT_EQ(outputs.at(1).generated_log_probs, output.generated_log_probs);
+    EXPECT_EQ(outputs.at(1).score, output.score);
+    EXPECT_TRUE(stream->can_read());
+    EXPECT_TRUE(stream->read().empty());
+    EXPECT_FALSE(stream->can_read());
+}
+
+TEST(GenerationStreamTest, ReadAvailableDrainsDeltas) {
+    auto stream = GenerationStream::create();
+    std::atomic<size_t> num_notifications = 0;
+    stream->set_notification_callback([&num_notifications] { ++num_notifications; });
+
+    GenerationOutput output;
+    output.generated_ids = {7};
+    output.generated_log_probs = {-0.25f};
+    output.finish_reason = GenerationFinishReason::NONE;
+    stream->push({{0, output}});
+    GenerationOutput finished;
+    finished.finish_reason = GenerationFinishReason::STOP;
+    stream->push({{0, finished}});
+    EXPECT_EQ(num_notifications, 2);
+
+    std::vector<GenerationDelta> deltas;
+    deltas.reserve(4);
+    ASSERT_EQ(stream->read_available(deltas), 2);
+    EXPECT_EQ(deltas[0].token_id, 7);
+    EXPECT_EQ(deltas[0].log_prob, -0.25f);
+    EXPECT_EQ(deltas[0].finish_reason, GenerationFinishReason::NONE);
+    EXPECT_EQ(deltas[1].token_id, -1);
+    EXPECT_EQ(deltas[1].finish_reason, GenerationFinishReason::STOP);
+    EXPECT_EQ(stream->read_available(deltas), 0);
+    EXPECT_FALSE(stream->can_read());
+}
+
+TEST(GenerationStreamTest, PushOfSingleSequenceMatchesOutputs) {
+    auto stream = GenerationStream::create();
+    std::vector<int64_t> generated_ids = {3, 4, 5};
+    std::vector<float> generated_log_probs = {-0.1f, -0.2f, -0.3f};
+    stream->push(2, generated_ids.data() + 1, generated_log_probs.data() + 1, 2, -0.6f, GenerationFinishReason::LENGTH);
+
+    EXPECT_TRUE(stream->can_read());
+    auto outputs = stream->read();
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_EQ(outputs.at(2).generated_ids, std::vector<int64_t>({4, 5}));
+    EXPECT_EQ(outputs.at(2).generated_log_probs, std::vector<float>({-0.2f, -0.3f}));
+    EXPECT_EQ(outputs.at(2).score, -0.6f);
+    EXPECT_EQ(outputs.at(2).finish_reason, GenerationFinishReason::LENGTH);
+    EXPECT_FALSE(stream->can_read());
+}
+
+TEST(GenerationStreamTest, NotificationCallbackCanBeReplacedFromCallback) {
+    auto stream = GenerationStream::create();
+    size_t num_first_notifications = 0, num_second_notifications = 0;
+    auto second = [&num_second_notifications] { ++num_second_notifications; };
+    stream->set_notification_callback([&] {
+        ++num_first_notifications;
+        stream->set_notification_callback(second);
+    });
+
+    stream->push({});
+    stream->push({});
+    EXPECT_EQ(num_first_notifications, 1);
+    // the second callback is called right away, as there are outputs to read
+    EXPECT_EQ(num_second_notifications, 2);
+}
+
+TEST(GenerationHandleTest, ConcurrentReadersGetEveryOutputOnce) {
+    auto stream = GenerationStream::create();
+    GenerationHandle handle = std::make_shared<GenerationHandleImpl>(stream, ov::genai::greedy());
+    constexpr size_t num_outputs = 10000;
+    std::thread producer([&stream] {
+        for (size_t token = 0; token < num_outputs; ++token) {
+            const int64_t token_id = static_cast<int64_t>(token);
+            const float log_prob = 0.0f;
+            stream->push(0, &token_id, &log_prob, 1, 0.0f, GenerationFinishReason::NONE);
+        }
+    });
+
+    std::vector<int64_t> tokens[2];
+    std::thread readers[2];
+    for (size_t reader_idx = 0; reader_idx < 2; ++reader_idx) {
+        readers[reader_idx] = std::thread([&handle, &tokens, reader_idx] {
+            for (size_t i = 0; i < num_outputs / 2; ++i) {
+                auto outputs = handle->read();
+                tokens[reader_idx].insert(tokens[reader_idx].end(), outputs.at(0).generated_ids.begin(), outputs.at(0).generated_ids.end());
+            }
+        });
+    }
+    producer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::vector<int64_t> all_tokens = tokens[0];
+    all_tokens.insert(all_tokens.end(), tokens[1].begin(), tokens[1].end());
+    std::sort(all_tokens.begin(), all_tokens.end());
+    std::vector<int64_t> expected(num_outputs);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(all_tokens, expected);
+    EXPECT_FALSE(handle->can_read());
+}
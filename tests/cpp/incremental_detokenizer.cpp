@@ -0,0 +1,71 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "tokenizer/incremental_detokenizer.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+constexpr char replacement[] = "\xef\xbf\xbd";
+
+IncrementalDetokenizer::TokenBytes make_vocab() {
+    return std::make_shared<const std::vector<std::string>>(std::vector<std::string>{
+        // "", "Hello", " world", "\n", first and last bytes of "é", first two and last bytes of "€", "😀" split in halves
+        "", "Hello", " world", "\n", "\xc3", "\xa9", "\xe2\x82", "\xac", "\xf0\x9f", "\x98\x80", "\xff", "\xc3\xa9!"
+    });
+}
+
+std::string write_all(IncrementalDetokenizer& detokenizer, const std::vector<int64_t>& tokens) {
+    std::string text;
+    for (int64_t token : tokens) {
+        text += detokenizer.write(token);
+    }
+    return text + detokenizer.end();
+}
+
+}  // namespace
+
+TEST(IncrementalDetokenizerTest, CharactersSplitAcrossTokens) {
+    IncrementalDetokenizer detokenizer(make_vocab());
+    EXPECT_EQ(detokenizer.write(1), "Hello");
+    EXPECT_EQ(detokenizer.write(4), "");
+    EXPECT_EQ(detokenizer.write(5), "\xc3\xa9");
+    EXPECT_EQ(detokenizer.write(6), "");
+    EXPECT_EQ(detokenizer.write(0), "");
+    EXPECT_EQ(detokenizer.write(7), "\xe2\x82\xac");
+    EXPECT_EQ(detokenizer.write(8), "");
+    EXPECT_EQ(detokenizer.write(9), "\xf0\x9f\x98\x80");
+    EXPECT_EQ(detokenizer.end(), "");
+}
+
+TEST(IncrementalDetokenizerTest, InvalidBytesAreReplaced) {
+    IncrementalDetokenizer detokenizer(make_vocab());
+    // lone continuation byte and a byte which never occurs in UTF-8
+    EXPECT_EQ(detokenizer.write(5), replacement);
+    EXPECT_EQ(detokenizer.write(10), replacement);
+    // a started character interrupted by ASCII
+    EXPECT_EQ(detokenizer.write(4), "");
+    EXPECT_EQ(detokenizer.write(2), std::string(replacement) + " world");
+    // a started character interrupted by another one
+    EXPECT_EQ(detokenizer.write(6), "");
+    EXPECT_EQ(detokenizer.write(11), std::string(replacement) + replacement + "\xc3\xa9!");
+}
+
+TEST(IncrementalDetokenizerTest, EndFlushesIncompleteCharacter) {
+    IncrementalDetokenizer detokenizer(make_vocab());
+    EXPECT_EQ(write_all(detokenizer, {1, 8}), std::string("Hello") + replacement);
+    // the state is empty after end
+    EXPECT_EQ(write_all(detokenizer, {3, 11}), "\n\xc3\xa9!");
+    EXPECT_THROW(detokenizer.write(12), ov::Exception);
+}
+
+TEST(IncrementalDetokenizerTest, IsValidUtf8) {
+    EXPECT_TRUE(IncrementalDetokenizer::is_valid_utf8("Hello \xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"));
+    EXPECT_FALSE(IncrementalDetokenizer::is_valid_utf8("\xc3"));
+    // overlong encoding, surrogate and code point above U+10FFFF
+    EXPECT_FALSE(IncrementalDetokenizer::is_valid_utf8("\xc0\xaf"));
+    EXPECT_FALSE(IncrementalDetokenizer::is_valid_utf8("\xed\xa0\x80"));
+    EXPECT_FALSE(IncrementalDetokenizer::is_valid_utf8("\xf4\x90\x80\x80"));
+}
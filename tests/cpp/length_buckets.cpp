@@ -0,0 +1,14 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "tokenizer/length_buckets.hpp"
+
+using namespace ov::genai;
+
+TEST(LengthBucketsTest, GroupsPromptsOfSimilarLength) {
+    const std::vector<std::string> prompts = {"a", "aaaa", "aa", "aaaaa", "aaa"};
+    const auto buckets = split_into_length_buckets(prompts, 2);
+    EXPECT_EQ(buckets, std::vector<std::vector<size_t>>({{3, 1}, {4, 2}, {0}}));
+    EXPECT_TRUE(split_into_length_buckets({}, 2).empty());
+}
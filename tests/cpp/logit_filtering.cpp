@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 #include <openvino/core/except.hpp>
+#include <cmath>
+#include <random>
 
 #include "sampling/logit_processor.hpp"
 
@@ -127,6 +129,60 @@ TEST(TopKFilteringTest, FilterNotAppliedTopKGreaterThanInputSize) {
     }
 }
 
+TEST(LogitKernelsTest, LargeVocabularyMatchesSortedReference) {
+    // large enough to use threshold-based selection instead of sorting
+    const size_t vocab_size = 50000;
+    std::mt19937 rng(42);
+    std::normal_distribution<float> distribution(0.0f, 3.0f);
+    std::vector<float> logits(vocab_size), probabilities(vocab_size);
+    for (auto& logit : logits) {
+        logit = distribution(rng);
+    }
+
+    std::copy(logits.begin(), logits.end(), probabilities.begin());
+    auto probs = Logits(probabilities.data(), vocab_size);
+    TemperatureLogitTransform(0.8).apply(probs);
+    const double max_logit = *std::max_element(logits.begin(), logits.end());
+    double norm_sum = 0.0;
+    for (float logit : logits) {
+        norm_sum += std::exp((logit - max_logit) / 0.8);
+    }
+    for (size_t i = 0; i < vocab_size; i++) {
+        const double expected = std::exp((logits[i] - max_logit) / 0.8) / norm_sum;
+        EXPECT_NEAR(probabilities[i], expected, expected * 1e-5);
+    }
+
+    std::vector<Token> reference;
+    for (size_t i = 0; i < vocab_size; i++) {
+        reference.emplace_back(probabilities[i], i);
+    }
+    // ties are resolved in favor of smaller indices
+    std::stable_sort(reference.begin(), reference.end(), [](const Token& lhs, const Token& rhs) {return lhs.m_log_prob > rhs.m_log_prob; });
+
+    for (size_t top_k : {1, 40, 3000}) {
+        auto top_k_logits = Logits(probabilities.data(), vocab_size);
+        TopKFilter(top_k).apply(top_k_logits);
+        ASSERT_EQ(top_k_logits.m_vector.size(), top_k);
+        for (size_t i = 0; i < top_k; i++) {
+            EXPECT_EQ(top_k_logits.m_vector[i].m_index, reference[i].m_index);
+        }
+    }
+
+    for (float top_p : {0.1f, 0.9f, 0.999f}) {
+        size_t nucleus_size = 0;
+        float probability_sum = 0.0f;
+        while (probability_sum <= top_p && nucleus_size < vocab_size) {
+            probability_sum += reference[nucleus_size++].m_log_prob;
+        }
+        auto top_p_logits = Logits(probabilities.data(), vocab_size);
+        TopPFilter(top_p).apply(top_p_logits);
+        ASSERT_EQ(top_p_logits.m_size, nucleus_size);
+        for (size_t i = 0; i < nucleus_size; i++) {
+            EXPECT_EQ(top_p_logits.m_vector[i].m_index, reference[i].m_index);
+        }
+    }
+}
+
 struct RepetitionPenaltyTransformTestStruct {
     static inline const size_t size = 3;
 
@@ -303,6 +359,60 @@ TEST(PresencePenaltyTransformInitializationTest, ThrowsForInvalidInputIds) {
     EXPECT_THROW(transform.apply(logits, {0, -1}), ov::Exception);
 }
 
+TEST(PenaltyTransformTest, FusedPenaltiesEqualToSequentialTransforms) {
+    const size_t vocab_size = 1000;
+    const TokenIds prompt_ids = {1, 5, 5, 17, 999, 300};
+    TokenIds generated_ids;
+    for (size_t i = 0; i < 500; i++) {
+        generated_ids.push_back((i * 37) % vocab_size);
+    }
+    generated_ids.push_back(5);
+    generated_ids.push_back(5);
+
+    std::vector<float> reference(vocab_size), fused(vocab_size);
+    for (size_t i = 0; i < vocab_size; i++) {
+        reference[i] = fused[i] = std::sin(static_cast<float>(i)) * 5.0f;
+    }
+
+    auto reference_logits = Logits(reference.data(), vocab_size);
+    RepetitionPenaltyTransform repetition(1.3);
+    repetition.set_unique_prompt_token_ids(std::make_shared<std::set<int64_t>>(prompt_ids.begin(), prompt_ids.end()));
+    repetition.set_unique_generated_token_ids(nullptr);
+    repetition.extract_generated_tokens(generated_ids);
+    repetition.apply(reference_logits);
+    PresencePenaltyTransform(0.4).apply(reference_logits, generated_ids);
+    FrequencyPenaltyTransform(0.2).apply(reference_logits, generated_ids);
+
+    auto token_occurrences = std::make_shared<TokenOccurrences>();
+    for (auto prompt_id : prompt_ids) {
+        token_occurrences->add_prompt_token(prompt_id);
+    }
+    for (auto generated_id : generated_ids) {
+        token_occurrences->add_generated_token(generated_id);
+    }
+    auto fused_logits = Logits(fused.data(), vocab_size);
+    PenaltyTransform(1.3, 0.4, 0.2, token_occurrences).apply(fused_logits);
+
+    for (size_t i = 0; i < vocab_size; i++) {
+        EXPECT_EQ(fused[i], reference[i]) << "token " << i;
+    }
+}
+
+TEST(PenaltyTransformTest, GeneratedTokenRemovalUpdatesFrequencyPenalty) {
+    float input[]{1.0f, 2.0f, 3.0f};
+    auto token_occurrences = std::make_shared<TokenOccurrences>();
+    token_occurrences->add_generated_token(2);
+    token_occurrences->add_generated_token(2);
+    token_occurrences->remove_generated_token(2);
+    auto logits = Logits(input, 3);
+    PenaltyTransform(1.0, 0.0, 0.5, token_occurrences).apply(logits);
+    EXPECT_FLOAT_EQ(input[2], 2.5f);
+    EXPECT_THROW(token_occurrences->remove_generated_token(1), ov::Exception);
+
+    token_occurrences->add_generated_token(1337);
+    EXPECT_THROW(PenaltyTransform(1.0, 0.5, 0.0, token_occurrences).apply(logits), ov::Exception);
+}
+
 struct EOSPenaltyTransformTestStruct {
     static inline const size_t size = 3;
 
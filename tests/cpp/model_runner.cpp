@@ -0,0 +1,124 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include "openvino/runtime/core.hpp"
+#include "openvino/op/add.hpp"
+#include "openvino/op/constant.hpp"
+#include "openvino/op/convert.hpp"
+#include "openvino/op/multiply.hpp"
+#include "openvino/op/parameter.hpp"
+#include "openvino/op/unsqueeze.hpp"
+#include "continuous_batching/model_runner.hpp"
+#include "helper.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+// model with the inputs set by ModelRunner, whose logits are input_ids * 1000 + position_ids
+std::shared_ptr<ov::Model> get_pa_inputs_model() {
+    auto make_parameter = [](const std::string& name, ov::element::Type type, const ov::PartialShape& shape) {
+        auto parameter = std::make_shared<ov::op::v0::Parameter>(type, shape);
+        parameter->get_output_tensor(0).set_names({name});
+        return parameter;
+    };
+    auto input_ids = make_parameter("input_ids", ov::element::i64, {-1});
+    auto position_ids = make_parameter("position_ids", ov::element::i64, {-1});
+    ov::ParameterVector params = {
+        input_ids,
+        position_ids,
+        make_parameter("past_lens", ov::element::i32, {-1}),
+        make_parameter("subsequence_begins", ov::element::i32, {-1}),
+        make_parameter("block_indices", ov::element::i32, {-1}),
+        make_parameter("block_indices_begins", ov::element::i32, {-1}),
+        make_parameter("max_context_len", ov::element::i32, {}),
+    };
+
+    auto scaled_ids = std::make_shared<ov::op::v1::Multiply>(input_ids, ov::op::v0::Constant::create(ov::element::i64, {}, {1000}));
+    auto sum = std::make_shared<ov::op::v1::Add>(scaled_ids, position_ids);
+    auto logits = std::make_shared<ov::op::v0::Unsqueeze>(std::make_shared<ov::op::v0::Convert>(sum, ov::element::f32),
+                                                          ov::op::v0::Constant::create(ov::element::i64, {1}, {1}));
+    logits->get_output_tensor(0).set_names({"logits"});
+    return std::make_shared<ov::Model>(ov::OutputVector{logits}, params);
+}
+
+std::vector<int32_t> get_i32_values(ov::InferRequest request, const std::string& name) {
+    ov::Tensor tensor = request.get_tensor(name);
+    return std::vector<int32_t>(tensor.data<int32_t>(), tensor.data<int32_t>() + tensor.get_size());
+}
+
+void finish_iteration(const std::vector<SequenceGroup::Ptr>& requests) {
+    for (const auto& request : requests) {
+        request->finish_iteration();
+    }
+}
+
+}  // namespace
+
+TEST(TestModelRunner, reused_inputs_follow_batch_size) {
+    const size_t BLOCK_SIZE = 4;
+    ov::Core core;
+    ov::InferRequest request = core.compile_model(get_pa_inputs_model(), "CPU").create_infer_request();
+    ModelRunner model_runner(request, BLOCK_SIZE);
+
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 64;
+    scheduler_config.num_kv_blocks = 16;
+    scheduler_config.max_num_seqs = 4;
+    ov::InferRequest cache_request = core.compile_model(get_dummy_model(core, 1)).create_infer_request();
+    Scheduler scheduler(BLOCK_SIZE, std::make_shared<CacheManager>(cache_request), scheduler_config);
+
+    std::vector<SequenceGroup::Ptr> requests;
+    for (uint64_t request_id = 0; request_id < 4; ++request_id) {
+        std::vector<int64_t> prompt(5);
+        std::iota(prompt.begin(), prompt.end(), 10 * (request_id + 1));
+        requests.push_back(std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {prompt.size()}, prompt.data()),
+                                                           ov::genai::greedy(), BLOCK_SIZE));
+    }
+
+    // large batch: prompts of all requests
+    auto scheduler_output = scheduler.schedule(requests);
+    ASSERT_EQ(scheduler_output.m_total_num_scheduled_tokens, 20);
+    ov::Tensor logits = model_runner.forward(requests, scheduler_output);
+    ASSERT_EQ(logits.get_shape(), ov::Shape({20, 1}));
+    for (size_t request_idx = 0; request_idx < 4; ++request_idx) {
+        for (size_t position = 0; position < 5; ++position) {
+            EXPECT_EQ(logits.data<float>()[request_idx * 5 + position], (10 * (request_idx + 1) + position) * 1000 + position);
+        }
+    }
+    EXPECT_EQ(get_i32_values(request, "subsequence_begins"), std::vector<int32_t>({0, 5, 10, 15, 20}));
+    EXPECT_EQ(get_i32_values(request, "block_indices_begins"), std::vector<int32_t>({0, 2, 4, 6, 8}));
+    EXPECT_EQ(request.get_tensor("block_indices").get_shape(), ov::Shape({8}));
+    finish_iteration(requests);
+
+    // smaller batch: a generated token of a single request
+    std::vector<SequenceGroup::Ptr> single_request = {requests[0]};
+    requests[0]->get_running_sequences()[0]->append_token(77, 0.0f);
+    scheduler_output = scheduler.schedule(single_request);
+    logits = model_runner.forward(single_request, scheduler_output);
+    ASSERT_EQ(logits.get_shape(), ov::Shape({1, 1}));
+    EXPECT_EQ(logits.data<float>()[0], 77 * 1000 + 5);
+    EXPECT_EQ(request.get_tensor("input_ids").get_shape(), ov::Shape({1}));
+    EXPECT_EQ(get_i32_values(request, "past_lens"), std::vector<int32_t>({5}));
+    EXPECT_EQ(get_i32_values(request, "subsequence_begins"), std::vector<int32_t>({0, 1}));
+    EXPECT_EQ(get_i32_values(request, "block_indices_begins"), std::vector<int32_t>({0, 2}));
+    EXPECT_EQ(get_i32_values(request, "max_context_len"), std::vector<int32_t>({6}));
+    finish_iteration(single_request);
+
+    // the batch grows back within the storage allocated for the first one
+    for (size_t request_idx = 0; request_idx < 4; ++request_idx) {
+        requests[request_idx]->get_running_sequences()[0]->append_token(80 + request_idx, 0.0f);
+    }
+    scheduler_output = scheduler.schedule(requests);
+    logits = model_runner.forward(requests, scheduler_output);
+    ASSERT_EQ(logits.get_shape(), ov::Shape({4, 1}));
+    EXPECT_EQ(logits.data<float>()[0], 80 * 1000 + 6);
+    for (size_t request_idx = 1; request_idx < 4; ++request_idx) {
+        EXPECT_EQ(logits.data<float>()[request_idx], (80 + request_idx) * 1000 + 5);
+    }
+    EXPECT_EQ(get_i32_values(request, "past_lens"), std::vector<int32_t>({6, 5, 5, 5}));
+    EXPECT_EQ(get_i32_values(request, "subsequence_begins"), std::vector<int32_t>({0, 1, 2, 3, 4}));
+}
@@ -0,0 +1,120 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include "prompt_lookup/ngram_index.hpp"
+
+using namespace ov::genai;
+using TokenIds = std::vector<int64_t>;
+
+namespace {
+
+// brute force search over all earlier occurrences of the last ngram of the sequence
+TokenIds reference_candidates(const TokenIds& tokens, size_t num_pred_tokens, size_t max_ngram_size, bool rank_by_frequency) {
+    const size_t num_tokens = tokens.size();
+    for (size_t ngram_size = std::min(max_ngram_size, num_tokens - 1); ngram_size > 0; --ngram_size) {
+        // { next token, { count, first continuation } }
+        std::map<int64_t, std::pair<size_t, size_t>> continuations;
+        size_t first_continuation = num_tokens, best_continuation = num_tokens, best_count = 0;
+        for (size_t begin = 0; begin + ngram_size < num_tokens; ++begin) {
+            if (!std::equal(tokens.begin() + begin, tokens.begin() + begin + ngram_size, tokens.end() - ngram_size))
+                continue;
+            const size_t continuation = begin + ngram_size;
+            first_continuation = std::min(first_continuation, continuation);
+            auto& [count, position] = continuations.try_emplace(tokens[continuation], 0, continuation).first->second;
+            ++count;
+            if (count > best_count || (count == best_count && position < best_continuation)) {
+                best_count = count;
+                best_continuation = position;
+            }
+        }
+        if (first_continuation == num_tokens)
+            continue;
+        const size_t begin = rank_by_frequency ? best_continuation : first_continuation;
+        return TokenIds(tokens.begin() + begin, tokens.begin() + std::min(num_tokens, begin + num_pred_tokens));
+    }
+    return {};
+}
+
+}  // namespace
+
+TEST(NgramIndexTest, LongestNgramWins) {
+    NgramIndex index(3);
+    // "1 2 3" is followed by 4 5, "2 3" alone by 9
+    TokenIds prompt = {2, 3, 9, 1, 2, 3, 4, 5, 6};
+    index.extend(prompt, {1, 2, 3});
+    EXPECT_EQ(index.find_candidates(2), TokenIds({4, 5}));
+    EXPECT_EQ(index.find_candidates(10), TokenIds({4, 5, 6, 1, 2, 3}));
+}
+
+TEST(NgramIndexTest, RankByFrequency) {
+    NgramIndex index(1);
+    // 7 is followed by 1 first, but by 2 more often
+    TokenIds prompt = {7, 1, 7, 2, 8, 7, 2, 9};
+    index.extend(prompt, {7});
+    EXPECT_EQ(index.find_candidates(2), TokenIds({1, 7}));
+    EXPECT_EQ(index.find_candidates(2, true), TokenIds({2, 8}));
+}
+
+TEST(NgramIndexTest, RankByFrequencyPrefersEarliestOnTie) {
+    NgramIndex index(1);
+    // 1 is followed by 3 and 4 twice each, 4 gets the second occurrence first
+    TokenIds prompt = {1, 3, 1, 4, 1, 4, 1, 3};
+    index.extend(prompt, {1});
+    EXPECT_EQ(index.find_candidates(2, true), TokenIds({3, 1}));
+    EXPECT_EQ(index.find_candidates(2, true), reference_candidates({1, 3, 1, 4, 1, 4, 1, 3, 1}, 2, 1, true));
+}
+
+TEST(NgramIndexTest, CandidateBranches) {
+    NgramIndex index(2);
+    // "1 2" is followed by 3 and 4, "2" is also followed by 5
+    TokenIds prompt = {1, 2, 3, 9, 1, 2, 4, 9, 2, 5, 1, 2, 4, 8};
+    index.extend(prompt, {1, 2});
+    EXPECT_EQ(index.find_candidate_branches(2, 1), std::vector<TokenIds>({{3, 9}}));
+    EXPECT_EQ(index.find_candidate_branches(2, 4), std::vector<TokenIds>({{3, 9}, {4, 9}, {5, 1}}));
+    EXPECT_EQ(index.find_candidate_branches(2, 2, true), std::vector<TokenIds>({{4, 9}, {3, 9}}));
+    EXPECT_EQ(index.find_candidate_branches(2, 2, true).front(), index.find_candidates(2, true));
+}
+
+TEST(NgramIndexTest, ExtendIsIncremental) {
+    NgramIndex index(2);
+    TokenIds prompt = {1, 2, 3};
+    TokenIds generated;
+    index.extend(prompt, generated);
+    EXPECT_TRUE(index.find_candidates(3).empty());
+
+    generated = {1, 2};
+    index.extend(prompt, generated);
+    EXPECT_EQ(index.size(), 5);
+    EXPECT_EQ(index.find_candidates(3), TokenIds({3, 1, 2}));
+
+    // sequence became shorter than the indexed part, the index is rebuilt
+    generated = {};
+    index.extend({5, 5}, generated);
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(index.find_candidates(3), TokenIds({5}));
+}
+
+TEST(NgramIndexTest, MatchesBruteForceSearch) {
+    std::mt19937 rng(42);
+    for (size_t max_ngram_size : {1, 2, 3, 5}) {
+        for (bool rank_by_frequency : {false, true}) {
+            NgramIndex index(max_ngram_size);
+            TokenIds prompt(200), generated;
+            for (auto& token : prompt) {
+                token = rng() % 6;
+            }
+            TokenIds tokens = prompt;
+            for (size_t step = 0; step < 100; ++step) {
+                index.extend(prompt, generated);
+                const size_t num_pred_tokens = 1 + rng() % 5;
+                ASSERT_EQ(index.find_candidates(num_pred_tokens, rank_by_frequency),
+                          reference_candidates(tokens, num_pred_tokens, max_ngram_size, rank_by_frequency));
+                generated.push_back(rng() % 6);
+                tokens.push_back(generated.back());
+            }
+        }
+    }
+}
@@ -165,6 +165,59 @@ TEST(SamplerValidationMode, gen_phase) {
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
 
+TEST(SamplerValidationMode, gen_phase_candidate_branches) {
+    auto sampling_config = ov::genai::greedy();
+    // create sequence group with prompt [0, 1, 2, 3, 4]
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    std::vector<SequenceGroup::Ptr> sequence_groups{
+        SequenceGroup::Ptr(new SequenceGroup(0, input_tensor, sampling_config, 32)),
+    };
+
+    // to emulate processed prompt and add next token [ 0 ]
+    auto sequence = sequence_groups.front()->get_sequences().front();
+    sequence->append_token(0, 1.f);
+    sequence_groups.front()->update_processed_tokens_num(5);
+
+    // append candidates [ 1, 2, 2 ] to the first branch and [ 1, 2, 3 ] to the second one
+    auto forked_sequence = sequence_groups.front()->fork_sequence(sequence);
+    size_t num_validated_tokens = 3;
+    for (size_t i = 1; i <= num_validated_tokens; ++i) {
+        sequence->append_token(i == num_validated_tokens ? i - 1 : i, 1.f);
+        forked_sequence->append_token(i, 1.f);
+    }
+
+    sequence_groups.front()->set_num_validated_tokens(num_validated_tokens);
+    const auto num_scheduled_tokens = sequence_groups.front()->get_num_available_tokens_for_batching();
+    ASSERT_EQ(num_scheduled_tokens, num_validated_tokens + 1);
+    sequence_groups.front()->schedule_tokens(num_scheduled_tokens);
+
+    // create ref tensor : to generate candidates + next token for both branches
+    std::vector<float> logits = {
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+    };
+
+    // shape 1 batch + 2 branches x 4 tokens + 5 vocab
+    ov::Tensor gen_input_ids(ov::element::f32, ov::Shape{1, 8, 5}, logits.data());
+
+    Sampler sampler;
+    auto sampler_output = sampler.sample(sequence_groups, gen_input_ids, true);
+
+    // the second branch has all candidates accepted: [0, 1, 2, 3] + [4], the first one is dropped
+    ASSERT_EQ(sequence_groups.front()->num_total_seqs(), 1);
+    TokenIds expected{0, 1, 2, 3, 4};
+    ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_id(), forked_sequence->get_id());
+    ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
+    ASSERT_EQ(sampler_output.m_dropped_sequences, std::vector<uint64_t>{sequence->get_id()});
+}
+
 TEST(SamplerValidationMode, prompt_phase_to_cut_part_seq) {
     auto sampling_config = ov::genai::greedy();
     // create sequence group with prompt [0, 1, 2, 3, 4]
@@ -9,6 +9,7 @@
 #include "openvino/genai/generation_config.hpp"
 #include "sequence_group.hpp"
 #include "continuous_batching/scheduler.hpp"
+#include "continuous_batching/cache_eviction.hpp"
 #include "helper.hpp"
 
 using namespace ov::genai;
@@ -1023,6 +1024,98 @@ TEST(TestScheduler, FullyPreemptsCacheEvictedSequences) {
     }
 }
 
+TEST(TestScheduler, chunked_prefill_evicts_after_each_chunk) {
+    const size_t block_size = 2;
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 4;  // prompt is processed in chunks of 2 blocks
+    scheduler_config.num_kv_blocks = 20;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.use_cache_eviction = true;
+    scheduler_config.cache_eviction_config = ov::genai::CacheEvictionConfig(2, 2, 6, ov::genai::AggregationMode::NORM_SUM, false, true);
+
+    std::vector<uint64_t> tokens = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};  // 8 blocks, 4 chunks
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                        ov::genai::greedy(), block_size);
+    auto idx0 = (*sequence_group)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group};
+
+    Scheduler scheduler = Scheduler(block_size, init_cache_manager(scheduler_config), scheduler_config);
+    CacheEvictionAlgorithm algo(scheduler_config.cache_eviction_config, block_size, 1);
+
+    // the eviction arena keeps 3 blocks, every chunk adds up to 2 blocks on top of it and is evicted from right away
+    const std::vector<size_t> ref_num_blocks_before_eviction{2, 4, 5, 5};
+    const std::vector<size_t> ref_num_blocks_after_eviction{2, 3, 3, 3};
+    for (size_t chunk_idx = 0; chunk_idx < ref_num_blocks_before_eviction.size(); ++chunk_idx) {
+        ASSERT_FALSE(sequence_group->can_generate_tokens());
+        auto out = scheduler.schedule(requests);
+        EXPECT_EQ(out.m_total_num_scheduled_tokens, scheduler_config.max_num_batched_tokens);
+        EXPECT_EQ(out.m_block_tables[idx0][0].size(), ref_num_blocks_before_eviction[chunk_idx]);
+
+        // the attention scores are reported for all tokens present in the KV cache after the chunk
+        size_t num_cached_tokens = sequence_group->get_context_len() - sequence_group->get_num_evicted_tokens();
+        ov::Tensor scores(ov::element::f32, ov::Shape{num_cached_tokens});
+        std::fill_n(scores.data<float>(), num_cached_tokens, 1.0f);
+        algo.register_new_token_scores(scores, 0);
+
+        std::vector<std::set<size_t>> blocks_to_evict{algo.evict_logical_blocks(0)};
+        scheduler.free_blocks_from_sequence(idx0, blocks_to_evict);
+        sequence_group->register_token_eviction(blocks_to_evict[0].size() * block_size);
+        sequence_group->finish_iteration();
+
+        EXPECT_EQ(scheduler.get_block_tables(*(*sequence_group)[0])[0].size(), ref_num_blocks_after_eviction[chunk_idx]);
+    }
+
+    EXPECT_TRUE(sequence_group->can_generate_tokens());
+    EXPECT_EQ(sequence_group->get_num_evicted_tokens(), tokens.size() - 3 * block_size);
+    scheduler.free_sequence(idx0);
+}
+
+TEST(TestScheduler, chunked_prefill_processes_snapkv_window_separately) {
+    const size_t block_size = 2;
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 8;
+    scheduler_config.num_kv_blocks = 20;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.use_cache_eviction = true;
+    scheduler_config.cache_eviction_config = ov::genai::CacheEvictionConfig(2, 2, 6, ov::genai::AggregationMode::NORM_SUM);
+    scheduler_config.cache_eviction_config.snapkv_window_size = 6;
+
+    std::vector<uint64_t> tokens = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                        ov::genai::greedy(), block_size);
+    auto idx0 = (*sequence_group)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group};
+
+    Scheduler scheduler = Scheduler(block_size, init_cache_manager(scheduler_config), scheduler_config);
+
+    // the chunk before the window is cut at its beginning, the window is scheduled on its own
+    const std::vector<size_t> ref_num_scheduled_tokens{8, 2, 6};
+    for (size_t ref_num_tokens : ref_num_scheduled_tokens) {
+        ASSERT_FALSE(sequence_group->can_generate_tokens());
+        auto out = scheduler.schedule(requests);
+        EXPECT_EQ(out.m_total_num_scheduled_tokens, ref_num_tokens);
+        sequence_group->finish_iteration();
+    }
+
+    EXPECT_TRUE(sequence_group->can_generate_tokens());
+    scheduler.free_sequence(idx0);
+}
+
+TEST(TestScheduler, cache_eviction_during_prefill_requires_dynamic_split_fuse) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.num_kv_blocks = 20;
+    scheduler_config.dynamic_split_fuse = false;
+    scheduler_config.use_cache_eviction = true;
+
+    scheduler_config.cache_eviction_config = ov::genai::CacheEvictionConfig(2, 2, 6, ov::genai::AggregationMode::NORM_SUM, false, true);
+    EXPECT_THROW(Scheduler(2, init_cache_manager(scheduler_config), scheduler_config), ov::Exception);
+
+    scheduler_config.cache_eviction_config = ov::genai::CacheEvictionConfig(2, 2, 6, ov::genai::AggregationMode::NORM_SUM, false, false, 4);
+    EXPECT_THROW(Scheduler(2, init_cache_manager(scheduler_config), scheduler_config), ov::Exception);
+}
+
 TEST(TestScheduler, prefix_caching_embeddings_test) {
     std::array<SchedulerConfig, 2> configs = {SchedulerConfig(), SchedulerConfig()};
     configs.at(0).max_num_batched_tokens = 32;
@@ -1112,4 +1205,345 @@ TEST(TestScheduler, prefix_caching_embeddings_test) {
          }
     }
 
-}
\ No newline at end of file
+}
+
+TEST(TestScheduler, priority_policy_preempts_low_priority_sequence_group) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 6;
+    scheduler_config.dynamic_split_fuse = false;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.scheduling_policy = SchedulingPolicy::PRIORITY;
+    scheduler_config.priority_aging_interval_ms = 0;
+
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7,8,9,10,11};
+    SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            ov::genai::greedy(), 4);
+    auto idx0 = (*sequence_group1)[0]->get_id();
+    GenerationConfig high_priority_config = ov::genai::greedy();
+    high_priority_config.priority = 1;
+    SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            high_priority_config, 4);
+    auto idx1 = (*sequence_group2)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2};
+
+    // both prompts fit into 2*3 kv blocks, the one with higher priority goes first
+    const bool can_use_partial_preemption = false;
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config, 1, can_use_partial_preemption);
+    auto out1 = scheduler.schedule(requests);
+    ASSERT_EQ(requests[0], sequence_group2);
+    ASSERT_EQ(requests[1], sequence_group1);
+    ASSERT_EQ(out1.m_total_num_scheduled_tokens, 24);
+
+    for (auto req : requests)
+        req->finish_iteration();
+
+    // the low priority sequence_group1 is preempted in spite of the earlier arrival
+    auto out2 = scheduler.schedule(requests);
+    std::vector<uint64_t> ref_ids = {0};
+    ASSERT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+    ASSERT_EQ(requests[0], sequence_group2);
+    EXPECT_TRUE(scheduler.has_block_table(idx1));
+    EXPECT_FALSE(scheduler.has_block_table(idx0));
+
+    scheduler.free_sequence(idx1);
+}
+
+TEST(TestScheduler, priority_policy_keeps_scheduled_ids_in_sequence_groups_order) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 6;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.scheduling_policy = SchedulingPolicy::PRIORITY;
+    scheduler_config.priority_aging_interval_ms = 0;
+
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7};
+    SequenceGroup::Ptr low_priority = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                         ov::genai::greedy(), 4);
+    auto idx0 = (*low_priority)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {low_priority};
+
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out1 = scheduler.schedule(requests);
+    ASSERT_EQ(out1.m_total_num_scheduled_tokens, tokens.size());
+    low_priority->get_running_sequences()[0]->append_token(8, 0.f);
+    low_priority->finish_iteration();
+
+    GenerationConfig high_priority_config = ov::genai::greedy();
+    high_priority_config.priority = 1;
+    SequenceGroup::Ptr high_priority = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                          high_priority_config, 4);
+    auto idx1 = (*high_priority)[0]->get_id();
+    requests.push_back(high_priority);
+
+    // the running low priority group is scheduled first by the generate phase, but it's placed after the waiting high
+    // priority one by the policy, so that logits are laid out in the order the sampler walks the sequence groups
+    auto out2 = scheduler.schedule(requests);
+    ASSERT_EQ(requests[0], high_priority);
+    ASSERT_EQ(requests[1], low_priority);
+    std::vector<uint64_t> ref_ids = {0, 1};
+    EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(out2.m_total_num_scheduled_tokens, tokens.size() + 1);
+
+    scheduler.free_sequence(idx0);
+    scheduler.free_sequence(idx1);
+}
+
+TEST(TestScheduler, priority_policy_ages_and_respects_ttft_deadlines) {
+    std::vector<uint64_t> tokens = {0,1,2,3};
+    auto create_sequence_group = [&tokens] (uint64_t request_id, size_t priority, size_t ttft_deadline_ms) {
+        GenerationConfig config = ov::genai::greedy();
+        config.priority = priority;
+        config.ttft_deadline_ms = ttft_deadline_ms;
+        return std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()), config, 4);
+    };
+    SequenceGroup::Ptr low_priority = create_sequence_group(0, 0, 0);
+    SequenceGroup::Ptr no_deadline = create_sequence_group(1, 2, 0);
+    SequenceGroup::Ptr late_deadline = create_sequence_group(2, 2, 10000);
+    SequenceGroup::Ptr early_deadline = create_sequence_group(3, 2, 100);
+    std::vector<SequenceGroup::Ptr> requests = {low_priority, no_deadline, late_deadline, early_deadline};
+
+    PrioritySchedulingPolicy policy(1000);
+    auto now = low_priority->get_arrival_time();
+    policy.order(requests, now);
+    std::vector<SequenceGroup::Ptr> ref_order = {early_deadline, late_deadline, no_deadline, low_priority};
+    EXPECT_EQ(requests, ref_order);
+
+    // each aging interval spent in the pipeline raises the priority by one
+    EXPECT_EQ(policy.get_effective_priority(low_priority, now + std::chrono::milliseconds(999)), 0);
+    EXPECT_EQ(policy.get_effective_priority(low_priority, now + std::chrono::milliseconds(3000)), 3);
+
+    // the deadline is not taken into account once the first token is generated
+    early_deadline->get_running_sequences()[0]->append_token(0, 0.f);
+    policy.order(requests, now);
+    ref_order = {late_deadline, early_deadline, no_deadline, low_priority};
+    EXPECT_EQ(requests, ref_order);
+}
+
+TEST(TestScheduler, priority_policy_keeps_arrival_order_of_equal_priority_requests) {
+    std::vector<uint64_t> tokens = {0,1,2,3};
+    auto create_sequence_group = [&tokens] (uint64_t request_id, size_t ttft_deadline_ms) {
+        GenerationConfig config = ov::genai::greedy();
+        config.ttft_deadline_ms = ttft_deadline_ms;
+        return std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()), config, 4);
+    };
+    SequenceGroup::Ptr first = create_sequence_group(0, 0);
+    SequenceGroup::Ptr second = create_sequence_group(1, 100);
+    std::vector<SequenceGroup::Ptr> requests = {first, second};
+
+    PrioritySchedulingPolicy policy(0);
+    auto now = second->get_arrival_time();
+    // the deadline moves the later request in front
+    policy.order(requests, now);
+    std::vector<SequenceGroup::Ptr> ref_order = {second, first};
+    EXPECT_EQ(requests, ref_order);
+
+    // once the deadline is met both requests are equal, and the next steps must restore the arrival order
+    // in spite of the order left by the previous step
+    second->get_running_sequences()[0]->append_token(0, 0.f);
+    ref_order = {first, second};
+    for (size_t step = 0; step < 2; ++step) {
+        policy.order(requests, now);
+        EXPECT_EQ(requests, ref_order);
+    }
+
+    // requests re-queued in any order are served in the arrival order
+    requests = {second, first};
+    policy.order(requests, now);
+    EXPECT_EQ(requests, ref_order);
+}
+
+TEST(TestScheduler, preemption_by_swap_restores_kv_cache_blocks) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 6;
+    scheduler_config.dynamic_split_fuse = false;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.swap_space = 1;
+
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7,8,9,10,11};
+    SequenceGroup::Ptr sequence_group1 = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            ov::genai::greedy(), 4);
+    auto idx0 = (*sequence_group1)[0]->get_id();
+    SequenceGroup::Ptr sequence_group2 = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                                            ov::genai::greedy(), 4);
+    auto idx1 = (*sequence_group2)[0]->get_id();
+    std::vector<SequenceGroup::Ptr> requests = {sequence_group1, sequence_group2};
+
+    const bool can_use_partial_preemption = false;
+    auto cache_manager = init_cache_manager(scheduler_config);
+    Scheduler scheduler = Scheduler(4, cache_manager, scheduler_config, 1, can_use_partial_preemption);
+    // recompute is estimated to be much more expensive than moving the blocks to host memory and back
+    scheduler.register_inference_time(1, 1e6f);
+
+    // schedule 2 sequence groups that use all available 2*3 kv blocks
+    auto out1 = scheduler.schedule(requests);
+    ASSERT_EQ(out1.m_total_num_scheduled_tokens, 24);
+    for (auto req : requests)
+        req->finish_iteration();
+
+    // fill the blocks of sequence_group2 with distinct contents
+    std::vector<std::vector<uint8_t>> ref_contents;
+    for (const auto& block : scheduler.get_block_tables(idx1)[0]) {
+        std::vector<uint8_t> contents(cache_manager->get_block_contents_size());
+        for (size_t i = 0; i < contents.size(); ++i) {
+            contents[i] = static_cast<uint8_t>(i * 7 + block->get_index());
+        }
+        cache_manager->write_block(block->get_index(), contents);
+        ref_contents.push_back(contents);
+    }
+
+    // sequence_group2 is swapped out, its processed tokens are kept
+    auto out2 = scheduler.schedule(requests);
+    std::vector<uint64_t> ref_ids = {0};
+    ASSERT_EQ(out2.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(sequence_group2->get_num_processed_tokens(), 12);
+    EXPECT_TRUE(scheduler.has_block_table(idx1));
+
+    for (auto req : requests)
+        req->finish_iteration();
+
+    // finish first sequence
+    requests[0]->get_running_sequences()[0]->set_status(SequenceStatus::FINISHED);
+    scheduler.free_sequence(idx0);
+    clear_finished_sequences(requests);
+
+    // sequence_group2 is swapped in and continues generation without prompt recompute
+    auto out3 = scheduler.schedule(requests);
+    ASSERT_EQ(out3.m_total_num_scheduled_tokens, 1);
+    auto block_table = scheduler.get_block_tables(idx1)[0];
+    ASSERT_EQ(block_table.size(), 4);
+    for (size_t i = 0; i < ref_contents.size(); ++i) {
+        std::vector<uint8_t> contents;
+        cache_manager->read_block(block_table[i]->get_index(), contents);
+        EXPECT_EQ(contents, ref_contents[i]);
+    }
+
+    scheduler.free_sequence(idx1);
+}
+
+TEST(TestScheduler, admission_control_defers_requests_exceeding_forecast_kv_cache) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 10;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.enable_admission_control = true;
+    scheduler_config.admission_headroom = 0.0f;
+
+    GenerationConfig generation_config = ov::genai::greedy();
+    generation_config.max_new_tokens = 8;
+    std::vector<uint64_t> tokens = {0,1,2,3,4,5,6,7};
+    std::vector<SequenceGroup::Ptr> requests;
+    for (uint64_t request_id = 0; request_id < 3; ++request_id) {
+        requests.push_back(std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                           generation_config, 4));
+    }
+    auto idx0 = (*requests[0])[0]->get_id();
+    auto idx1 = (*requests[1])[0]->get_id();
+    auto idx2 = (*requests[2])[0]->get_id();
+
+    // each request is forecast to take 2 blocks of the prompt and 2 blocks of the output, the third one doesn't fit
+    // although its prompt does
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out1 = scheduler.schedule(requests);
+    std::vector<uint64_t> ref_ids = {0, 1};
+    EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(out1.m_num_deferred_sequence_groups, 1);
+    EXPECT_FLOAT_EQ(out1.m_forecast_cache_usage, 80.0f);
+    EXPECT_FALSE(scheduler.has_block_table(idx2));
+
+    for (auto req : requests)
+        req->finish_iteration();
+
+    // finish first sequence, the third request is admitted
+    requests[0]->get_running_sequences()[0]->set_status(SequenceStatus::FINISHED);
+    scheduler.free_sequence(idx0);
+    clear_finished_sequences(requests);
+
+    auto out2 = scheduler.schedule(requests);
+    EXPECT_EQ(out2.m_num_deferred_sequence_groups, 0);
+    EXPECT_FLOAT_EQ(out2.m_forecast_cache_usage, 80.0f);
+    EXPECT_TRUE(scheduler.has_block_table(idx2));
+
+    scheduler.free_sequence(idx1);
+    scheduler.free_sequence(idx2);
+}
+
+TEST(TestScheduler, admission_control_forecasts_average_output_len) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 10;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.enable_admission_control = true;
+    scheduler_config.admission_headroom = 0.0f;
+    scheduler_config.forecast_average_output_len = true;
+
+    GenerationConfig generation_config = ov::genai::greedy();
+    generation_config.max_new_tokens = 16;
+    std::vector<uint64_t> tokens = {0,1,2,3};
+    auto create_sequence_group = [&](uint64_t request_id) {
+        return std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()), generation_config, 4);
+    };
+
+    // forecast from max_new_tokens: 1 block of the prompt and 4 blocks of the output
+    std::vector<SequenceGroup::Ptr> requests = {create_sequence_group(0)};
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out1 = scheduler.schedule(requests);
+    EXPECT_FLOAT_EQ(out1.m_forecast_cache_usage, 50.0f);
+
+    // the request finishes after a single generated token
+    requests[0]->finish_iteration();
+    auto sequence = requests[0]->get_running_sequences()[0];
+    sequence->append_token(16, 0.9);
+    sequence->set_status(SequenceStatus::FINISHED);
+    scheduler.free_sequence(sequence->get_id());
+    clear_finished_sequences(requests);
+
+    // the output of the next ones is forecast to fit into a single block, all of them are admitted
+    for (uint64_t request_id = 1; request_id < 6; ++request_id) {
+        requests.push_back(create_sequence_group(request_id));
+    }
+    auto out2 = scheduler.schedule(requests);
+    EXPECT_EQ(out2.m_num_deferred_sequence_groups, 0);
+    EXPECT_FLOAT_EQ(out2.m_forecast_cache_usage, 100.0f);
+
+    for (const auto& request : requests) {
+        scheduler.free_sequence(request->get_running_sequences()[0]->get_id());
+    }
+}
+
+TEST(TestScheduler, admission_control_forecasts_default_output_len_for_unbounded_requests) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 10;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.enable_admission_control = true;
+    scheduler_config.admission_headroom = 0.0f;
+    scheduler_config.default_forecast_output_len = 8;
+
+    // neither max_new_tokens nor max_length is set, the requests run till EOS
+    GenerationConfig generation_config = ov::genai::greedy();
+    generation_config.max_new_tokens = SIZE_MAX;
+    std::vector<uint64_t> tokens = {0,1,2,3};
+    std::vector<SequenceGroup::Ptr> requests;
+    for (uint64_t request_id = 0; request_id < 4; ++request_id) {
+        requests.push_back(std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()),
+                                                           generation_config, 4));
+    }
+
+    // each request is forecast to take 1 block of the prompt and 2 blocks of the output instead of the whole KV cache
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out = scheduler.schedule(requests);
+    std::vector<uint64_t> ref_ids = {0, 1, 2};
+    EXPECT_EQ(out.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(out.m_num_deferred_sequence_groups, 1);
+    EXPECT_FLOAT_EQ(out.m_forecast_cache_usage, 90.0f);
+
+    for (size_t request_idx = 0; request_idx < 3; ++request_idx) {
+        scheduler.free_sequence(requests[request_idx]->get_running_sequences()[0]->get_id());
+    }
+}
@@ -29,6 +29,15 @@ protected:
             return std::make_shared<ov::genai::GenerationHandleImpl>(sequence_group->get_generation_stream(), sampling_params);
         };
 
+        bool is_paused(uint64_t request_id) {
+            for (const auto& request : m_requests) {
+                if (request->get_request_id() == request_id) {
+                    return request->is_waiting();
+                }
+            }
+            return false;
+        }
+
     };
 
     PipelineTestInstance m_pipeline = PipelineTestInstance();
@@ -426,3 +435,27 @@ TEST_F(CBForSDTest, add_tokens__two_sequence) {
     ASSERT_EQ(after.at(0).at(1).log_probs, log_probs);
 }
 
+
+TEST_F(CBForSDTest, pause_requests) {
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    for (uint64_t request_id = 0; request_id < 3; ++request_id) {
+        m_pipeline.add_request(request_id, input_tensor);
+    }
+    ASSERT_EQ(m_pipeline.get_request_ids(), std::vector<uint64_t>({0, 1, 2}));
+
+    m_pipeline.pause_requests({0, 1});
+    ASSERT_TRUE(m_pipeline.is_paused(0));
+    ASSERT_TRUE(m_pipeline.is_paused(1));
+    ASSERT_FALSE(m_pipeline.is_paused(2));
+
+    // other requests keep their state unless they are resumed explicitly
+    m_pipeline.pause_requests({2});
+    ASSERT_TRUE(m_pipeline.is_paused(0));
+    ASSERT_TRUE(m_pipeline.is_paused(2));
+
+    m_pipeline.pause_requests({1}, true);
+    ASSERT_FALSE(m_pipeline.is_paused(0));
+    ASSERT_TRUE(m_pipeline.is_paused(1));
+    ASSERT_FALSE(m_pipeline.is_paused(2));
+}
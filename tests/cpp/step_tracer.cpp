@@ -0,0 +1,85 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "continuous_batching/step_tracer.hpp"
+
+using namespace ov::genai;
+
+TEST(StepTracerTest, KeepsMostRecentSpans) {
+    StepTracer tracer(3);
+    const auto now = std::chrono::steady_clock::now();
+    const char* names[] = {"schedule", "forward", "sample", "stream"};
+    for (const char* name : names) {
+        tracer.begin_step();
+        tracer.record(name, now, now + std::chrono::microseconds(10));
+    }
+
+    const auto events = tracer.get_events();
+    ASSERT_EQ(events.size(), 3);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_STREQ(events[i].name, names[i + 1]);
+        EXPECT_EQ(events[i].step, i + 2);
+        EXPECT_EQ(events[i].duration_us, 10);
+    }
+}
+
+TEST(StepTracerTest, SpanDoesNothingWithoutTracer) {
+    StepTracer::Span span(nullptr, "step");
+    span.set_batch({});
+}
+
+TEST(StepTracerTest, DumpsChromeTrace) {
+    StepTracer tracer(10);
+    tracer.begin_step();
+    {
+        StepTracer::Span step_span(&tracer, "step");
+        { StepTracer::Span span(&tracer, "forward"); }
+        StepTracer::BatchComposition batch;
+        batch.num_prompt_tokens = 7;
+        batch.num_decode_tokens = 3;
+        batch.num_scheduled_groups = 4;
+        batch.cache_usage = 12.5f;
+        step_span.set_batch(batch);
+    }
+
+    const auto events = tracer.get_events();
+    ASSERT_EQ(events.size(), 2);
+    // nested span ends first
+    EXPECT_STREQ(events[0].name, "forward");
+    EXPECT_FALSE(events[0].batch.has_value());
+    EXPECT_STREQ(events[1].name, "step");
+    ASSERT_TRUE(events[1].batch.has_value());
+    EXPECT_LE(events[1].begin_us, events[0].begin_us);
+
+    std::ostringstream os;
+    tracer.dump(os);
+    const std::string trace = os.str();
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    EXPECT_NE(trace.find("\"name\":\"forward\",\"cat\":\"continuous_batching\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"num_prompt_tokens\":7,\"num_decode_tokens\":3,\"num_scheduled_groups\":4,\"cache_usage\":12.5"), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"cache usage\",\"cat\":\"continuous_batching\",\"ph\":\"C\""), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+TEST(StepTracerTest, RecordsSpansOfEachThreadOnSeparateTrack) {
+    StepTracer tracer(10);
+    tracer.begin_step();
+    { StepTracer::Span span(&tracer, "forward"); }
+    std::thread([&tracer] { StepTracer::Span span(&tracer, "draft forward"); }).join();
+    { StepTracer::Span span(&tracer, "sample"); }
+
+    const auto events = tracer.get_events();
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_EQ(events[0].tid, 0);
+    EXPECT_EQ(events[1].tid, 1);
+    EXPECT_EQ(events[2].tid, 0);
+
+    std::ostringstream os;
+    tracer.dump(os);
+    EXPECT_NE(os.str().find("\"name\":\"draft forward\",\"cat\":\"continuous_batching\",\"ph\":\"X\",\"pid\":0,\"tid\":1,"), std::string::npos);
+}
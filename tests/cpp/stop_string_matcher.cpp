@@ -0,0 +1,136 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <random>
+#include "sampling/stop_string_matcher.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+StopStringMatcher::TokenTexts make_vocab() {
+    return std::make_shared<const std::vector<std::string>>(std::vector<std::string>{
+        "", "Hello", " world", "!", "\n", " ", "wor", "ld", "<", "|", "end", ">", "|>", "e", "nd", "x"
+    });
+}
+
+std::string decode(const std::vector<std::string>& vocab, std::vector<int64_t>::const_iterator begin, std::vector<int64_t>::const_iterator end) {
+    std::string text;
+    for (auto it = begin; it != end; ++it) {
+        text += vocab[*it];
+    }
+    return text;
+}
+
+// decoding based matching from the sampler, with decode being concatenation of the token texts
+MatchStopStringResult reference_match(const std::vector<std::string>& vocab, const std::vector<int64_t>& generated_tokens,
+                                      const std::set<std::string>& stop_strings, size_t window_size, bool is_include_to_output) {
+    MatchStopStringResult result;
+    if (generated_tokens.size() < window_size)
+        return result;
+    std::vector<int64_t> buffer(generated_tokens.end() - window_size, generated_tokens.end());
+    std::string decoded_buffer = decode(vocab, buffer.begin(), buffer.end());
+    for (const auto& stop_string : stop_strings) {
+        auto pos = decoded_buffer.find(stop_string);
+        if (pos == std::string::npos)
+            continue;
+        result.is_matched = true;
+        decoded_buffer = decoded_buffer.substr(0, pos + (is_include_to_output ? stop_string.length() : 0));
+        while (!decoded_buffer.empty() && (decoded_buffer.back() == ' ' || decoded_buffer.back() == '\n')) {
+            decoded_buffer.pop_back();
+        }
+        if (decoded_buffer.empty()) {
+            result.to_remove = buffer.size();
+            return result;
+        }
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            if (decode(vocab, buffer.begin(), buffer.begin() + i + 1).find(decoded_buffer) != std::string::npos) {
+                result.to_remove = buffer.size() - i - 1;
+                break;
+            }
+        }
+        return result;
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(StopStringMatcherTest, StopStringSplitAcrossTokens) {
+    auto vocab = make_vocab();
+    StopStringMatcher matcher(vocab, {"<|end|>"}, 4);
+
+    // "Hello" "<" "|" "end" "|>"
+    std::vector<int64_t> tokens = {1, 8, 9, 10, 12};
+    auto result = matcher.match(tokens, false);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 4);
+
+    result = matcher.match(tokens, true);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+
+    // "Hello" "<" "|" "e" "nd" is not finished yet
+    tokens = {1, 8, 9, 13, 14};
+    EXPECT_FALSE(matcher.match(tokens, false).is_matched);
+}
+
+TEST(StopStringMatcherTest, TrailingSpacesAreRemoved) {
+    auto vocab = make_vocab();
+    StopStringMatcher matcher(vocab, {"!"}, 1);
+
+    // "Hello" " world" " " "\n" "!": the text before the stop string ends with "world"
+    std::vector<int64_t> tokens = {1, 2, 5, 4, 3};
+    auto result = matcher.match(tokens, false, 3);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+}
+
+TEST(StopStringMatcherTest, FirstStopStringInSetOrderWins) {
+    auto vocab = make_vocab();
+    // "!" is found earlier in the text, but " world" comes first in the set order
+    StopStringMatcher matcher(vocab, {" world", "!"}, 4);
+
+    std::vector<int64_t> tokens = {1, 3, 5, 6, 7};
+    auto result = matcher.match(tokens, true);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+
+    result = matcher.match(tokens, false);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+}
+
+TEST(StopStringMatcherTest, IsApplicable) {
+    auto vocab = make_vocab();
+    EXPECT_TRUE(StopStringMatcher::is_applicable(*vocab, "<|end|>", {8, 9, 10, 12}));
+    EXPECT_FALSE(StopStringMatcher::is_applicable(*vocab, "<|end|>", {8, 9, 10}));
+    EXPECT_FALSE(StopStringMatcher::is_applicable(*vocab, "<|end|>", {8, 9, 10, 100}));
+}
+
+TEST(StopStringMatcherTest, MatchesDecodingReference) {
+    auto vocab = make_vocab();
+    const std::vector<std::set<std::string>> stop_strings_variants = {
+        {"world"}, {"!", "\n"}, {"<|end|>", "ld!", "x x"}, {"d", "end", "rld"}, {"xx", "xxx", "x\nx"}
+    };
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> token_distribution(1, vocab->size() - 1);
+    for (const auto& stop_strings : stop_strings_variants) {
+        for (size_t window_size : {1, 2, 5}) {
+            StopStringMatcher matcher(vocab, stop_strings, window_size);
+            for (size_t iteration = 0; iteration < 500; ++iteration) {
+                std::vector<int64_t> tokens(1 + rng() % 8);
+                for (auto& token : tokens) {
+                    token = token_distribution(rng);
+                }
+                for (bool is_include_to_output : {false, true}) {
+                    auto expected = reference_match(*vocab, tokens, stop_strings, window_size, is_include_to_output);
+                    auto result = matcher.match(tokens, is_include_to_output);
+                    ASSERT_EQ(result.is_matched, expected.is_matched);
+                    ASSERT_EQ(result.to_remove, expected.to_remove);
+                }
+            }
+        }
+    }
+}
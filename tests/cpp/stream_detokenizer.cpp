@@ -0,0 +1,182 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include "continuous_batching/stream_detokenizer.hpp"
+#include "continuous_batching/threaded_streamer.hpp"
+#include "generation_stream.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+const std::vector<std::string> vocab = {"", "Hello", " world", "\n", "\xc3", "\xa9", "!"};
+
+// decoding is concatenation of token texts with invalid UTF-8 at the end replaced like the detokenizer does
+std::string decode_tokens(const std::vector<int64_t>& tokens) {
+    std::string text;
+    for (int64_t token : tokens) {
+        text += vocab.at(token);
+    }
+    if (!text.empty() && text.back() == '\xc3') {
+        text.back() = '\xef';
+        text += "\xbf\xbd";
+    }
+    return text;
+}
+
+// pads shorter lines with the pad token before decoding, like batched decoding of the tokenizer
+std::vector<std::string> decode_padded(const std::vector<std::vector<int64_t>>& lines, int64_t pad_token_id) {
+    size_t max_len = 0;
+    for (const auto& line : lines) {
+        max_len = std::max(max_len, line.size());
+    }
+    std::vector<std::string> texts;
+    for (auto line : lines) {
+        line.resize(max_len, pad_token_id);
+        texts.push_back(decode_tokens(line));
+    }
+    return texts;
+}
+
+GenerationOutputs make_outputs(std::vector<int64_t> generated_ids, GenerationFinishReason finish_reason = GenerationFinishReason::NONE) {
+    GenerationOutput output;
+    output.generated_ids = std::move(generated_ids);
+    output.finish_reason = finish_reason;
+    return {{0, output}};
+}
+
+}  // namespace
+
+TEST(StreamDetokenizerTest, BatchesStreamsAndSplitsText) {
+    std::atomic<size_t> num_decode_calls = 0;
+    auto detokenizer = std::make_shared<StreamDetokenizer>([&num_decode_calls](const std::vector<std::vector<int64_t>>& lines) {
+        ++num_decode_calls;
+        std::vector<std::string> texts;
+        for (const auto& line : lines) {
+            texts.push_back(decode_tokens(line));
+        }
+        return texts;
+    });
+    auto first = GenerationStream::create(), second = GenerationStream::create();
+    first->set_detokenizer(detokenizer);
+    second->set_detokenizer(detokenizer);
+
+    first->push(make_outputs({1}));
+    second->push(make_outputs({2, 4}));
+    EXPECT_TRUE(first->can_read());
+    detokenizer->flush();
+    EXPECT_EQ(first->read().at(0).text, "Hello");
+    // text ending with an incomplete character is held back
+    EXPECT_EQ(second->read().at(0).text, "");
+    EXPECT_EQ(num_decode_calls, 1);
+
+    first->push(make_outputs({2, 3}));
+    second->push(make_outputs({5}));
+    second->push(make_outputs({6}, GenerationFinishReason::STOP));
+    detokenizer->flush();
+    auto first_outputs = first->read();
+    EXPECT_EQ(first_outputs.at(0).text, " world\n");
+    EXPECT_EQ(first_outputs.at(0).generated_ids, std::vector<int64_t>({2, 3}));
+    // text of several outputs of a sequence in one batch goes to the latest one
+    EXPECT_EQ(second->read().at(0).text, "");
+    EXPECT_EQ(second->read().at(0).text, " world\xc3\xa9!");
+    EXPECT_FALSE(second->can_read());
+    EXPECT_EQ(num_decode_calls, 2);
+
+    // tokens before the new line are not decoded again
+    first->push(make_outputs({1}, GenerationFinishReason::LENGTH));
+    first->push({});
+    detokenizer->flush();
+    EXPECT_EQ(first->read().at(0).text, "Hello");
+    EXPECT_TRUE(first->read().empty());
+}
+
+TEST(StreamDetokenizerTest, DecodingErrorIsReported) {
+    auto detokenizer = std::make_shared<StreamDetokenizer>([](const std::vector<std::vector<int64_t>>& lines) -> std::vector<std::string> {
+        OPENVINO_THROW("Detokenizer is not available");
+    });
+    auto stream = GenerationStream::create();
+    stream->set_detokenizer(detokenizer);
+    stream->push(make_outputs({1}));
+    detokenizer->flush();
+
+    // tokens still reach the stream
+    auto outputs = stream->read();
+    EXPECT_EQ(outputs.at(0).generated_ids, std::vector<int64_t>({1}));
+    EXPECT_TRUE(outputs.at(0).text.empty());
+    EXPECT_THROW(detokenizer->flush(), ov::Exception);
+    EXPECT_NO_THROW(detokenizer->flush());
+}
+
+TEST(StreamDetokenizerTest, PadTokenDoesNotLeakIntoText) {
+    // pads shorter lines with "!", which is not skipped, like a detokenizer with a regular pad token
+    std::vector<size_t> batch_sizes;
+    auto detokenizer = std::make_shared<StreamDetokenizer>([&batch_sizes](const std::vector<std::vector<int64_t>>& lines) {
+        batch_sizes.push_back(lines.size());
+        return decode_padded(lines, 6);
+    }, false);
+    auto first = GenerationStream::create(), second = GenerationStream::create(), third = GenerationStream::create();
+    first->set_detokenizer(detokenizer);
+    second->set_detokenizer(detokenizer);
+    third->set_detokenizer(detokenizer);
+
+    first->push(make_outputs({1}));
+    second->push(make_outputs({1, 2}));
+    third->push(make_outputs({2}));
+    detokenizer->flush();
+    EXPECT_EQ(first->read().at(0).text, "Hello");
+    EXPECT_EQ(second->read().at(0).text, "Hello world");
+    EXPECT_EQ(third->read().at(0).text, " world");
+    // lines of the same length are still decoded together
+    std::sort(batch_sizes.begin(), batch_sizes.end());
+    EXPECT_EQ(batch_sizes, std::vector<size_t>({1, 2}));
+}
+
+TEST(StreamDetokenizerTest, LinesOfDifferentLengthsShareBatchIfPaddingIsSkipped) {
+    // pads shorter lines with a token of empty text, like a detokenizer skipping the pad token as a special one
+    std::vector<size_t> batch_sizes;
+    auto detokenizer = std::make_shared<StreamDetokenizer>([&batch_sizes](const std::vector<std::vector<int64_t>>& lines) {
+        batch_sizes.push_back(lines.size());
+        return decode_padded(lines, 0);
+    }, true);
+    auto first = GenerationStream::create(), second = GenerationStream::create(), third = GenerationStream::create();
+    first->set_detokenizer(detokenizer);
+    second->set_detokenizer(detokenizer);
+    third->set_detokenizer(detokenizer);
+
+    first->push(make_outputs({1}));
+    second->push(make_outputs({1, 2}));
+    third->push(make_outputs({2, 3, 1}));
+    detokenizer->flush();
+    EXPECT_EQ(first->read().at(0).text, "Hello");
+    EXPECT_EQ(second->read().at(0).text, "Hello world");
+    EXPECT_EQ(third->read().at(0).text, " world\nHello");
+    EXPECT_EQ(batch_sizes, std::vector<size_t>({3}));
+}
+
+TEST(StreamDetokenizerTest, ThreadedStreamerGetsDecodedText) {
+    Tokenizer tokenizer;
+    std::string streamed_text;
+    std::function<StreamingStatus(std::string)> callback = [&streamed_text](std::string text) {
+        streamed_text += text;
+        return streamed_text.size() < 11 ? StreamingStatus::RUNNING : StreamingStatus::STOP;
+    };
+    // the callback gets the text of the outputs as is, no tokenizer is involved
+    ThreadedStreamerWrapper streamer(callback, tokenizer, true);
+    ASSERT_TRUE(streamer.has_callback());
+    ASSERT_TRUE(streamer.is_text_streamed());
+    streamer.start();
+    streamer.write_text("Hello");
+    streamer.write_text("");
+    streamer.write_text(" world");
+    streamer.end();
+    EXPECT_EQ(streamed_text, "Hello world");
+    EXPECT_EQ(streamer.get_status(), StreamingStatus::STOP);
+
+    ThreadedStreamerWrapper no_streamer(std::monostate{}, tokenizer, true);
+    EXPECT_FALSE(no_streamer.has_callback());
+    EXPECT_FALSE(no_streamer.is_text_streamed());
+}
@@ -0,0 +1,50 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "sampling/threadpool.hpp"
+
+TEST(TestThreadPool, parallel_for_visits_each_index_once) {
+    ThreadPool thread_pool(4);
+    for (size_t num_indices : {0, 1, 3, 4, 5, 1000}) {
+        std::vector<std::atomic<size_t>> visits(num_indices);
+        thread_pool.parallel_for(num_indices, [&](size_t index) {
+            visits[index].fetch_add(1);
+        });
+        for (size_t index = 0; index < num_indices; ++index) {
+            EXPECT_EQ(visits[index].load(), 1);
+        }
+    }
+}
+
+TEST(TestThreadPool, parallel_for_without_workers_runs_inline) {
+    ThreadPool thread_pool(1);
+    EXPECT_EQ(thread_pool.get_num_threads(), 1);
+    std::vector<size_t> order;
+    thread_pool.parallel_for(5, [&](size_t index) {
+        order.push_back(index);
+    });
+    EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST(TestThreadPool, parallel_for_rethrows_exception_after_all_indices_are_processed) {
+    ThreadPool thread_pool(4);
+    std::atomic<size_t> num_calls{0};
+    EXPECT_THROW(thread_pool.parallel_for(100, [&](size_t index) {
+        num_calls.fetch_add(1);
+        if (index % 10 == 0) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(num_calls.load(), 100);
+
+    // the pool is still usable after a failed job
+    std::atomic<size_t> sum{0};
+    thread_pool.parallel_for(100, [&](size_t index) {
+        sum.fetch_add(index);
+    });
+    EXPECT_EQ(sum.load(), 4950);
+}
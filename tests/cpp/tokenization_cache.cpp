@@ -0,0 +1,65 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include "tokenizer/lru_cache.hpp"
+#include "tokenizer/prefix_reuse.hpp"
+
+using namespace ov::genai;
+
+TEST(LRUCacheTest, EvictsLeastRecentlyUsed) {
+    LRUCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    // "a" becomes the most recently used entry
+    EXPECT_EQ(cache.get("a"), 1);
+    cache.put("c", 3);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_EQ(cache.get("a"), 1);
+    EXPECT_EQ(cache.get("c"), 3);
+
+    // update makes the entry the most recently used one
+    cache.put("a", 4);
+    cache.put("d", 5);
+    EXPECT_EQ(cache.get("a"), 4);
+    EXPECT_FALSE(cache.get("c").has_value());
+}
+
+TEST(LRUCacheTest, ZeroCapacityKeepsNothing) {
+    LRUCache<std::string, int> cache(0);
+    cache.put("a", 1);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.get("a").has_value());
+}
+
+TEST(PrefixReuseTest, CommonPrefixLength) {
+    EXPECT_EQ(get_common_prefix_length("hello world", "hello there"), 6);
+    EXPECT_EQ(get_common_prefix_length("hello", "hello world"), 5);
+    EXPECT_EQ(get_common_prefix_length("", "hello"), 0);
+}
+
+TEST(PrefixReuseTest, CutsAfterLastSpecialTokenWithinCommonPart) {
+    const std::unordered_map<int64_t, std::string> special_token_texts = {{100, "<s>"}, {101, "</s>"}};
+    // "<s>" "user" ":" " hi" "</s>" "<s>" "bot"
+    const std::string prefix = "<s>user: hi</s><s>bot";
+    const std::vector<int64_t> prefix_ids = {100, 1, 2, 3, 101, 100, 4};
+
+    const std::string prompt = "<s>user: hi</s><s>bot: hello</s><s>user: bye</s>";
+    auto [num_tokens, num_chars] = find_reusable_prefix(prefix, prefix_ids, get_common_prefix_length(prefix, prompt), special_token_texts);
+    EXPECT_EQ(num_tokens, 6);
+    EXPECT_EQ(num_chars, std::string("<s>user: hi</s><s>").size());
+
+    // the prefix differs before the second special token
+    const std::string edited_prompt = "<s>user: hello</s>";
+    std::tie(num_tokens, num_chars) = find_reusable_prefix(prefix, prefix_ids, get_common_prefix_length(prefix, edited_prompt), special_token_texts);
+    EXPECT_EQ(num_tokens, 1);
+    EXPECT_EQ(num_chars, 3);
+}
+
+TEST(PrefixReuseTest, NothingIsReusedIfTokensDoNotMatchText) {
+    const std::unordered_map<int64_t, std::string> special_token_texts = {{100, "<s>"}};
+    const std::string prefix = "user: hi";
+    EXPECT_EQ(find_reusable_prefix(prefix, {100, 1, 2}, prefix.size(), special_token_texts), std::make_pair(size_t(0), size_t(0)));
+    EXPECT_EQ(find_reusable_prefix(prefix, {1, 2}, prefix.size(), special_token_texts), std::make_pair(size_t(0), size_t(0)));
+}
@@ -8,7 +8,8 @@ import math
 from pathlib import Path
 from shutil import rmtree
 
-from openvino_genai import ContinuousBatchingPipeline, LLMPipeline, GenerationConfig, SchedulerConfig,  draft_model, GenerationFinishReason
+from openvino_genai import ContinuousBatchingPipeline, LLMPipeline, GenerationConfig, SchedulerConfig,  draft_model, GenerationFinishReason, \
+    GenerationStatus, StreamingStatus
 
 from test_sampling import RandomSamplingTestStruct, get_current_platform_ref_texts
 
@@ -16,6 +17,7 @@ from utils.generation_config import get_greedy, get_beam_search, \
     get_multinomial_all_parameters, get_multinomial_temperature_and_num_return_sequence, \
     get_multinomial_temperature_and_top_k, get_multinomial_temperature, get_multinomial_temperature_and_top_p
 from utils.hugging_face import download_and_convert_model
+from utils.constants import get_default_llm_properties
 from utils.ov_genai_pipelines import create_ov_pipeline, create_ov_cb_pipeline, PipelineType, dict_to_scheduler_config, generate_and_compare, prepare_generation_config_by_pipe_type
 from data.models import get_chat_models_list
 from data.test_dataset import get_test_dataset
@@ -196,6 +198,72 @@ def test_continuous_batching_add_request_health_check(model_id, generation_confi
             assert output.finish_reason == GenerationFinishReason.STOP or output.finish_reason == GenerationFinishReason.LENGTH
 
 
+
+@pytest.mark.parametrize("model_id", get_chat_models_list())
+@pytest.mark.precommit
+def test_pipelined_speculative_decoding_vs_sequential(model_id):
+    _, _, models_path = download_and_convert_model(model_id)
+    generation_config = prepare_generation_config_by_pipe_type(GenerationConfig(do_sample=False, max_new_tokens=20), PipelineType.SPECULATIVE_DECODING)
+
+    generated_ids = {}
+    for is_pipelined in [False, True]:
+        ov_config = get_default_llm_properties()
+        ov_config["pipelined_speculative_decoding"] = is_pipelined
+        cb_pipe = create_ov_cb_pipeline(models_path, pipeline_type=PipelineType.SPECULATIVE_DECODING, ov_config=ov_config)
+        handles = [cb_pipe.add_request(idx, question, generation_config=generation_config) for idx, question in enumerate(questions)]
+        while cb_pipe.has_non_finished_requests():
+            cb_pipe.step()
+        generated_ids[is_pipelined] = [[output.generated_ids for output in handle.read_all()] for handle in handles]
+
+    # requests of both groups are validated by the same main model, so greedy outputs don't depend on the overlap
+    assert generated_ids[True] == generated_ids[False]
+
+
+@pytest.mark.parametrize("model_id", get_chat_models_list())
+@pytest.mark.precommit
+def test_async_step_vs_sync(model_id):
+    _, _, models_path = download_and_convert_model(model_id)
+    cb_pipes = {}
+    for is_async in [False, True]:
+        ov_config = get_default_llm_properties()
+        ov_config["async_step"] = is_async
+        cb_pipes[is_async] = create_ov_cb_pipeline(models_path, pipeline_type=PipelineType.CONTINUOUS_BATCHING, ov_config=ov_config)
+
+    # stop conditions are taken from the output of the sync pipeline, so that they are reached by the random model
+    reference = cb_pipes[False].generate(questions, [GenerationConfig(max_new_tokens=30, ignore_eos=True)] * len(questions))
+    reference_text = reference[0].m_generation_ids[0]
+    stop_string = reference_text[len(reference_text) // 2:len(reference_text) // 2 + 3]
+    stop_token_id = int(cb_pipes[False].get_tokenizer().encode(reference_text, add_special_tokens=False).input_ids.data[0][5])
+
+    generation_configs = [
+        GenerationConfig(max_new_tokens=30, ignore_eos=True),
+        GenerationConfig(max_new_tokens=30, stop_strings={stop_string}, include_stop_str_in_output=False),
+        GenerationConfig(max_new_tokens=30, stop_strings={stop_string}, include_stop_str_in_output=True),
+        GenerationConfig(max_new_tokens=30, stop_token_ids={stop_token_id}),
+    ]
+    for generation_config in generation_configs:
+        results = {}
+        for is_async, cb_pipe in cb_pipes.items():
+            outputs = cb_pipe.generate(questions, [generation_config] * len(questions))
+            results[is_async] = [(output.m_generation_ids, output.m_status) for output in outputs]
+        assert results[True] == results[False], f"async step changes outputs for {generation_config}"
+
+    # streamed text and the status of a cancelled request are the same, though the number of tokens generated before
+    # the pipeline sees the cancellation depends on timing of the streamer thread
+    streamed = {}
+    statuses = {}
+    for is_async, cb_pipe in cb_pipes.items():
+        streamed[is_async] = []
+        def streamer(subword):
+            streamed[is_async].append(subword)
+            return StreamingStatus.CANCEL if len(streamed[is_async]) == 3 else StreamingStatus.RUNNING
+        outputs = cb_pipe.generate([questions[1]], [GenerationConfig(max_new_tokens=30, ignore_eos=True)], streamer)
+        statuses[is_async] = outputs[0].m_status
+        assert not cb_pipe.has_non_finished_requests()
+    assert streamed[True] == streamed[False]
+    assert statuses[True] == statuses[False] == GenerationStatus.CANCEL
+
+
 #
 # Stress tests to check OOM case
 #
@@ -57,6 +57,7 @@ configs = [
     dict(max_new_tokens=1, assistant_confidence_threshold=0.5),
     dict(max_new_tokens=1, num_assistant_tokens=2),
     dict(max_new_tokens=1, num_assistant_tokens=2, max_ngram_size=2), # prompt lookup
+    dict(max_new_tokens=1, num_assistant_tokens=2, max_ngram_size=2, num_assistant_branches=3), # prompt lookup with candidate branches
     dict(max_new_tokens=1, apply_chat_template=True),
     dict(max_new_tokens=1, apply_chat_template=False),
 ]
@@ -105,6 +106,8 @@ invalid_configs = [
     dict(max_new_tokens=1, num_assistant_tokens=2, num_beams=2), # beam search is not compatible with assistant generation
     dict(max_new_tokens=1, assistant_confidence_threshold=1.0, num_assistant_tokens=2), # 'assistant_confidence_threshold' and 'num_assistant_tokens' are mutually exclusive
     dict(max_new_tokens=1, max_ngram_size=1), # 'max_ngram_size' is for prompt lookup, but assistant generation is turned off ('num_assistant_tokens' is 0)
+    dict(max_new_tokens=1, num_assistant_tokens=2, num_assistant_branches=2), # candidate branches are proposed only by prompt lookup
+    dict(max_new_tokens=1, num_assistant_tokens=2, max_ngram_size=2, num_assistant_branches=2, do_sample=True), # candidate branches are validated by greedy decoding only
     # TODO: add tests for invalid properties
 ]
 @pytest.mark.parametrize("generation_config_kwargs", invalid_configs)
@@ -47,6 +47,8 @@ class CacheOptTestStruct:
 
 
 SHORT_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size=32, max_cache_size=96, aggregation_mode=AggregationMode.NORM_SUM)
+SHORT_PREFILL_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size=32, max_cache_size=96, aggregation_mode=AggregationMode.NORM_SUM, evict_during_prefill=True)
+SHORT_SNAPKV_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size=32, max_cache_size=96, aggregation_mode=AggregationMode.NORM_SUM, evict_during_prefill=True, snapkv_window_size=32)
 LONGBENCH_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size=128, max_cache_size=672, aggregation_mode=AggregationMode.NORM_SUM)
 
 
@@ -61,6 +63,22 @@ LONGBENCH_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size
                        max_cache_usage_optimization_ratio=2.0,
                        avg_cache_usage_optimization_ratio=1.7),
 
+    # prompts are processed in chunks and evicted from after each chunk, the cache is never filled with the whole prompt
+    CacheOptTestStruct(test_id="prompts_longer_than_eviction_arena_evicted_during_prefill",
+                       prompt_file="long_prompts.txt", max_new_tokens=128, num_kv_blocks=500, use_cache_eviction=True,
+                       cache_eviction_config=SHORT_PREFILL_CACHE_EVICTION_CONFIG,
+                       similarity_threshold=0.8,
+                       max_cache_usage_optimization_ratio=2.3,  # peak usage no longer holds whole prompts
+                       avg_cache_usage_optimization_ratio=1.8),
+
+    # same, but the prompt blocks kept after prefill are selected by the attention of the last prompt tokens (SnapKV)
+    CacheOptTestStruct(test_id="prompts_longer_than_eviction_arena_evicted_during_prefill_with_snapkv_window",
+                       prompt_file="long_prompts.txt", max_new_tokens=128, num_kv_blocks=500, use_cache_eviction=True,
+                       cache_eviction_config=SHORT_SNAPKV_CACHE_EVICTION_CONFIG,
+                       similarity_threshold=0.8,
+                       max_cache_usage_optimization_ratio=2.3,
+                       avg_cache_usage_optimization_ratio=1.8),
+
     # prompts + generation length are shorter than the eviction arena, no eviction expected
     CacheOptTestStruct(test_id="prompts_and_gen_shorter_than_eviction_arena",
                        prompt_file="short_prompts.txt", max_new_tokens=32, num_kv_blocks=500, use_cache_eviction=True,
@@ -84,6 +102,10 @@ LONGBENCH_CACHE_EVICTION_CONFIG = CacheEvictionConfig(start_size=32, recent_size
 def test_cache_optimized_generation_is_similar_to_unoptimized(test_struct, enable_prefix_caching, apply_rotation):
     import whowhatbench
 
+    is_evicting_during_prefill = test_struct.use_cache_eviction and test_struct.cache_eviction_config.evict_during_prefill
+    if is_evicting_during_prefill and enable_prefix_caching:
+        pytest.skip("eviction during prefill is not compatible with prefix caching")
+
     seqs_per_request = 32
     scheduler_config = get_scheduler_config(test_struct.num_kv_blocks)
 
@@ -140,6 +162,15 @@ def test_cache_optimized_generation_is_similar_to_unoptimized(test_struct, enabl
     assert max_optimization_ratio >= test_struct.max_cache_usage_optimization_ratio
     assert avg_optimization_ratio >= test_struct.avg_cache_usage_optimization_ratio
 
+    if is_evicting_during_prefill:
+        # a sequence keeps the eviction arena between steps, while a step adds at most max_num_batched_tokens of prompt
+        # chunks to all of the sequences, and each sequence can have up to two partially filled blocks
+        cpu_block_size = 32
+        max_cache_size = test_struct.cache_eviction_config.get_max_cache_size()
+        max_num_cached_tokens = seqs_per_request * (max_cache_size + 2 * cpu_block_size) + scheduler_config_opt.max_num_batched_tokens
+        max_cache_usage_limit = 100 * max_num_cached_tokens / (test_struct.num_kv_blocks * cpu_block_size)
+        assert pipeline_opt_metrics.max_cache_usage <= max_cache_usage_limit
+
 
 
 def get_greedy_seq_len_300() -> GenerationConfig:
@@ -609,3 +609,77 @@ def test_set_special_runtime_template(tmp_path):
 def test_template_priorities(tmp_path, chat_templates):
     tokenizer = generate_tokenizer(tmp_path, chat_templates)
     assert tokenizer.chat_template == chat_templates.reference
+
+
+bucketed_prompts = [
+    "1+1=",
+    "What is the previous answers? " * 100,
+    "What is the previous answer?",
+    "Why is the Sun yellow?",
+    "what",
+    "若我有一亿美元，在人工智能盛行的今天，我怎样投资才能收益最大化？",
+    "מחרוזת בדיקה",
+    "Multiline\nstring!\nWow!",
+]
+
+
+@pytest.mark.precommit
+@pytest.mark.nightly
+@pytest.mark.parametrize("add_special_tokens", [True, False])
+@pytest.mark.parametrize("max_length", [None, 16, 103])
+@pytest.mark.parametrize(
+    "hf_ov_genai_models",
+    [
+        ("TinyLlama/TinyLlama-1.1B-Chat-v1.0", {"padding_side": None}),
+        ("katuni4ka/tiny-random-llava-next", {"padding_side": "right"}),
+        ("katuni4ka/tiny-random-llava-next", {"padding_side": "left"}),
+    ],
+    indirect=True,
+)
+def test_encode_ragged(hf_ov_genai_models, add_special_tokens, max_length):
+    _, genai_tokenzier = hf_ov_genai_models
+    ov_params = {"add_special_tokens": add_special_tokens}
+    if max_length is not None:
+        ov_params["max_length"] = max_length
+
+    ragged = genai_tokenzier.encode_ragged(bucketed_prompts, bucket_size=3, **ov_params)
+    # tokens of every prompt are the ones of encoding it alone, without padding, in order of prompts
+    assert len(ragged) == len(bucketed_prompts)
+    for prompt, tokens in zip(bucketed_prompts, ragged):
+        reference = genai_tokenzier.encode(prompt, **ov_params).input_ids.data[0]
+        assert tokens == reference.tolist()
+
+
+@pytest.mark.precommit
+@pytest.mark.nightly
+@pytest.mark.parametrize("max_length", [None, 16, 103])
+@pytest.mark.parametrize("pad_to_max_length", [None, True, False])
+@pytest.mark.parametrize(
+    "hf_ov_genai_models",
+    [
+        ("TinyLlama/TinyLlama-1.1B-Chat-v1.0", {"padding_side": None}),
+        ("katuni4ka/tiny-random-llava-next", {"padding_side": "right"}),
+        ("katuni4ka/tiny-random-llava-next", {"padding_side": "left"}),
+    ],
+    indirect=True,
+)
+def test_encode_bucketed(hf_ov_genai_models, max_length, pad_to_max_length):
+    _, genai_tokenzier = hf_ov_genai_models
+    bucket_size = 3
+    ov_params = {"max_length": max_length, "pad_to_max_length": pad_to_max_length}
+    ov_params = {key: value for key, value in ov_params.items() if value is not None}
+
+    buckets = genai_tokenzier.encode_bucketed(bucketed_prompts, bucket_size, **ov_params)
+    # every prompt is in exactly one bucket
+    prompt_indices = [idx for bucket in buckets for idx in bucket.prompt_indices]
+    assert sorted(prompt_indices) == list(range(len(bucketed_prompts)))
+
+    for bucket in buckets:
+        assert 0 < len(bucket.prompt_indices) <= bucket_size
+        # rows of a bucket are the prompts at its indices, padded and truncated like a plain batch encode
+        reference = genai_tokenzier.encode([bucketed_prompts[idx] for idx in bucket.prompt_indices], **ov_params)
+        assert bucket.inputs.input_ids.data.shape == reference.input_ids.data.shape
+        assert np.all(bucket.inputs.input_ids.data == reference.input_ids.data)
+        assert np.all(bucket.inputs.attention_mask.data == reference.attention_mask.data)
+        if pad_to_max_length and max_length is not None:
+            assert bucket.inputs.input_ids.data.shape[1] == max_length
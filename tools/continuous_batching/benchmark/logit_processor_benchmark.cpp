@@ -0,0 +1,193 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "sampling/logit_processor.hpp"
+
+namespace {
+
+// Implementations of the logit transformers which materialize and sort the entire vocabulary, used as a baseline
+
+void reference_softmax(float* data, size_t size, float temperature) {
+    float max_logit = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < size; i++) {
+        max_logit = std::max(max_logit, data[i]);
+    }
+    float norm_sum = 0.0;
+    for (size_t i = 0; i < size; i++) {
+        data[i] = expf((data[i] - max_logit) / temperature);
+        norm_sum += data[i];
+    }
+    for (size_t i = 0; i < size; i++) {
+        data[i] /= norm_sum;
+    }
+}
+
+std::vector<Token> initialize_vector(const float* data, size_t size) {
+    std::vector<Token> tokens;
+    tokens.reserve(size);
+    for (size_t i = 0; i < size; i++)
+        tokens.emplace_back(data[i], i);
+    return tokens;
+}
+
+bool greater(const Token& lhs, const Token& rhs) {
+    return lhs.m_log_prob > rhs.m_log_prob;
+}
+
+std::vector<Token> reference_top_k(const float* data, size_t size, size_t top_k) {
+    std::vector<Token> tokens = initialize_vector(data, size);
+    std::partial_sort(tokens.begin(), tokens.begin() + top_k, tokens.end(), greater);
+    tokens.resize(top_k);
+    return tokens;
+}
+
+std::vector<Token> reference_top_p(const float* data, size_t size, float top_p) {
+    std::vector<Token> tokens = initialize_vector(data, size);
+    for (size_t step = 16; step <= 1024; step *= 2) {
+        if (tokens.size() <= step)
+            break;
+        std::partial_sort(tokens.begin(), tokens.begin() + step, tokens.end(), greater);
+        float sum = 0.0;
+        for (size_t i = 0; i < step; i++) {
+            sum += tokens[i].m_log_prob;
+            if (sum > top_p) {
+                tokens.resize(i + 1);
+                return tokens;
+            }
+        }
+    }
+    std::sort(tokens.begin(), tokens.end(), greater);
+    float probability_sum = 0.0f;
+    size_t nucleus_size = 0;
+    for (const auto& token : tokens) {
+        probability_sum += token.m_log_prob;
+        nucleus_size += 1;
+        if (probability_sum > top_p) break;
+    }
+    tokens.resize(nucleus_size);
+    return tokens;
+}
+
+template <typename F>
+double measure_us(size_t num_iterations, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / num_iterations;
+}
+
+void report(const std::string& name, double reference_us, double optimized_us) {
+    std::cout << name << ": reference " << reference_us << " us, optimized " << optimized_us << " us, speedup "
+              << reference_us / optimized_us << "x" << std::endl;
+}
+
+bool same_indices(const std::vector<Token>& lhs, const std::vector<Token>& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        // tokens with equal probabilities may come in any order
+        if (lhs[i].m_index != rhs[i].m_index && lhs[i].m_log_prob != rhs[i].m_log_prob)
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+    cxxopts::Options options("logit_processor_benchmark", "Compares the logit transformer kernels against the sort-based implementation");
+
+    options.add_options()
+    ("vocab_size", "Vocabulary size", cxxopts::value<size_t>()->default_value("151936"))
+    ("n,num_iterations", "Number of iterations per measurement", cxxopts::value<size_t>()->default_value("200"))
+    ("temperature", "Softmax temperature", cxxopts::value<float>()->default_value("0.7"))
+    ("top_k", "Top k", cxxopts::value<size_t>()->default_value("50"))
+    ("top_p", "Top p", cxxopts::value<float>()->default_value("0.9"))
+    ("h,help", "Print usage");
+
+    cxxopts::ParseResult result;
+    try {
+        result = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cout << e.what() << "\n\n";
+        std::cout << options.help() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const size_t vocab_size = result["vocab_size"].as<size_t>();
+    const size_t num_iterations = result["num_iterations"].as<size_t>();
+    const float temperature = result["temperature"].as<float>();
+    const size_t top_k = std::min(result["top_k"].as<size_t>(), vocab_size);
+    const float top_p = result["top_p"].as<float>();
+
+    // logits of LLMs are roughly normally distributed with a few outliers
+    std::mt19937 rng(42);
+    std::normal_distribution<float> distribution(0.0f, 2.5f);
+    std::vector<float> logits(vocab_size);
+    for (auto& logit : logits) {
+        logit = distribution(rng);
+    }
+    for (size_t i = 0; i < std::min<size_t>(vocab_size, 8); ++i) {
+        logits[rng() % vocab_size] += 12.0f;
+    }
+
+    std::vector<float> buffer(vocab_size);
+    double reference_us = measure_us(num_iterations, [&] {
+        std::copy(logits.begin(), logits.end(), buffer.begin());
+        reference_softmax(buffer.data(), vocab_size, temperature);
+    });
+    double optimized_us = measure_us(num_iterations, [&] {
+        std::copy(logits.begin(), logits.end(), buffer.begin());
+        LogitKernels::softmax(buffer.data(), vocab_size, temperature);
+    });
+    report("softmax", reference_us, optimized_us);
+
+    std::vector<float> probabilities(logits);
+    reference_softmax(probabilities.data(), vocab_size, temperature);
+
+    std::vector<Token> reference_tokens, optimized_tokens;
+    reference_us = measure_us(num_iterations, [&] {
+        reference_tokens = reference_top_k(probabilities.data(), vocab_size, top_k);
+    });
+    optimized_us = measure_us(num_iterations, [&] {
+        LogitKernels::select_top_k(probabilities.data(), vocab_size, top_k, optimized_tokens);
+    });
+    report("top_k", reference_us, optimized_us);
+    if (!same_indices(reference_tokens, optimized_tokens)) {
+        std::cerr << "top_k results mismatch" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    reference_us = measure_us(num_iterations, [&] {
+        reference_tokens = reference_top_p(probabilities.data(), vocab_size, top_p);
+    });
+    optimized_us = measure_us(num_iterations, [&] {
+        LogitKernels::select_top_p(probabilities.data(), vocab_size, top_p, optimized_tokens);
+    });
+    report("top_p (nucleus of " + std::to_string(reference_tokens.size()) + " tokens)", reference_us, optimized_us);
+    if (!same_indices(reference_tokens, optimized_tokens)) {
+        std::cerr << "top_p results mismatch" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+} catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}